@@ -0,0 +1,286 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Steady-state allocation check
+ *
+ * Builds a dashboard holding every widget type (see dashboard.h), runs
+ * warm-up frames, then runs measured frames with the heap armed. The
+ * dashboard is composed, so each measured frame also recomposes it. Any
+ * malloc / calloc / realloc / free / aligned allocation made during a
+ * measured frame, from any thread, is recorded by call site and the run
+ * fails:
+ *
+ *   cels-widgets-bench-alloc [-f frames] [-w warmup] [-n widgets] [-d depth]
+ *
+ * Each offending site is printed once with its count, bytes and first
+ * frame, followed by its backtrace. Link with -rdynamic (CMake does) to
+ * get symbol names. Exit status is 0 when the measured frames allocate
+ * nothing and every widget type laid out at least once, 1 otherwise.
+ *
+ * The allocator entry points are interposed by defining them here and
+ * forwarding to glibc's __libc_* functions, so this tool is glibc-only.
+ */
+
+#include "harness.h"
+#include "dashboard.h"
+
+#include <errno.h>
+#include <execinfo.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef __GLIBC__
+#error "bench_alloc interposes glibc's allocator; build it on glibc targets only"
+#endif
+
+#define ALLOC_SITES 64
+#define ALLOC_DEPTH_MAX 32
+
+typedef enum AllocKind {
+    ALLOC_MALLOC, ALLOC_CALLOC, ALLOC_REALLOC, ALLOC_ALIGNED, ALLOC_FREE,
+    ALLOC_KIND_COUNT
+} AllocKind;
+
+static const char* const s_kind_names[ALLOC_KIND_COUNT] = {
+    "malloc", "calloc", "realloc", "aligned", "free"
+};
+
+typedef struct AllocSite {
+    uint64_t hash;
+    AllocKind kind;
+    int depth;
+    void* frames[ALLOC_DEPTH_MAX];
+    long long calls;
+    long long bytes;
+    int first_frame;
+} AllocSite;
+
+static AllocSite s_sites[ALLOC_SITES];
+static int s_site_count = 0;
+static long long s_dropped = 0;             /* Sites past ALLOC_SITES */
+static long long s_kind_calls[ALLOC_KIND_COUNT];
+
+static volatile int s_armed = 0;
+static volatile int s_frame = -1;           /* Measured frame in progress */
+static int s_depth = 16;
+static char s_lock = 0;
+static __thread int t_inside = 0;           /* Reentrancy guard */
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* ptr);
+
+/* ============================================================================
+ * Recording
+ * ============================================================================ */
+
+static uint64_t frames_hash(void* const* frames, int depth, AllocKind kind) {
+    uint64_t h = 1469598103934665603ull ^ (uint64_t)kind;
+    for (int i = 0; i < depth; i++) {
+        h ^= (uint64_t)(uintptr_t)frames[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/* Called from the interposed entry points. backtrace() was warmed up
+ * before arming, so it does not allocate here; the guard catches the
+ * case anyway. Frames 0-1 are this function and the entry point. */
+static void alloc_note(AllocKind kind, size_t bytes) {
+    if (!s_armed || t_inside) return;
+    t_inside = 1;
+
+    void* frames[ALLOC_DEPTH_MAX + 2];
+    int depth = backtrace(frames, s_depth + 2) - 2;
+    if (depth < 0) depth = 0;
+    uint64_t hash = frames_hash(frames + 2, depth, kind);
+
+    while (__atomic_test_and_set(&s_lock, __ATOMIC_ACQUIRE)) { }
+    s_kind_calls[kind]++;
+    AllocSite* site = NULL;
+    for (int i = 0; i < s_site_count; i++) {
+        if (s_sites[i].hash == hash) { site = &s_sites[i]; break; }
+    }
+    if (!site && s_site_count < ALLOC_SITES) {
+        site = &s_sites[s_site_count++];
+        site->hash = hash;
+        site->kind = kind;
+        site->depth = depth;
+        memcpy(site->frames, frames + 2, (size_t)depth * sizeof(void*));
+        site->first_frame = s_frame;
+    }
+    if (site) {
+        site->calls++;
+        site->bytes += (long long)bytes;
+    } else {
+        s_dropped++;
+    }
+    __atomic_clear(&s_lock, __ATOMIC_RELEASE);
+
+    t_inside = 0;
+}
+
+/* ============================================================================
+ * Interposed Allocator
+ * ============================================================================ */
+
+void* malloc(size_t size) {
+    alloc_note(ALLOC_MALLOC, size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) {
+    alloc_note(ALLOC_CALLOC, n * size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    alloc_note(ALLOC_REALLOC, size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if (ptr) alloc_note(ALLOC_FREE, 0);
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    alloc_note(ALLOC_ALIGNED, size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    alloc_note(ALLOC_ALIGNED, size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    alloc_note(ALLOC_ALIGNED, size);
+    void* p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+/* ============================================================================
+ * Report
+ * ============================================================================ */
+
+static void report_sites(void) {
+    for (int i = 0; i < s_site_count; i++) {
+        const AllocSite* site = &s_sites[i];
+        fprintf(stderr, "\nsite %d: %s x%lld, %lld bytes, first in measured frame %d\n",
+                i + 1, s_kind_names[site->kind], site->calls, site->bytes,
+                site->first_frame);
+        fflush(stderr);
+        /* Writes straight to the fd; does not allocate */
+        backtrace_symbols_fd((void* const*)site->frames, site->depth, STDERR_FILENO);
+    }
+    if (s_dropped > 0) {
+        fprintf(stderr, "\n%lld calls from sites past the first %d not shown\n",
+                s_dropped, ALLOC_SITES);
+    }
+}
+
+int main(int argc, char** argv) {
+    int frames = 120;
+    int warmup = 30;
+    int widgets = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            widgets = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            s_depth = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-f frames] [-w warmup] [-n widgets] [-d depth]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1) frames = 1;
+    if (s_depth < 1) s_depth = 1;
+    if (s_depth > ALLOC_DEPTH_MAX) s_depth = ALLOC_DEPTH_MAX;
+
+    /* First backtrace() loads the unwinder, which allocates */
+    void* warm[4];
+    backtrace(warm, 4);
+
+    ecs_world_t* world = bench_world_open();
+    if (!world) {
+        fprintf(stderr, "bench-alloc: no cels world\n");
+        return 1;
+    }
+    bench_dashboard_name_stats();
+    int spawned = bench_dashboard_build(world, widgets);
+
+    CELS_Input input;
+    BenchFrame f;
+    for (int i = 0; i < warmup; i++) {
+        bench_input_script(i, &input);
+        bench_frame(world, &input, 1.0f / 60.0f, &f);
+    }
+
+    bench_stats_reset();
+    int dirty_frames = 0;
+    for (int i = 0; i < frames; i++) {
+        long long before = 0;
+        for (int k = 0; k < ALLOC_KIND_COUNT; k++) before += s_kind_calls[k];
+
+        bench_input_script(warmup + i, &input);
+        s_frame = i;
+        __atomic_store_n(&s_armed, 1, __ATOMIC_SEQ_CST);
+        bench_frame(world, &input, 1.0f / 60.0f, &f);
+        __atomic_store_n(&s_armed, 0, __ATOMIC_SEQ_CST);
+
+        long long after = 0;
+        for (int k = 0; k < ALLOC_KIND_COUNT; k++) after += s_kind_calls[k];
+        if (after != before) dirty_frames++;
+    }
+
+    /* The check only proves something for types that laid out while armed */
+    int missing = 0;
+    for (int t = 0; t < BW_COUNT; t++) {
+        if (bench_layout_stats[t].calls > 0) continue;
+        fprintf(stderr, "bench-alloc: %s never laid out in measured frames\n",
+                bench_widget_names[t]);
+        missing++;
+    }
+
+    long long total = 0;
+    for (int k = 0; k < ALLOC_KIND_COUNT; k++) total += s_kind_calls[k];
+
+    printf("widgets %d, warm-up %d, measured %d: %lld heap calls in %d frames",
+           spawned, warmup, frames, total, dirty_frames);
+    for (int k = 0; k < ALLOC_KIND_COUNT; k++) {
+        if (s_kind_calls[k] > 0) printf(", %s %lld", s_kind_names[k], s_kind_calls[k]);
+    }
+    printf(", %d/%d widget types covered\n", BW_COUNT - missing, BW_COUNT);
+    fflush(stdout);
+
+    if (total > 0) report_sites();
+
+    bench_dashboard_free();
+    return (total > 0 || missing > 0) ? 1 : 0;
+}
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Focus and navigation scaling benchmark
+ *
+ * Builds worlds of S navigation scopes x M children, K visible windows
+ * plus K hidden modals, and T text inputs in one scope of their own, then
+ * replays a key recording through widgets_focus_step() alone (no layout
+ * pass) and reports the per-frame cost. Each of the four dimensions is swept in turn with the
+ * others held at their base value, giving one scaling curve per
+ * dimension:
+ *
+ *   cels-widgets-bench-focus [-o out.json] [-f frames] [-w warmup]
+ *                            [-r keys.txt] [-s S] [-m M] [-k K] [-t T]
+ *                            [-x max_exponent]
+ *
+ * -s/-m/-k/-t set the base values. Each curve also gets a log-log slope
+ * ("exponent": 1.0 is linear in that dimension); -x fails the run (exit 1)
+ * when any curve's exponent exceeds the limit. In CELS_WIDGETS_PROFILE
+ * builds every point lists the per-pass split of the focus step.
+ *
+ * A recording is whitespace-separated tokens, one per frame; '#' starts a
+ * comment. Named keys: tab shift-tab up down left right enter esc home
+ * end pgup pgdn bksp del idle. A single character is typed as a raw key.
+ * Without -r a built-in recording of navigation and typing is used.
+ */
+
+#include "harness.h"
+#include "dashboard.h"
+
+#include <cels-widgets/profile.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_RECORDING 4096
+#define CURVE_POINTS 4
+
+typedef struct FocusWorld {
+    int scopes;
+    int children;
+    int overlays;               /* Windows and modals, K of each */
+    int inputs;
+} FocusWorld;
+
+typedef enum FocusAxis {
+    AXIS_SCOPES, AXIS_CHILDREN, AXIS_OVERLAYS, AXIS_INPUTS, AXIS_COUNT
+} FocusAxis;
+
+static const char* const s_axis_names[AXIS_COUNT] = {
+    "scopes", "children", "overlays", "inputs"
+};
+
+/* Multipliers applied to the base value along each curve */
+static const int s_curve_scale[CURVE_POINTS] = { 1, 4, 16, 64 };
+
+static CELS_Input s_recording[MAX_RECORDING];
+static int s_recording_len = 0;
+
+static const char s_builtin_recording[] =
+    "# Walk the scopes and their children\n"
+    "tab down down right enter idle pgdn up left idle\n"
+    "tab shift-tab home end pgup idle\n"
+    "# Focus a text input and type into it\n"
+    "tab enter h e l l o idle bksp bksp del esc idle\n";
+
+/* ============================================================================
+ * Recording
+ * ============================================================================ */
+
+static bool key_apply(const char* tok, CELS_Input* in) {
+    memset(in, 0, sizeof(*in));
+    if (strlen(tok) == 1) {
+        in->raw_key = (unsigned char)tok[0];
+        in->has_raw_key = true;
+    } else if (strcmp(tok, "tab") == 0) {
+        in->key_tab = true;
+    } else if (strcmp(tok, "shift-tab") == 0) {
+        in->key_shift_tab = true;
+    } else if (strcmp(tok, "up") == 0) {
+        in->axis_left[1] = -1.0f;
+    } else if (strcmp(tok, "down") == 0) {
+        in->axis_left[1] = 1.0f;
+    } else if (strcmp(tok, "left") == 0) {
+        in->axis_left[0] = -1.0f;
+    } else if (strcmp(tok, "right") == 0) {
+        in->axis_left[0] = 1.0f;
+    } else if (strcmp(tok, "enter") == 0) {
+        in->button_accept = true;
+    } else if (strcmp(tok, "esc") == 0) {
+        in->button_cancel = true;
+    } else if (strcmp(tok, "home") == 0) {
+        in->key_home = true;
+    } else if (strcmp(tok, "end") == 0) {
+        in->key_end = true;
+    } else if (strcmp(tok, "pgup") == 0) {
+        in->key_page_up = true;
+    } else if (strcmp(tok, "pgdn") == 0) {
+        in->key_page_down = true;
+    } else if (strcmp(tok, "bksp") == 0) {
+        in->key_backspace = true;
+    } else if (strcmp(tok, "del") == 0) {
+        in->key_delete = true;
+    } else if (strcmp(tok, "idle") != 0) {
+        return false;
+    }
+    return true;
+}
+
+/* Parse text in place (tokens are NUL-terminated where they end) */
+static bool recording_parse(char* text) {
+    s_recording_len = 0;
+    char* p = text;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+        if (*p == '#') {
+            while (*p && *p != '\n') p++;
+            continue;
+        }
+        if (!*p) break;
+        char* tok = p;
+        while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') p++;
+        if (*p) *p++ = '\0';
+
+        if (s_recording_len >= MAX_RECORDING) break;
+        if (!key_apply(tok, &s_recording[s_recording_len])) {
+            fprintf(stderr, "bench-focus: unknown key '%s'\n", tok);
+            return false;
+        }
+        s_recording_len++;
+    }
+    return s_recording_len > 0;
+}
+
+static bool recording_load(const char* path) {
+    if (!path) {
+        char buf[sizeof(s_builtin_recording)];
+        memcpy(buf, s_builtin_recording, sizeof(buf));
+        return recording_parse(buf);
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = (char*)malloc((size_t)(size > 0 ? size : 0) + 1);
+    size_t read = text ? fread(text, 1, (size_t)(size > 0 ? size : 0), f) : 0;
+    fclose(f);
+    if (!text) return false;
+    text[read] = '\0';
+    bool ok = recording_parse(text);
+    free(text);
+    return ok;
+}
+
+/* ============================================================================
+ * World
+ * ============================================================================ */
+
+/* Returns the number of entities spawned */
+static int focus_world_build(ecs_world_t* world, const FocusWorld* w) {
+    int n = 0;
+
+    for (int s = 0; s < w->scopes; s++) {
+        ecs_entity_t scope = bench_widget_spawn(world, 0, BW_PANEL, s);
+        n++;
+        for (int c = 0; c < w->children; c++) {
+            /* Every fourth child takes left/right as a value change */
+            bench_widget_spawn(world, scope, c % 4 == 3 ? BW_SLIDER : BW_BUTTON, s + c);
+            n++;
+        }
+    }
+
+    for (int k = 0; k < w->overlays; k++) {
+        ecs_entity_t win = bench_widget_spawn(world, 0, BW_WINDOW, k);
+        bench_set(world, win, W_Window, .title = "Inspector", .visible = true,
+                  .width = 40, .height = 10, .z_order = k % 16);
+        bench_set(world, win, W_OverlayState, .visible = true, .z_index = 150, .modal = false);
+        for (int c = 0; c < 2; c++) {
+            bench_widget_spawn(world, win, BW_BUTTON, k + c);
+            n++;
+        }
+        /* Hidden: a visible modal would swallow all input */
+        bench_widget_spawn(world, 0, BW_MODAL, k);
+        n += 2;
+    }
+
+    /* Own scope, so T doesn't also grow a scope's child count (M) */
+    ecs_entity_t input_scope = bench_widget_spawn(world, 0, BW_PANEL, w->scopes);
+    n++;
+    for (int t = 0; t < w->inputs; t++) {
+        bench_widget_spawn(world, input_scope, BW_TEXT_INPUT, t);
+        n++;
+    }
+    return n;
+}
+
+/* ============================================================================
+ * Measurement
+ * ============================================================================ */
+
+typedef struct FocusPoint {
+    FocusWorld world;
+    int entities;
+    double mean_us;
+    double p95_us;
+    double max_us;
+} FocusPoint;
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void run_point(ecs_world_t* world, BenchJson* j, const FocusWorld* w,
+                      int frames, int warmup, double* samples, FocusPoint* out) {
+    bench_world_reset(world);
+    out->world = *w;
+    out->entities = focus_world_build(world, w);
+
+    /* Children and inputs don't change, so neither does the focusable count */
+    int focusable = (int)ecs_count_id(world, W_Focusable_id);
+    for (int i = 0; i < warmup; i++) {
+        widgets_focus_step(world, &s_recording[i % s_recording_len], focusable);
+    }
+
+    Widget_profile_reset();
+    double sum = 0.0, max = 0.0;
+    for (int i = 0; i < frames; i++) {
+        const CELS_Input* in = &s_recording[(warmup + i) % s_recording_len];
+        uint64_t t0 = bench_now_ns();
+        widgets_focus_step(world, in, focusable);
+        double us = (double)(bench_now_ns() - t0) / 1000.0;
+        samples[i] = us;
+        sum += us;
+        if (us > max) max = us;
+    }
+    qsort(samples, (size_t)frames, sizeof(double), cmp_double);
+    out->mean_us = sum / frames;
+    out->p95_us = samples[(frames * 95) / 100 < frames ? (frames * 95) / 100 : frames - 1];
+    out->max_us = max;
+
+    bench_json_object(j, NULL);
+    bench_json_int(j, "scopes", w->scopes);
+    bench_json_int(j, "children", w->children);
+    bench_json_int(j, "overlays", w->overlays);
+    bench_json_int(j, "inputs", w->inputs);
+    bench_json_int(j, "entities", out->entities);
+    bench_json_int(j, "focusable", focusable);
+    bench_json_num(j, "mean_us", out->mean_us);
+    bench_json_num(j, "p95_us", out->p95_us);
+    bench_json_num(j, "max_us", out->max_us);
+
+    int site_count = 0;
+    const W_ProfileStat* sites = Widget_profile_totals(&site_count);
+    if (Widget_profile_enabled() && site_count > 0) {
+        bench_json_array(j, "passes");
+        for (int s = 0; s < site_count; s++) {
+            if (sites[s].kind != W_PROFILE_KIND_FOCUS || sites[s].calls == 0) continue;
+            bench_json_object(j, NULL);
+            bench_json_str(j, "pass", sites[s].name);
+            bench_json_num(j, "us_per_frame", (double)sites[s].ns / 1000.0 / frames);
+            bench_json_close(j, '}');
+        }
+        bench_json_close(j, ']');
+    }
+    bench_json_close(j, '}');
+}
+
+/* Least-squares slope of log(mean) over log(axis value) */
+static double curve_exponent(const FocusPoint* pts, int count, FocusAxis axis) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        const FocusWorld* w = &pts[i].world;
+        int v = axis == AXIS_SCOPES ? w->scopes : axis == AXIS_CHILDREN ? w->children
+              : axis == AXIS_OVERLAYS ? w->overlays : w->inputs;
+        if (v <= 0 || pts[i].mean_us <= 0.0) continue;
+        double x = log((double)v), y = log(pts[i].mean_us);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        n++;
+    }
+    double d = n * sxx - sx * sx;
+    return (n >= 2 && d > 0.0) ? (n * sxy - sx * sy) / d : 0.0;
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    const char* rec_path = NULL;
+    int frames = 240;
+    int warmup = 30;
+    double max_exponent = 0.0;
+    FocusWorld base = { .scopes = 16, .children = 8, .overlays = 4, .inputs = 8 };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rec_path = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            base.scopes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            base.children = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            base.overlays = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            base.inputs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            max_exponent = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-o out.json] [-f frames] [-w warmup] [-r keys.txt] "
+                            "[-s S] [-m M] [-k K] [-t T] [-x max_exponent]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1) frames = 1;
+    if (warmup < 0) warmup = 0;
+    /* Every curve scales its dimension from the base; 0 would stay 0 */
+    if (base.scopes < 1) base.scopes = 1;
+    if (base.children < 1) base.children = 1;
+    if (base.overlays < 1) base.overlays = 1;
+    if (base.inputs < 1) base.inputs = 1;
+
+    if (!recording_load(rec_path)) {
+        fprintf(stderr, "bench-focus: empty or unreadable recording\n");
+        return 1;
+    }
+
+    ecs_world_t* world = bench_world_open();
+    if (!world) {
+        fprintf(stderr, "bench-focus: no cels world\n");
+        return 1;
+    }
+
+    FILE* out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        perror(out_path);
+        return 1;
+    }
+
+    double* samples = (double*)malloc((size_t)frames * sizeof(double));
+    if (!samples) return 1;
+
+    BenchJson j;
+    bench_json_begin(&j, out);
+    bench_json_str(&j, "bench", "focus");
+    bench_json_int(&j, "frames", frames);
+    bench_json_int(&j, "recording_frames", s_recording_len);
+    bench_json_array(&j, "curves");
+
+    bool failed = false;
+    for (int a = 0; a < AXIS_COUNT; a++) {
+        FocusPoint pts[CURVE_POINTS];
+        bench_json_object(&j, NULL);
+        bench_json_str(&j, "axis", s_axis_names[a]);
+        bench_json_array(&j, "points");
+        for (int p = 0; p < CURVE_POINTS; p++) {
+            FocusWorld w = base;
+            int* v = a == AXIS_SCOPES ? &w.scopes : a == AXIS_CHILDREN ? &w.children
+                   : a == AXIS_OVERLAYS ? &w.overlays : &w.inputs;
+            *v *= s_curve_scale[p];
+            run_point(world, &j, &w, frames, warmup, samples, &pts[p]);
+        }
+        bench_json_close(&j, ']');
+
+        double exponent = curve_exponent(pts, CURVE_POINTS, (FocusAxis)a);
+        bench_json_num(&j, "exponent", exponent);
+        bench_json_close(&j, '}');
+
+        fprintf(stderr, "%-9s %8.2f us -> %8.2f us  exponent %.2f\n", s_axis_names[a],
+                pts[0].mean_us, pts[CURVE_POINTS - 1].mean_us, exponent);
+        if (max_exponent > 0.0 && exponent > max_exponent) {
+            fprintf(stderr, "bench-focus: %s exponent %.2f exceeds %.2f\n",
+                    s_axis_names[a], exponent, max_exponent);
+            failed = true;
+        }
+    }
+    bench_json_close(&j, ']');
+    bench_json_end(&j);
+
+    if (out != stdout) fclose(out);
+    free(samples);
+    bench_dashboard_free();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - End-to-end headless frame benchmark
+ *
+ * Builds synthetic dashboards (see dashboard.h) at 1k, 10k and 100k
+ * widgets, runs scripted frames and reports per-phase times, element
+ * counts and memory as JSON:
+ *
+ *   cels-widgets-bench [-o out.json] [-f frames] [-w warmup] [-n widgets]...
+ *                      [-t trace.json]
+ *
+ * -n may repeat; it replaces the default sizes. Times are microseconds.
+ * component_bytes and heap_bytes are Widget_memory_report()'s totals for
+ * the dashboard; heap_bytes includes the shared UI-state slab and keyed
+ * stash.
+ * -t writes a Chrome trace of the first size's measured frames; it needs a
+ * CELS_WIDGETS_PROFILE build to contain per-widget events.
+ */
+
+#include "harness.h"
+#include "dashboard.h"
+
+#include <cels-widgets/profile.h>
+#include <cels-widgets/memory.h>
+
+#include <clay.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SIZES 8
+
+typedef struct PhaseStats {
+    double sum_us;
+    double max_us;
+} PhaseStats;
+
+static void phase_add(PhaseStats* p, uint64_t ns) {
+    double us = (double)ns / 1000.0;
+    p->sum_us += us;
+    if (us > p->max_us) p->max_us = us;
+}
+
+static void phase_write(BenchJson* j, const char* key, const PhaseStats* p, int frames) {
+    bench_json_object(j, key);
+    bench_json_num(j, "mean", frames > 0 ? p->sum_us / frames : 0.0);
+    bench_json_num(j, "max", p->max_us);
+    bench_json_close(j, '}');
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void run_size(ecs_world_t* world, BenchJson* j, int size, int frames, int warmup,
+                     const char* trace_path) {
+    bench_world_reset(world);
+
+    uint64_t t0 = bench_now_ns();
+    int widgets = bench_dashboard_build(world, size);
+    double build_ms = (double)(bench_now_ns() - t0) / 1e6;
+
+    CELS_Input input;
+    BenchFrame f;
+    for (int i = 0; i < warmup; i++) {
+        bench_input_script(i, &input);
+        bench_frame(world, &input, 1.0f / 60.0f, &f);
+    }
+
+    bench_stats_reset();
+    if (trace_path) Widget_profile_trace_begin(trace_path);
+    PhaseStats focus = {0}, behavioral = {0}, layout = {0}, clay = {0}, total = {0};
+    double* totals = (double*)malloc((size_t)frames * sizeof(double));
+    long long layout_calls = 0, elements = 0, text_elements = 0;
+
+    for (int i = 0; i < frames; i++) {
+        bench_input_script(warmup + i, &input);
+        bench_frame(world, &input, 1.0f / 60.0f, &f);
+        phase_add(&focus, f.focus_ns);
+        phase_add(&behavioral, f.behavioral_ns);
+        phase_add(&layout, f.layout_ns);
+        phase_add(&clay, f.clay_ns);
+        phase_add(&total, f.total_ns);
+        if (totals) totals[i] = (double)f.total_ns / 1000.0;
+        layout_calls = f.layout_calls;
+        elements = f.clay_elements;
+        text_elements = f.clay_text_elements;
+    }
+    if (trace_path) Widget_profile_trace_end();
+
+    double p95 = 0.0;
+    if (totals && frames > 0) {
+        qsort(totals, (size_t)frames, sizeof(double), cmp_double);
+        p95 = totals[(frames * 95) / 100 < frames ? (frames * 95) / 100 : frames - 1];
+    }
+    free(totals);
+
+    bench_json_object(j, NULL);
+    bench_json_int(j, "widgets_requested", size);
+    bench_json_int(j, "widgets", widgets);
+    bench_json_num(j, "build_ms", build_ms);
+    bench_json_int(j, "frames", frames);
+    phase_write(j, "focus_us", &focus, frames);
+    phase_write(j, "behavioral_us", &behavioral, frames);
+    phase_write(j, "layout_us", &layout, frames);
+    phase_write(j, "clay_us", &clay, frames);
+    phase_write(j, "frame_us", &total, frames);
+    bench_json_num(j, "frame_p95_us", p95);
+    bench_json_int(j, "layout_calls", layout_calls);
+    bench_json_int(j, "clay_elements", elements);
+    bench_json_int(j, "clay_text_elements", text_elements);
+    bench_json_int(j, "peak_rss_kb", bench_peak_rss_kb());
+
+    W_MemoryReport mem;
+    Widget_memory_report(world, &mem);
+    bench_json_int(j, "component_bytes", (long long)mem.component_bytes);
+    bench_json_int(j, "heap_bytes",
+                   (long long)(mem.heap_bytes + mem.ui_state_bytes + mem.keyed_bytes));
+    if (mem.frame_counted) bench_json_int(j, "border_decors", (long long)mem.border_decors);
+    if (mem.clay_counted) bench_json_int(j, "clay_text_bytes", (long long)mem.text_bytes);
+
+    bench_json_array(j, "layout_by_type");
+    for (int t = 0; t < BW_COUNT; t++) {
+        const BenchLayoutStat* st = &bench_layout_stats[t];
+        if (st->calls == 0) continue;
+        bench_json_object(j, NULL);
+        bench_json_str(j, "type", st->name);
+        bench_json_num(j, "us_per_frame", (double)st->ns / 1000.0 / frames);
+        bench_json_int(j, "calls_per_frame", st->calls / frames);
+        if (elements >= 0) bench_json_int(j, "elements_per_frame", st->clay_elements / frames);
+        bench_json_close(j, '}');
+    }
+    bench_json_close(j, ']');
+    bench_json_close(j, '}');
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    const char* trace_path = NULL;
+    int frames = 120;
+    int warmup = 30;
+    int sizes[MAX_SIZES] = { 1000, 10000, 100000 };
+    int size_count = 3;
+    bool custom_sizes = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            if (!custom_sizes) size_count = 0;
+            custom_sizes = true;
+            if (size_count < MAX_SIZES) sizes[size_count++] = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-o out.json] [-f frames] [-w warmup] [-n widgets]... "
+                            "[-t trace.json]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1) frames = 1;
+
+    ecs_world_t* world = bench_world_open();
+    if (!world) {
+        fprintf(stderr, "bench: no cels world\n");
+        return 1;
+    }
+    bench_dashboard_name_stats();
+
+    FILE* out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        perror(out_path);
+        return 1;
+    }
+
+    BenchJson j;
+    bench_json_begin(&j, out);
+    bench_json_str(&j, "bench", "frame");
+    bench_json_int(&j, "clay_arena_bytes", (long long)Clay_MinMemorySize());
+    bench_json_array(&j, "sizes");
+    for (int i = 0; i < size_count; i++) {
+        /* One trace per run: the first size only */
+        run_size(world, &j, sizes[i], frames, warmup, i == 0 ? trace_path : NULL);
+    }
+    bench_json_close(&j, ']');
+    bench_json_end(&j);
+
+    if (out != stdout) fclose(out);
+    bench_dashboard_free();
+    return 0;
+}
@@ -0,0 +1,420 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Microbenchmarks with baseline comparison
+ *
+ * One benchmark per w_*_layout (a world holding only that widget type,
+ * props from dashboard.c, exclusive layout time per call) plus the style
+ * helpers and the text-input editing paths. Every benchmark runs -r times
+ * and reports the fastest repetition in ns/op:
+ *
+ *   cels-widgets-bench-micro [-o out.json] [-b baseline.json] [-t pct]
+ *                            [-r reps] [-s scale] [-k filter]
+ *
+ * With -b the results are compared by name against the baseline and a
+ * table is printed to stderr; the exit status is 1 when any benchmark is
+ * more than -t percent (default 10) slower, or when the baseline is
+ * missing or holds no results -- an empty baseline would otherwise pass
+ * every run. Regenerate the checked-in baseline with
+ * -o bench/baseline.json on the reference machine.
+ */
+
+#include "harness.h"
+#include "dashboard.h"
+
+#include <cels-widgets/style.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MICRO_MAX_RESULTS 128
+#define MICRO_NAME_MAX 64
+
+typedef struct MicroResult {
+    char name[MICRO_NAME_MAX];
+    double ns_per_op;
+    long long ops;
+} MicroResult;
+
+static MicroResult s_results[MICRO_MAX_RESULTS];
+static int s_result_count = 0;
+
+static int s_reps = 5;
+static int s_scale = 1;
+static const char* s_filter = NULL;
+
+/* Keeps helper results observable so loops are not folded away */
+static volatile float s_sink_f;
+static volatile uintptr_t s_sink_p;
+
+static bool micro_wanted(const char* name) {
+    return !s_filter || strstr(name, s_filter) != NULL;
+}
+
+static void micro_record(const char* name, double ns_per_op, long long ops) {
+    if (s_result_count >= MICRO_MAX_RESULTS) return;
+    MicroResult* r = &s_results[s_result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->ns_per_op = ns_per_op;
+    r->ops = ops;
+}
+
+/* ============================================================================
+ * Layouts
+ *
+ * Each type gets a fresh world with `instances` top-level widgets. The
+ * fastest repetition's mean exclusive time per layout call is reported.
+ * ============================================================================ */
+
+static void bench_layouts(ecs_world_t* world, int instances, int frames) {
+    CELS_Input idle;
+    memset(&idle, 0, sizeof(idle));
+    BenchFrame f;
+    char name[MICRO_NAME_MAX];
+
+    for (int t = 0; t < BW_COUNT; t++) {
+        snprintf(name, sizeof(name), "layout/%s", bench_widget_names[t]);
+        if (!micro_wanted(name)) continue;
+
+        bench_world_reset(world);
+        for (int i = 0; i < instances; i++) {
+            bench_widget_spawn(world, 0, (BenchWidget)t, i);
+        }
+        for (int i = 0; i < 3; i++) bench_frame(world, &idle, 1.0f / 60.0f, &f);
+
+        double best = -1.0;
+        long long calls = 0;
+        for (int r = 0; r < s_reps; r++) {
+            bench_stats_reset();
+            for (int i = 0; i < frames; i++) bench_frame(world, &idle, 1.0f / 60.0f, &f);
+            const BenchLayoutStat* st = &bench_layout_stats[t];
+            if (st->calls == 0) continue;
+            double ns = (double)st->ns / (double)st->calls;
+            if (best < 0.0 || ns < best) best = ns;
+            calls = st->calls;
+        }
+        if (best >= 0.0) micro_record(name, best, calls);
+    }
+}
+
+/* ============================================================================
+ * Style Helpers
+ *
+ * Inputs vary with the loop index so the calls cannot be hoisted.
+ * ============================================================================ */
+
+#define MICRO_LOOP(bench_name, iters, ...)                                    \
+    do {                                                                      \
+        if (!micro_wanted(bench_name)) break;                                 \
+        double _best = -1.0;                                                  \
+        for (int _r = 0; _r < s_reps; _r++) {                                 \
+            uint64_t _t0 = bench_now_ns();                                    \
+            for (long long i = 0; i < (iters); i++) { __VA_ARGS__; }          \
+            double _ns = (double)(bench_now_ns() - _t0) / (double)(iters);    \
+            if (_best < 0.0 || _ns < _best) _best = _ns;                      \
+        }                                                                     \
+        micro_record(bench_name, _best, (iters));                             \
+    } while (0)
+
+static void bench_helpers(void) {
+    const long long n = 1000000LL * s_scale;
+    const Widget_Theme* theme = Widget_get_theme();
+    const CEL_Color lo = CEL_RGB(40, 160, 80);
+    const CEL_Color mid = CEL_RGB(220, 200, 60);
+    const CEL_Color hi = CEL_RGB(220, 60, 60);
+
+    MICRO_LOOP("style/w_resolve_visual", n, {
+        CEL_Color bg = { 0 };
+        bg.a = (float)(i & 1) * 255.0f;
+        W_ResolvedVisual v = w_resolve_visual(
+            theme, bg, (CEL_Color){ 0 }, (CEL_TextAttr){ .bold = (i & 2) != 0 },
+            (CEL_Color){ 0 }, CEL_BORDER_DEFAULT, CEL_BORDER_ON_FOCUS,
+            (i & 4) != 0, (i & 8) != 0, (i & 16) != 0);
+        s_sink_f = v.bg.r + v.fg.g;
+    });
+
+    MICRO_LOOP("style/w_pack_text_attr", n, {
+        CEL_TextAttr a = { .bold = (i & 1) != 0, .dim = (i & 2) != 0,
+                           .underline = (i & 4) != 0, .reverse = (i & 8) != 0,
+                           .italic = (i & 16) != 0 };
+        s_sink_p = (uintptr_t)w_pack_text_attr(a);
+    });
+
+    MICRO_LOOP("style/w_value_gradient", n, {
+        CEL_Color c = w_value_gradient((float)(i & 1023) / 1023.0f, lo, mid, hi);
+        s_sink_f = c.r + c.g + c.b;
+    });
+
+    MICRO_LOOP("style/Widget_resolve_width", n, {
+        CEL_Sizing s = (i & 1) ? CEL_FIXED((float)(i & 63)) : (CEL_Sizing){ 0 };
+        Clay_SizingAxis a = Widget_resolve_width(s, CLAY_SIZING_GROW(0));
+        s_sink_f = a.size.minMax.min;
+    });
+
+    MICRO_LOOP("style/Widget_resolve_sizing", n, {
+        CEL_Sizing s = (i & 1) ? CEL_FIXED((float)(i & 63)) : (CEL_Sizing){ 0 };
+        Clay_SizingAxis a = Widget_resolve_sizing(s, CLAY_SIZING_FIT(0));
+        s_sink_f = a.size.minMax.max;
+    });
+}
+
+/* ============================================================================
+ * Text Input Editing
+ *
+ * One focused+selected W_TextInput; text_input_system_run() is called
+ * directly with synthetic keys. Key sequences alternate so the cursor and
+ * length stay put; every call counts as one op.
+ * ============================================================================ */
+
+static ecs_entity_t text_input_spawn(ecs_world_t* world, int prefill) {
+    ecs_entity_t e = bench_widget_spawn(world, 0, BW_TEXT_INPUT, 0);
+    bench_set(world, e, W_TextInput, .placeholder = "Search...", .max_length = 255);
+
+    W_TextInputBuffer buf;
+    memset(&buf, 0, sizeof(buf));
+    for (int i = 0; i < prefill && i < 200; i++) buf.buffer[i] = (char)('a' + i % 26);
+    buf.length = buf.byte_length = prefill < 200 ? prefill : 200;
+    buf.cursor_pos = buf.length / 2;
+    buf.sel_start = buf.sel_end = -1;
+    buf.initialized = true;
+    ecs_set_id(world, e, W_TextInputBuffer_id, sizeof(W_TextInputBuffer), &buf);
+
+    bench_set(world, e, W_Selectable, .selected = true);
+    bench_set(world, e, W_InteractState, .focused = true, .selected = true);
+    return e;
+}
+
+static void text_input_cursor(ecs_world_t* world, ecs_entity_t e, bool end) {
+    W_TextInputBuffer* buf = (W_TextInputBuffer*)ecs_get_mut_id(world, e, W_TextInputBuffer_id);
+    if (buf) buf->cursor_pos = end ? buf->length : buf->length / 2;
+}
+
+static void bench_text_input(ecs_world_t* world) {
+    const long long n = 100000LL * s_scale;
+    CELS_Input idle, insert, backspace, del, left, right;
+    memset(&idle, 0, sizeof(idle));
+    insert = backspace = del = left = right = idle;
+    insert.has_raw_key = true;
+    insert.raw_key = 'x';
+    backspace.key_backspace = true;
+    del.key_delete = true;
+    left.axis_left[0] = -1.0f;
+    right.axis_left[0] = 1.0f;
+
+    bench_world_reset(world);
+    ecs_entity_t e = text_input_spawn(world, 0);
+
+    MICRO_LOOP("text_input/idle", n, {
+        text_input_system_run(world, &idle, &idle);
+    });
+
+    MICRO_LOOP("text_input/insert_backspace_end", n, {
+        text_input_system_run(world, (i & 1) ? &backspace : &insert, &idle);
+    });
+
+    bench_world_reset(world);
+    e = text_input_spawn(world, 200);
+
+    text_input_cursor(world, e, false);
+    MICRO_LOOP("text_input/insert_backspace_mid", n, {
+        text_input_system_run(world, (i & 1) ? &backspace : &insert, &idle);
+    });
+
+    /* Insert, step back over it, delete it: cursor and length return */
+    text_input_cursor(world, e, false);
+    MICRO_LOOP("text_input/insert_left_delete_mid", n, {
+        const CELS_Input* key = (i % 3 == 0) ? &insert : (i % 3 == 1) ? &left : &del;
+        text_input_system_run(world, key, &idle);
+    });
+
+    text_input_cursor(world, e, false);
+    MICRO_LOOP("text_input/cursor_move", n, {
+        text_input_system_run(world, (i & 1) ? &left : &right, &idle);
+    });
+}
+
+/* ============================================================================
+ * Baseline Comparison
+ *
+ * The baseline is a previous -o file. Only "name" / "ns_per_op" pairs are
+ * read, in order, so any writer that emits them flat per result works.
+ * ============================================================================ */
+
+typedef struct MicroBaseline {
+    char name[MICRO_NAME_MAX];
+    double ns_per_op;
+} MicroBaseline;
+
+static int baseline_load(const char* path, MicroBaseline* out, int max) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = (char*)malloc((size_t)size + 1);
+    if (!text) {
+        fclose(f);
+        return -1;
+    }
+    size_t got = fread(text, 1, (size_t)size, f);
+    text[got] = '\0';
+    fclose(f);
+
+    int count = 0;
+    const char* p = text;
+    while (count < max && (p = strstr(p, "\"name\"")) != NULL) {
+        const char* name = strchr(p + 6, '"');
+        if (!name) break;
+        name++;
+        const char* end = strchr(name, '"');
+        if (!end) break;
+        p = end + 1;
+
+        const char* num = strstr(p, "\"ns_per_op\"");
+        const char* next = strstr(p, "\"name\"");
+        if (!num || (next && num > next)) continue;
+        num = strchr(num + 11, ':');
+        if (!num) break;
+
+        int len = (int)(end - name);
+        if (len >= MICRO_NAME_MAX) len = MICRO_NAME_MAX - 1;
+        memcpy(out[count].name, name, (size_t)len);
+        out[count].name[len] = '\0';
+        out[count].ns_per_op = strtod(num + 1, NULL);
+        count++;
+    }
+    free(text);
+    return count;
+}
+
+/* Returns the number of regressions beyond threshold_pct, or -1 when
+ * there is nothing to compare against */
+static int baseline_compare(const char* path, double threshold_pct) {
+    static MicroBaseline base[MICRO_MAX_RESULTS];
+    int base_count = baseline_load(path, base, MICRO_MAX_RESULTS);
+    if (base_count < 0) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", path);
+        return -1;
+    }
+    if (base_count == 0) {
+        fprintf(stderr, "bench: baseline %s has no results; regenerate it with -o\n", path);
+        return -1;
+    }
+
+    int regressions = 0, improvements = 0, missing = 0;
+    fprintf(stderr, "\n%-40s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns", "delta");
+    for (int i = 0; i < s_result_count; i++) {
+        const MicroResult* r = &s_results[i];
+        const MicroBaseline* b = NULL;
+        for (int k = 0; k < base_count; k++) {
+            if (strcmp(base[k].name, r->name) == 0) {
+                b = &base[k];
+                break;
+            }
+        }
+        if (!b || b->ns_per_op <= 0.0) {
+            fprintf(stderr, "%-40s %12s %12.1f %9s\n", r->name, "-", r->ns_per_op, "new");
+            missing++;
+            continue;
+        }
+        double delta = (r->ns_per_op - b->ns_per_op) / b->ns_per_op * 100.0;
+        const char* flag = "";
+        if (delta > threshold_pct) {
+            flag = "  REGRESSION";
+            regressions++;
+        } else if (delta < -threshold_pct) {
+            flag = "  faster";
+            improvements++;
+        }
+        fprintf(stderr, "%-40s %12.1f %12.1f %+8.1f%%%s\n",
+                r->name, b->ns_per_op, r->ns_per_op, delta, flag);
+    }
+    fprintf(stderr, "\n%d regressed, %d faster, %d without baseline (threshold %.1f%%)\n",
+            regressions, improvements, missing, threshold_pct);
+    return regressions;
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    const char* baseline_path = NULL;
+    double threshold = 10.0;
+    int instances = 32;
+    int frames = 50;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            s_reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            s_scale = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            s_filter = argv[++i];
+        } else {
+            fprintf(stderr,
+                    "usage: %s [-o out.json] [-b baseline.json] [-t pct] [-r reps] "
+                    "[-s scale] [-k filter]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_reps < 1) s_reps = 1;
+    if (s_scale < 1) s_scale = 1;
+
+    ecs_world_t* world = bench_world_open();
+    if (!world) {
+        fprintf(stderr, "bench: no cels world\n");
+        return 1;
+    }
+    bench_dashboard_name_stats();
+
+    bench_layouts(world, instances, frames * s_scale);
+    bench_helpers();
+    bench_text_input(world);
+
+    FILE* out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) {
+        perror(out_path);
+        return 1;
+    }
+
+    BenchJson j;
+    bench_json_begin(&j, out);
+    bench_json_str(&j, "bench", "micro");
+    bench_json_int(&j, "reps", s_reps);
+    bench_json_array(&j, "results");
+    for (int i = 0; i < s_result_count; i++) {
+        bench_json_object(&j, NULL);
+        bench_json_str(&j, "name", s_results[i].name);
+        bench_json_num(&j, "ns_per_op", s_results[i].ns_per_op);
+        bench_json_int(&j, "ops", s_results[i].ops);
+        bench_json_close(&j, '}');
+    }
+    bench_json_close(&j, ']');
+    bench_json_end(&j);
+    if (out != stdout) fclose(out);
+
+    int regressions = baseline_path ? baseline_compare(baseline_path, threshold) : 0;
+    bench_dashboard_free();
+    return regressions != 0 ? 1 : 0;
+}
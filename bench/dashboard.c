@@ -0,0 +1,492 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Synthetic dashboards for benchmarks
+ *
+ * Dashboards are composed through the Widget_* compositions by a root
+ * composition, so every frame pays for recomposition (W_MEMO, W_HAS
+ * diffs, cel_has) the way an app does. Single widgets for the micro and
+ * focus benches are spawned as raw entities whose components mirror what
+ * each composition attaches. Data behind pointers (rows, chart values,
+ * models) is shared across tiles -- it is read-only to the widgets.
+ */
+
+#include "dashboard.h"
+
+#include <cels-widgets/compositions.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char* const bench_widget_names[BW_COUNT] = {
+    "panel", "text", "hint", "canvas", "info_box", "badge", "text_area",
+    "button", "slider", "toggle", "cycle", "progress_bar", "metric",
+    "divider", "table", "collapsible", "split_pane", "scrollable",
+    "theme_scope", "radio_group", "radio_button", "tab_bar", "tab_content",
+    "tab_view", "tab_page", "status_bar", "list_view", "list_item",
+    "text_input", "popup", "modal", "window", "toast", "toast_stack",
+    "perf_overlay",
+    "spark", "bar_chart", "powerline", "log_viewer", "datagrid",
+    "tree_view", "file_browser"
+};
+
+static const bench_layout_fn s_layouts[BW_COUNT] = {
+    w_panel_layout, w_text_layout, w_hint_layout, w_canvas_layout,
+    w_info_box_layout, w_badge_layout, w_text_area_layout,
+    w_button_layout, w_slider_layout, w_toggle_layout, w_cycle_layout,
+    w_progress_bar_layout, w_metric_layout,
+    w_divider_layout, w_table_layout, w_collapsible_layout,
+    w_split_pane_layout, w_scrollable_layout,
+    w_theme_scope_layout, w_radio_group_layout, w_radio_button_layout,
+    w_tab_bar_layout, w_tab_content_layout,
+    w_tab_view_layout, w_tab_page_layout, w_status_bar_layout,
+    w_list_view_layout, w_list_item_layout,
+    w_text_input_layout, w_popup_layout, w_modal_layout, w_window_layout,
+    w_toast_layout, w_toast_stack_layout,
+    w_perf_overlay_layout,
+    w_spark_layout, w_bar_chart_layout, w_powerline_layout,
+    w_log_viewer_layout, w_datagrid_layout,
+    w_tree_view_layout, w_file_browser_layout
+};
+
+bench_layout_fn bench_widget_layout(BenchWidget type) {
+    return (type >= 0 && type < BW_COUNT) ? s_layouts[type] : NULL;
+}
+
+static int widget_type_of(bench_layout_fn layout) {
+    for (int t = 0; t < BW_COUNT; t++) {
+        if (s_layouts[t] == layout) return t;
+    }
+    return -1;
+}
+
+void bench_dashboard_name_stats(void) {
+    for (int i = 0; i < BW_COUNT && i < BENCH_LAYOUT_TYPES; i++) {
+        bench_layout_stats[i].name = bench_widget_names[i];
+    }
+}
+
+/* ============================================================================
+ * Shared Data
+ * ============================================================================ */
+
+#define ROWS 200
+
+static const char* s_labels[] = {
+    "cpu", "memory", "disk", "network", "latency", "errors", "queue", "cache"
+};
+#define LABEL(seed) s_labels[(unsigned)(seed) % 8]
+
+static const char* s_tab_labels[] = { "Overview", "Logs", "Metrics", "Config" };
+
+static const char* s_keys[ROWS];
+static const char* s_values[ROWS];
+static char s_key_buf[ROWS][16];
+static char s_value_buf[ROWS][16];
+
+static float s_spark[64];
+static W_BarChartEntry s_bars[6];
+static W_LogEntry s_log[ROWS];
+static W_PowerlineSegment s_segments[3];
+
+static long long s_grid_ids[ROWS];
+static double s_grid_load[ROWS];
+static W_DataGridColumn s_grid_columns[3];
+
+static W_TreeModel* s_tree = NULL;
+static W_DirListing* s_listing = NULL;
+static W_ToastManager* s_toasts = NULL;
+static W_TabCache* s_tab_cache = NULL;
+
+static int s_tile_count = 0;        /* Tiles BenchDashboard composes */
+
+static const Widget_Theme s_scope_theme = { .border = _W_V(220, 80, 80) };
+
+/* Tree source: every node has four children, eight levels deep */
+static int tree_child_count(void* user_data, uint64_t parent) {
+    (void)user_data;
+    return parent < 4096 ? 4 : 0;
+}
+
+static void tree_child_at(void* user_data, uint64_t parent, int index, W_TreeNode* out) {
+    (void)user_data;
+    out->id = parent * 4 + (uint64_t)index + 1;
+    out->label = LABEL(out->id);
+    out->has_children = out->id < 4096;
+}
+
+static void shared_data_init(void) {
+    static bool done = false;
+    if (done) return;
+    done = true;
+
+    for (int i = 0; i < ROWS; i++) {
+        snprintf(s_key_buf[i], sizeof(s_key_buf[i]), "key_%d", i);
+        snprintf(s_value_buf[i], sizeof(s_value_buf[i]), "%d ms", i * 7 % 997);
+        s_keys[i] = s_key_buf[i];
+        s_values[i] = s_value_buf[i];
+        s_log[i] = (W_LogEntry){ .message = s_value_buf[i], .level = i % 4,
+                                 .timestamp = "12:00:00" };
+        s_grid_ids[i] = i;
+        s_grid_load[i] = (double)((i * 37) % 100) / 100.0;
+    }
+    for (int i = 0; i < 64; i++) s_spark[i] = (float)((i * 13) % 29);
+    for (int i = 0; i < 6; i++) {
+        s_bars[i] = (W_BarChartEntry){ .label = s_labels[i], .value = (float)(i * 15 + 10) };
+    }
+    s_segments[0] = (W_PowerlineSegment){ "NORMAL", {100, 210, 220, 255}, {30, 33, 45, 255} };
+    s_segments[1] = (W_PowerlineSegment){ "main",   {50, 54, 65, 255},    {200, 205, 220, 255} };
+    s_segments[2] = (W_PowerlineSegment){ "utf-8",  {30, 33, 45, 255},    {120, 130, 160, 255} };
+
+    s_grid_columns[0] = (W_DataGridColumn){ .title = "id", .kind = W_GRID_INT,
+                                            .ints = s_grid_ids, .width = 6 };
+    s_grid_columns[1] = (W_DataGridColumn){ .title = "name", .kind = W_GRID_TEXT,
+                                            .text = s_keys, .width = 12 };
+    s_grid_columns[2] = (W_DataGridColumn){ .title = "load", .kind = W_GRID_FLOAT,
+                                            .floats = s_grid_load, .width = 8 };
+
+    static const W_TreeSource source = {
+        .root = 0, .child_count = tree_child_count, .child_at = tree_child_at
+    };
+    s_tree = Widget_tree_create(&source);
+    s_listing = Widget_dir_create();
+    s_toasts = Widget_toasts_create(3);
+    Widget_toast_push(s_toasts, "Deploy finished", 1, 0, 1e9f);
+    Widget_toast_push(s_toasts, "Disk almost full", 2, 0, 1e9f);
+    s_tab_cache = Widget_tab_cache_create(1);
+}
+
+void bench_dashboard_free(void) {
+    s_tile_count = 0;
+    Widget_tree_destroy(s_tree);
+    Widget_dir_destroy(s_listing);
+    Widget_toasts_destroy(s_toasts);
+    Widget_tab_cache_destroy(s_tab_cache);
+    s_tree = NULL;
+    s_listing = NULL;
+    s_toasts = NULL;
+    s_tab_cache = NULL;
+}
+
+/* ============================================================================
+ * Spawning
+ * ============================================================================ */
+
+static void interactive(ecs_world_t* world, ecs_entity_t e, bool selected) {
+    bench_set(world, e, W_Selectable, .selected = selected);
+    bench_set(world, e, W_InteractState, .selected = selected);
+}
+
+ecs_entity_t bench_widget_spawn(ecs_world_t* world, ecs_entity_t parent,
+                                BenchWidget type, int seed) {
+    shared_data_init();
+    ecs_entity_t e = bench_spawn(world, parent, bench_widget_layout(type), (int)type);
+
+    switch (type) {
+        case BW_PANEL:
+            bench_set(world, e, W_Panel, .title = LABEL(seed), .border_style = seed % 3);
+            bench_set(world, e, W_NavigationScope, .wrap = true);
+            break;
+        case BW_TEXT:
+            bench_set(world, e, W_Text, .text = "Requests per second across all shards");
+            break;
+        case BW_HINT:
+            bench_set(world, e, W_Hint, .text = "Tab: next  Enter: open  q: quit");
+            break;
+        case BW_CANVAS:
+            bench_set(world, e, W_Canvas, .title = LABEL(seed), .width = 30);
+            break;
+        case BW_INFO_BOX:
+            bench_set(world, e, W_InfoBox, .title = "Host", .content = "eu-west-3b", .border = true);
+            break;
+        case BW_BADGE:
+            bench_set(world, e, W_Badge, .text = "LIVE", .r = 80, .g = 200, .b = 100);
+            break;
+        case BW_TEXT_AREA:
+            bench_set(world, e, W_TextArea,
+                      .text = "Line one of the notes\nLine two wraps past the width of the area",
+                      .max_width = 30, .max_height = 4);
+            break;
+        case BW_BUTTON:
+            bench_set(world, e, W_Button, .label = LABEL(seed));
+            interactive(world, e, seed % 7 == 0);
+            break;
+        case BW_SLIDER:
+            bench_set(world, e, W_Slider, .label = "Volume");
+            bench_set(world, e, W_RangeValueF, .value = (float)(seed % 10) / 10.0f,
+                      .min = 0.0f, .max = 1.0f, .step = 0.1f);
+            interactive(world, e, false);
+            break;
+        case BW_TOGGLE:
+            bench_set(world, e, W_Toggle, .label = "Enabled", .value = seed & 1);
+            interactive(world, e, false);
+            break;
+        case BW_CYCLE:
+            bench_set(world, e, W_Cycle, .label = "Mode", .value = "auto");
+            interactive(world, e, false);
+            break;
+        case BW_PROGRESS_BAR:
+            bench_set(world, e, W_ProgressBar, .label = "Upload", .color_by_value = true);
+            bench_set(world, e, W_RangeValueF, .value = (float)(seed % 100) / 100.0f,
+                      .min = 0.0f, .max = 1.0f);
+            break;
+        case BW_METRIC:
+            bench_set(world, e, W_Metric, .label = LABEL(seed), .value = "42 ms", .status = seed % 4);
+            break;
+        case BW_DIVIDER:
+            bench_set(world, e, W_Divider, .vertical = false);
+            break;
+        case BW_TABLE:
+            bench_set(world, e, W_Table, .row_count = ROWS, .keys = s_keys, .values = s_values,
+                      .key_header = "Key", .value_header = "Value", .visible_height = 8);
+            bench_set(world, e, W_Scrollable, .total_count = ROWS, .visible_count = 7);
+            bench_set(world, e, W_TableState, .initialized = false);
+            break;
+        case BW_COLLAPSIBLE: {
+            bench_set(world, e, W_Collapsible, .title = "Details");
+            W_UiState* ui = Widget_ui_state(world, e);
+            if (ui) ui->expanded = !(seed & 1);
+            interactive(world, e, false);
+            break;
+        }
+        case BW_SPLIT_PANE:
+            bench_set(world, e, W_SplitPane, .ratio = 0.5f);
+            break;
+        case BW_SCROLLABLE:
+            bench_set(world, e, W_ScrollContainer, .height = 6);
+            bench_set(world, e, W_Scrollable, .total_count = 20, .visible_count = 6);
+            break;
+        case BW_THEME_SCOPE:
+            bench_set(world, e, W_ThemeScope, .theme = &s_scope_theme);
+            bench_set(world, e, W_ThemeScopeState, .cache = { .generation = 0 });
+            break;
+        case BW_RADIO_GROUP:
+            bench_set(world, e, W_RadioGroup, .group_id = seed + 1, .count = 2);
+            break;
+        case BW_RADIO_BUTTON:
+            bench_set(world, e, W_RadioButton, .label = LABEL(seed), .group_id = seed + 1);
+            interactive(world, e, false);
+            break;
+        case BW_TAB_BAR:
+            bench_set(world, e, W_TabBar, .active = seed % 4, .count = 4, .labels = s_tab_labels);
+            bench_set(world, e, W_TabBarState, .first = 0);
+            break;
+        case BW_TAB_CONTENT:
+            bench_set(world, e, W_TabContent, .text = "Nothing selected", .hint = "Pick a row");
+            break;
+        case BW_TAB_VIEW:
+            bench_set(world, e, W_TabView, .active = 0, .count = 4, .labels = s_tab_labels,
+                      .cache = s_tab_cache);
+            bench_set(world, e, W_TabBarState, .first = 0);
+            break;
+        case BW_TAB_PAGE:
+            bench_set(world, e, W_TabPage, .index = 0);
+            break;
+        case BW_STATUS_BAR:
+            bench_set(world, e, W_StatusBar, .left = "NORMAL  main.c", .right = "Ln 12, Col 4");
+            break;
+        case BW_LIST_VIEW:
+            bench_set(world, e, W_ListView, .item_count = 4, .selected_index = 0);
+            bench_set(world, e, W_Scrollable, .total_count = 4, .visible_count = 4);
+            break;
+        case BW_LIST_ITEM:
+            bench_set(world, e, W_ListItem, .label = LABEL(seed));
+            interactive(world, e, seed % 4 == 0);
+            break;
+        case BW_TEXT_INPUT:
+            bench_set(world, e, W_TextInput, .placeholder = "Search...", .max_length = 64);
+            bench_set(world, e, W_TextInputBuffer, .initialized = false);
+            bench_set(world, e, W_Focusable, .tab_order = seed);
+            interactive(world, e, false);
+            break;
+        case BW_POPUP:
+            bench_set(world, e, W_Popup, .title = "Confirm", .visible = false, .width = 30);
+            bench_set(world, e, W_OverlayState, .visible = false, .z_index = 200);
+            break;
+        case BW_MODAL:
+            bench_set(world, e, W_Modal, .title = "Settings", .visible = false, .width = 40);
+            bench_set(world, e, W_OverlayState, .visible = false, .z_index = 250, .modal = true);
+            break;
+        case BW_WINDOW:
+            bench_set(world, e, W_Window, .title = "Inspector", .visible = false,
+                      .width = 40, .height = 10, .z_order = seed % 16);
+            bench_set(world, e, W_OverlayState, .visible = false, .z_index = 150, .modal = true);
+            break;
+        case BW_TOAST:
+            bench_set(world, e, W_Toast, .message = "Saved", .duration = 1e9f, .severity = 1,
+                      .position = seed % 4);
+            break;
+        case BW_TOAST_STACK:
+            bench_set(world, e, W_ToastStack, .manager = s_toasts);
+            break;
+        case BW_PERF_OVERLAY:
+            bench_set(world, e, W_PerfOverlay, .start_visible = true, .position = seed % 4);
+            bench_set(world, e, W_PerfOverlayState, .initialized = false);
+            break;
+        case BW_SPARK:
+            bench_set(world, e, W_Spark, .values = s_spark, .count = 64);
+            break;
+        case BW_BAR_CHART:
+            bench_set(world, e, W_BarChart, .entries = s_bars, .count = 6, .gradient = true);
+            break;
+        case BW_POWERLINE:
+            bench_set(world, e, W_Powerline, .segments = s_segments, .segment_count = 3);
+            break;
+        case BW_LOG_VIEWER:
+            bench_set(world, e, W_LogViewer, .entries = s_log, .entry_count = ROWS,
+                      .visible_height = 8);
+            bench_set(world, e, W_Scrollable, .total_count = ROWS, .visible_count = 8);
+            bench_set(world, e, W_LogViewerState, .initialized = false);
+            break;
+        case BW_DATAGRID:
+            bench_set(world, e, W_DataGrid, .columns = s_grid_columns, .column_count = 3,
+                      .row_count = ROWS, .visible_height = 8, .visible_width = 40);
+            bench_set(world, e, W_Scrollable, .total_count = ROWS, .visible_count = 7);
+            bench_set(world, e, W_DataGridState, .col_offset = 0);
+            break;
+        case BW_TREE_VIEW:
+            bench_set(world, e, W_TreeView, .model = s_tree, .visible_height = 8);
+            bench_set(world, e, W_Scrollable, .total_count = Widget_tree_row_count(s_tree),
+                      .visible_count = 8);
+            break;
+        case BW_FILE_BROWSER:
+            bench_set(world, e, W_FileBrowser, .listing = s_listing, .visible_height = 8);
+            bench_set(world, e, W_Scrollable, .visible_count = 8);
+            break;
+        default:
+            break;
+    }
+    return e;
+}
+
+/* ============================================================================
+ * Composed Dashboard
+ * ============================================================================ */
+
+/* One tile: a panel holding a navigation scope with every other widget
+ * type inside; containers that expect children get them. Props match
+ * bench_widget_spawn(). */
+static void tile_compose(int seed) {
+    Widget_Panel(.title = LABEL(seed), .border_style = seed % 3) {
+        Widget_NavigationGroup(.wrap = true) {
+            Widget_Text(.text = "Requests per second across all shards") {}
+            Widget_Hint(.text = "Tab: next  Enter: open  q: quit") {}
+            Widget_Canvas(.title = LABEL(seed), .width = 30) {}
+            Widget_InfoBox(.title = "Host", .content = "eu-west-3b", .border = true) {}
+            Widget_Badge(.text = "LIVE", .r = 80, .g = 200, .b = 100) {}
+            Widget_TextArea(.text = "Line one of the notes\nLine two wraps past the width of the area",
+                            .max_width = 30, .max_height = 4) {}
+            Widget_Button(.label = LABEL(seed), .selected = seed % 7 == 0) {}
+            Widget_Slider(.label = "Volume", .value = (float)(seed % 10) / 10.0f,
+                          .min = 0.0f, .max = 1.0f) {}
+            Widget_Toggle(.label = "Enabled", .value = seed & 1) {}
+            Widget_Cycle(.label = "Mode", .value = "auto") {}
+            Widget_ProgressBar(.label = "Upload", .value = (float)(seed % 100) / 100.0f,
+                               .color_by_value = true) {}
+            Widget_Metric(.label = LABEL(seed), .value = "42 ms", .status = seed % 4) {}
+            Widget_Divider(.vertical = false) {}
+            Widget_Table(.row_count = ROWS, .keys = s_keys, .values = s_values,
+                         .key_header = "Key", .value_header = "Value", .visible_height = 8) {}
+            Widget_Collapsible(.title = "Details", .collapsed = seed & 1) {
+                Widget_Text(.text = "Requests per second across all shards") {}
+            }
+            Widget_Split(.ratio = 0.5f) {
+                Widget_Metric(.label = LABEL(seed), .value = "42 ms", .status = seed % 4) {}
+                Widget_Metric(.label = LABEL(seed + 1), .value = "42 ms",
+                              .status = (seed + 1) % 4) {}
+            }
+            Widget_Scrollable(.height = 6, .total_count = 20) {
+                Widget_Text(.text = "Requests per second across all shards") {}
+            }
+            Widget_ThemeScope(.theme = &s_scope_theme) {
+                Widget_Text(.text = "Requests per second across all shards") {}
+            }
+            Widget_RadioGroup(.group_id = seed + 1, .count = 2) {
+                for (int i = 0; i < 2; i++) {
+                    Widget_RadioButton(.label = LABEL(seed), .group_id = seed + 1) {}
+                }
+            }
+            Widget_TabBar(.active = seed % 4, .count = 4, .labels = s_tab_labels) {}
+            Widget_TabContent(.text = "Nothing selected", .hint = "Pick a row") {}
+            Widget_TabView(.active = 0, .count = 4, .labels = s_tab_labels,
+                           .cache = s_tab_cache) {
+                for (int i = 0; i < 4; i++) {
+                    Widget_TabPage(.index = i) {
+                        if (Widget_tab_cache_live(s_tab_cache, i)) {
+                            Widget_Text(.text = s_tab_labels[i]) {}
+                        }
+                    }
+                }
+            }
+            Widget_StatusBar(.left = "NORMAL  main.c", .right = "Ln 12, Col 4") {}
+            Widget_ListView(.item_count = 4, .selected_index = 0) {
+                for (int i = 0; i < 4; i++) {
+                    Widget_ListItem(.label = LABEL(seed + i), .selected = (seed + i) % 4 == 0,
+                                    .key = (uint64_t)i + 1) {}
+                }
+            }
+            Widget_TextInput(.placeholder = "Search...", .max_length = 64) {}
+            Widget_Popup(.title = "Confirm", .visible = false, .width = 30) {}
+            Widget_Modal(.title = "Settings", .visible = false, .width = 40) {}
+            Widget_Window(.title = "Inspector", .visible = false,
+                          .width = 40, .height = 10, .z_order = seed % 16) {}
+            Widget_Toast(.message = "Saved", .duration = 1e9f, .severity = 1,
+                         .position = seed % 4) {}
+            Widget_ToastStack(.manager = s_toasts) {}
+            Widget_PerfOverlay(.start_visible = true, .position = seed % 4) {}
+            Widget_Spark(.values = s_spark, .count = 64) {}
+            Widget_BarChart(.entries = s_bars, .count = 6, .gradient = true) {}
+            Widget_Powerline(.segments = s_segments, .segment_count = 3) {}
+            Widget_LogViewer(.entries = s_log, .entry_count = ROWS, .visible_height = 8) {}
+            Widget_DataGrid(.columns = s_grid_columns, .column_count = 3,
+                            .row_count = ROWS, .visible_height = 8, .visible_width = 40) {}
+            Widget_TreeView(.model = s_tree, .visible_height = 8) {}
+            Widget_FileBrowser(.listing = s_listing, .visible_height = 8) {}
+        }
+    }
+}
+
+/* tiles is informational; the column only lays out its children */
+CEL_Composition(BenchColumn, int tiles;) {
+    W_HAS(ClayUI, .layout_fn = bench_column_layout);
+}
+
+/* Recomposed every frame, like an app's root */
+CEL_Root(BenchDashboard) {
+    if (s_tile_count <= 0) return;
+    cel_init(BenchColumn, .tiles = s_tile_count) {
+        for (int seed = 0; seed < s_tile_count; seed++) tile_compose(seed);
+    }
+}
+
+int bench_dashboard_build(ecs_world_t* world, int widget_count) {
+    shared_data_init();
+
+    /* Drop the previous size's tiles so no widget state carries over */
+    s_tile_count = 0;
+    ecs_progress(world, 0.0f);
+
+    /* Widgets per tile, then enough tiles to reach widget_count */
+    s_tile_count = 1;
+    ecs_progress(world, 0.0f);
+    int per_tile = bench_instrument(world, widget_type_of);
+    if (per_tile <= 0) return 0;
+
+    s_tile_count = (widget_count + per_tile - 1) / per_tile;
+    if (s_tile_count < 1) s_tile_count = 1;
+    ecs_progress(world, 0.0f);
+    return bench_instrument(world, widget_type_of);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Synthetic dashboards for benchmarks
+ *
+ * A dashboard is a column of tiles. Each tile is a W_Panel navigation
+ * scope holding one instance of every widget type in widgets.h with
+ * representative props (lists and tables carry rows, charts carry data).
+ * Tiles repeat until the requested widget count is reached. The dashboard
+ * is composed with the Widget_* compositions and recomposes every frame.
+ */
+
+#ifndef CELS_WIDGETS_BENCH_DASHBOARD_H
+#define CELS_WIDGETS_BENCH_DASHBOARD_H
+
+#include "harness.h"
+
+/* Widget types; values index bench_layout_stats */
+typedef enum BenchWidget {
+    BW_PANEL, BW_TEXT, BW_HINT, BW_CANVAS, BW_INFO_BOX, BW_BADGE, BW_TEXT_AREA,
+    BW_BUTTON, BW_SLIDER, BW_TOGGLE, BW_CYCLE, BW_PROGRESS_BAR, BW_METRIC,
+    BW_DIVIDER, BW_TABLE, BW_COLLAPSIBLE, BW_SPLIT_PANE, BW_SCROLLABLE,
+    BW_THEME_SCOPE, BW_RADIO_GROUP, BW_RADIO_BUTTON, BW_TAB_BAR, BW_TAB_CONTENT,
+    BW_TAB_VIEW, BW_TAB_PAGE, BW_STATUS_BAR, BW_LIST_VIEW, BW_LIST_ITEM,
+    BW_TEXT_INPUT, BW_POPUP, BW_MODAL, BW_WINDOW, BW_TOAST, BW_TOAST_STACK,
+    BW_PERF_OVERLAY,
+    BW_SPARK, BW_BAR_CHART, BW_POWERLINE, BW_LOG_VIEWER, BW_DATAGRID,
+    BW_TREE_VIEW, BW_FILE_BROWSER,
+    BW_COUNT
+} BenchWidget;
+
+extern const char* const bench_widget_names[BW_COUNT];
+
+/* Layout function for a widget type */
+extern bench_layout_fn bench_widget_layout(BenchWidget type);
+
+/* Name the bench_layout_stats slots after the widget types */
+extern void bench_dashboard_name_stats(void);
+
+/* Spawn one widget of type under parent as a raw entity with the
+ * components its composition would attach. Returns the entity; seed
+ * varies labels and values between instances. Not recomposed. */
+extern ecs_entity_t bench_widget_spawn(ecs_world_t* world, ecs_entity_t parent,
+                                       BenchWidget type, int seed);
+
+/* Compose tiles until at least widget_count widgets exist, replacing any
+ * previous dashboard. Runs world frames to do so. Returns the number of
+ * widgets (entities with a timed layout) composed. */
+extern int bench_dashboard_build(ecs_world_t* world, int widget_count);
+
+/* Release the shared models (tree, grid index, listing, caches) */
+extern void bench_dashboard_free(void);
+
+#endif /* CELS_WIDGETS_BENCH_DASHBOARD_H */
@@ -0,0 +1,379 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Benchmark harness implementation
+ *
+ * Runtime bring-up is confined to bench_world_open(): cels creates its
+ * context on first use, Widgets_init() registers components and systems,
+ * and the library's own systems are disabled in the pipeline so the
+ * harness can run (and time) them itself. Everything else here is plain
+ * flecs and Clay.
+ */
+
+#include "harness.h"
+
+#include <cels-clay/clay_layout.h>
+#include <clay.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/* ============================================================================
+ * Clock
+ * ============================================================================ */
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+long bench_peak_rss_kb(void) {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    return ru.ru_maxrss;
+}
+
+/* ============================================================================
+ * Clay Element Counting
+ *
+ * With BENCH_COUNT_CLAY_ELEMENTS the bench links with
+ * -Wl,--wrap=Clay__OpenElement,--wrap=Clay__OpenTextElement so every
+ * element opened by a layout (in another object file) passes through here.
+ * Profile builds (CELS_WIDGETS_PROFILE_CLAY) own that wrap; the counts
+ * then come from Widget_profile_clay_counts().
+ * ============================================================================ */
+
+#if defined(BENCH_COUNT_CLAY_ELEMENTS) || defined(CELS_WIDGETS_PROFILE_CLAY)
+#define BENCH_CLAY_COUNTED 1
+#endif
+
+#if defined(CELS_WIDGETS_PROFILE_CLAY)
+#include <cels-widgets/profile.h>
+
+static long long clay_elements(void) {
+    long long elements = 0;
+    Widget_profile_clay_counts(&elements, NULL);
+    return elements;
+}
+
+static long long clay_text_elements(void) {
+    long long text = 0;
+    Widget_profile_clay_counts(NULL, &text);
+    return text;
+}
+#else
+static long long s_clay_elements = 0;
+static long long s_clay_text_elements = 0;
+
+static long long clay_elements(void) { return s_clay_elements; }
+static long long clay_text_elements(void) { return s_clay_text_elements; }
+
+#ifdef BENCH_COUNT_CLAY_ELEMENTS
+extern void __real_Clay__OpenElement(void);
+void __wrap_Clay__OpenElement(void) {
+    s_clay_elements++;
+    __real_Clay__OpenElement();
+}
+
+extern void __real_Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig* config);
+void __wrap_Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig* config) {
+    s_clay_text_elements++;
+    __real_Clay__OpenTextElement(text, config);
+}
+#endif
+#endif
+
+/* ============================================================================
+ * Layout Trampoline
+ *
+ * Each spawned entity keeps its real layout function in BenchLayout; its
+ * ClayUI points at bench_timed_layout. Nested calls (CEL_Clay_Children)
+ * are subtracted from the parent so per-type times are exclusive.
+ *
+ * Composed entities are routed after their first frame. W_HAS diffs
+ * against the props it applied last, not the live ClayUI, so
+ * recomposition leaves the trampoline in place.
+ * ============================================================================ */
+
+typedef struct BenchLayout {
+    bench_layout_fn fn;
+    int type;
+} BenchLayout;
+
+static ecs_entity_t s_bench_layout_id = 0;
+
+BenchLayoutStat bench_layout_stats[BENCH_LAYOUT_TYPES];
+
+#define BENCH_LAYOUT_DEPTH 256
+static uint64_t s_child_ns[BENCH_LAYOUT_DEPTH];
+static int s_layout_depth = 0;
+static uint64_t s_frame_layout_ns = 0;
+static int s_frame_layout_calls = 0;
+
+static void bench_timed_layout(struct ecs_world_t* world, cels_entity_t self) {
+    const BenchLayout* bl = (const BenchLayout*)ecs_get_id(world, self, s_bench_layout_id);
+    if (!bl || !bl->fn) return;
+
+    int depth = s_layout_depth++;
+    if (depth < BENCH_LAYOUT_DEPTH) s_child_ns[depth] = 0;
+    long long elements_before = clay_elements() + clay_text_elements();
+
+    uint64_t start = bench_now_ns();
+    bl->fn(world, self);
+    uint64_t elapsed = bench_now_ns() - start;
+
+    s_layout_depth--;
+    uint64_t children = depth < BENCH_LAYOUT_DEPTH ? s_child_ns[depth] : 0;
+    uint64_t exclusive = elapsed > children ? elapsed - children : 0;
+    if (depth > 0 && depth - 1 < BENCH_LAYOUT_DEPTH) s_child_ns[depth - 1] += elapsed;
+    if (depth == 0) s_frame_layout_ns += elapsed;
+    s_frame_layout_calls++;
+
+    BenchLayoutStat* st = &bench_layout_stats[bl->type];
+    st->ns += exclusive;
+    st->calls++;
+    /* Inclusive of children; good enough for leaf-heavy dashboards */
+    st->clay_elements += (clay_elements() + clay_text_elements()) - elements_before;
+}
+
+void bench_stats_reset(void) {
+    for (int i = 0; i < BENCH_LAYOUT_TYPES; i++) {
+        bench_layout_stats[i].ns = 0;
+        bench_layout_stats[i].calls = 0;
+        bench_layout_stats[i].clay_elements = 0;
+    }
+}
+
+/* ============================================================================
+ * World
+ * ============================================================================ */
+
+static const char* s_behavioral_systems[] = {
+    "W_RangeClampF", "W_RangeClampI",
+    "W_ToastTimer", "W_ToastStackTimer", "W_PerfOverlaySample"
+};
+#define BEHAVIORAL_SYSTEM_COUNT \
+    (int)(sizeof(s_behavioral_systems) / sizeof(s_behavioral_systems[0]))
+
+static ecs_entity_t s_behavioral[BEHAVIORAL_SYSTEM_COUNT];
+static ecs_entity_t s_bench_root = 0;
+
+/* Full-size column: the raw root and the composed dashboard's root */
+void bench_column_layout(struct ecs_world_t* world, cels_entity_t self) {
+    (void)world;
+    (void)self;
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+        }
+    ) {
+        CEL_Clay_Children();
+    }
+}
+
+static void bench_root_create(ecs_world_t* world) {
+    s_bench_root = ecs_new(world);
+    ClayUI ui = { .layout_fn = bench_column_layout };
+    ecs_set_id(world, s_bench_root, ClayUI_id, sizeof(ClayUI), &ui);
+}
+
+ecs_world_t* bench_world_open(void) {
+    Widgets_init();
+    ecs_world_t* world = cels_get_world(cels_get_context());
+    if (!world) return NULL;
+
+    ECS_COMPONENT(world, BenchLayout);
+    s_bench_layout_id = ecs_id(BenchLayout);
+
+    /* The harness runs focus and behavioral phases itself */
+    ecs_entity_t focus = ecs_lookup(world, "W_FocusSystem");
+    if (focus) ecs_enable(world, focus, false);
+    for (int i = 0; i < BEHAVIORAL_SYSTEM_COUNT; i++) {
+        s_behavioral[i] = ecs_lookup(world, s_behavioral_systems[i]);
+        if (s_behavioral[i]) ecs_enable(world, s_behavioral[i], false);
+    }
+
+    bench_root_create(world);
+    return world;
+}
+
+void bench_world_reset(ecs_world_t* world) {
+    if (s_bench_root) ecs_delete(world, s_bench_root);
+    bench_root_create(world);
+}
+
+ecs_entity_t bench_spawn(ecs_world_t* world, ecs_entity_t parent,
+                         bench_layout_fn layout, int type) {
+    ecs_entity_t e = ecs_new_w_pair(world, EcsChildOf, parent ? parent : s_bench_root);
+    if (layout) {
+        BenchLayout bl = { .fn = layout, .type = type };
+        ecs_set_id(world, e, s_bench_layout_id, sizeof(BenchLayout), &bl);
+        ClayUI ui = { .layout_fn = bench_timed_layout };
+        ecs_set_id(world, e, ClayUI_id, sizeof(ClayUI), &ui);
+    }
+    return e;
+}
+
+int bench_instrument(ecs_world_t* world, int (*type_of)(bench_layout_fn layout)) {
+    ecs_query_t* q = ecs_query(world, {
+        .terms = {{ .id = ClayUI_id }}
+    });
+    if (!q) return 0;
+
+    /* Adding BenchLayout moves the entity; defer until iteration ends */
+    int timed = 0;
+    ecs_defer_begin(world);
+    ecs_iter_t it = ecs_query_iter(world, q);
+    while (ecs_query_next(&it)) {
+        for (int i = 0; i < it.count; i++) {
+            const ClayUI* ui = (const ClayUI*)ecs_get_id(world, it.entities[i], ClayUI_id);
+            if (!ui) continue;
+            if (ui->layout_fn == bench_timed_layout) { timed++; continue; }
+            int type = type_of(ui->layout_fn);
+            if (type < 0 || type >= BENCH_LAYOUT_TYPES) continue;
+
+            BenchLayout bl = { .fn = ui->layout_fn, .type = type };
+            ecs_set_id(world, it.entities[i], s_bench_layout_id, sizeof(BenchLayout), &bl);
+            ClayUI upd = *ui;
+            upd.layout_fn = bench_timed_layout;
+            ecs_set_id(world, it.entities[i], ClayUI_id, sizeof(ClayUI), &upd);
+            timed++;
+        }
+    }
+    ecs_defer_end(world);
+    ecs_query_fini(q);
+    return timed;
+}
+
+/* ============================================================================
+ * Frames
+ * ============================================================================ */
+
+void bench_input_script(int frame, CELS_Input* out) {
+    memset(out, 0, sizeof(*out));
+    switch (frame % 8) {
+        case 0: out->key_tab = true; break;
+        case 1: out->axis_left[1] = 1.0f; break;      /* Down */
+        case 2: out->axis_left[0] = 1.0f; break;      /* Right */
+        case 3: out->button_accept = true; break;
+        case 4: out->key_page_down = true; break;
+        case 5: out->axis_left[1] = -1.0f; break;     /* Up */
+        case 6: out->axis_left[0] = -1.0f; break;     /* Left */
+        default: break;                               /* Idle frame */
+    }
+}
+
+void bench_frame(ecs_world_t* world, const CELS_Input* input, float dt,
+                 BenchFrame* out) {
+    memset(out, 0, sizeof(*out));
+    uint64_t frame_start = bench_now_ns();
+
+    uint64_t t0 = bench_now_ns();
+    widgets_focus_step(world, input, (int)ecs_count_id(world, W_Focusable_id));
+    out->focus_ns = bench_now_ns() - t0;
+
+    t0 = bench_now_ns();
+    for (int i = 0; i < BEHAVIORAL_SYSTEM_COUNT; i++) {
+        if (s_behavioral[i]) ecs_run(world, s_behavioral[i], dt, NULL);
+    }
+    out->behavioral_ns = bench_now_ns() - t0;
+
+    /* Remaining pipeline: compositions, cels-clay layout pass, Clay */
+    s_frame_layout_ns = 0;
+    s_frame_layout_calls = 0;
+    long long el0 = clay_elements(), tx0 = clay_text_elements();
+    t0 = bench_now_ns();
+    ecs_progress(world, dt);
+    uint64_t pass_ns = bench_now_ns() - t0;
+
+    out->layout_ns = s_frame_layout_ns;
+    out->clay_ns = pass_ns > s_frame_layout_ns ? pass_ns - s_frame_layout_ns : 0;
+    out->layout_calls = s_frame_layout_calls;
+#ifdef BENCH_CLAY_COUNTED
+    out->clay_elements = clay_elements() - el0;
+    out->clay_text_elements = clay_text_elements() - tx0;
+#else
+    (void)el0;
+    (void)tx0;
+    out->clay_elements = -1;
+    out->clay_text_elements = -1;
+#endif
+    out->total_ns = bench_now_ns() - frame_start;
+}
+
+/* ============================================================================
+ * JSON
+ * ============================================================================ */
+
+static void json_key(BenchJson* j, const char* key) {
+    if (!j->first[j->depth]) fputc(',', j->out);
+    j->first[j->depth] = false;
+    fputc('\n', j->out);
+    for (int i = 0; i < j->depth; i++) fputs("  ", j->out);
+    if (key) fprintf(j->out, "\"%s\": ", key);
+}
+
+static void json_open(BenchJson* j, const char* key, char bracket) {
+    json_key(j, key);
+    fputc(bracket, j->out);
+    if (j->depth < 15) j->depth++;
+    j->first[j->depth] = true;
+}
+
+void bench_json_begin(BenchJson* j, FILE* out) {
+    memset(j, 0, sizeof(*j));
+    j->out = out;
+    fputc('{', out);
+    j->depth = 1;
+    j->first[1] = true;
+}
+
+void bench_json_end(BenchJson* j) {
+    fputs("\n}\n", j->out);
+}
+
+void bench_json_object(BenchJson* j, const char* key) { json_open(j, key, '{'); }
+void bench_json_array(BenchJson* j, const char* key)  { json_open(j, key, '['); }
+
+void bench_json_close(BenchJson* j, char bracket) {
+    if (j->depth > 1) j->depth--;
+    fputc('\n', j->out);
+    for (int i = 0; i < j->depth; i++) fputs("  ", j->out);
+    fputc(bracket, j->out);
+}
+
+void bench_json_num(BenchJson* j, const char* key, double value) {
+    json_key(j, key);
+    fprintf(j->out, "%.3f", value);
+}
+
+void bench_json_int(BenchJson* j, const char* key, long long value) {
+    json_key(j, key);
+    fprintf(j->out, "%lld", value);
+}
+
+void bench_json_str(BenchJson* j, const char* key, const char* value) {
+    json_key(j, key);
+    fputc('"', j->out);
+    for (const char* p = value; p && *p; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', j->out);
+        fputc(*p, j->out);
+    }
+    fputc('"', j->out);
+}
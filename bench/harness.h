@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Benchmark harness
+ *
+ * Shared by the bench/ executables. Drives the widget library headless:
+ * no backend module is imported, so nothing touches the terminal and
+ * input comes from scripted CELS_Input frames.
+ *
+ * A frame is split into the phases the library owns:
+ *
+ *   focus       widgets_focus_step() with the scripted input
+ *   behavioral  the W_* behavioral systems, run one by one
+ *   layout      w_*_layout calls (exclusive time, children excluded)
+ *   clay        the rest of the world step: recomposition, cels-clay's
+ *               pass and Clay
+ *
+ * Dashboards are composed with the Widget_* compositions (dashboard.c), so
+ * every frame recomposes them. The micro and focus benches spawn single
+ * widgets as raw entities carrying the same components instead. Either
+ * way, layout functions are routed through a timing trampoline. Clay element counts come from linker-wrapped
+ * Clay__OpenElement / Clay__OpenTextElement where the toolchain supports
+ * it (BENCH_COUNT_CLAY_ELEMENTS).
+ */
+
+#ifndef CELS_WIDGETS_BENCH_HARNESS_H
+#define CELS_WIDGETS_BENCH_HARNESS_H
+
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/input.h>
+#include <cels-widgets/layouts.h>
+#include <flecs.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef void (*bench_layout_fn)(struct ecs_world_t* world, cels_entity_t self);
+
+/* ============================================================================
+ * Clock
+ * ============================================================================ */
+
+extern uint64_t bench_now_ns(void);
+
+/* ============================================================================
+ * World
+ * ============================================================================ */
+
+/* Start the cels runtime headless, import Widgets, return the world */
+extern ecs_world_t* bench_world_open(void);
+
+/* Delete every entity spawned since the last reset */
+extern void bench_world_reset(ecs_world_t* world);
+
+/* Entity with ClayUI routed through the timing trampoline. type is a
+ * caller-chosen index into bench_layout_stats (< BENCH_LAYOUT_TYPES). */
+#define BENCH_LAYOUT_TYPES 64
+extern ecs_entity_t bench_spawn(ecs_world_t* world, ecs_entity_t parent,
+                                bench_layout_fn layout, int type);
+
+/* Set a component by id (ecs_set_id shorthand) */
+#define bench_set(world, e, T, ...) \
+    do { T _v = (T){ __VA_ARGS__ }; \
+         ecs_set_id((world), (e), T##_id, sizeof(T), &_v); } while (0)
+
+/* Route composed entities through the timing trampoline. type_of maps a
+ * layout function to its bench_layout_stats index (-1 = leave untimed).
+ * Returns the number of timed entities, ones routed earlier included. */
+extern int bench_instrument(ecs_world_t* world, int (*type_of)(bench_layout_fn layout));
+
+/* Full-size column laying out its children; root of composed dashboards */
+extern void bench_column_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* ============================================================================
+ * Frames
+ * ============================================================================ */
+
+typedef struct BenchFrame {
+    uint64_t focus_ns;
+    uint64_t behavioral_ns;
+    uint64_t layout_ns;
+    uint64_t clay_ns;
+    uint64_t total_ns;
+    int layout_calls;
+    long long clay_elements;        /* -1 = not counted on this toolchain */
+    long long clay_text_elements;
+} BenchFrame;
+
+/* Per-type layout totals since the last bench_stats_reset() */
+typedef struct BenchLayoutStat {
+    const char* name;
+    uint64_t ns;                    /* Exclusive */
+    long long calls;
+    long long clay_elements;
+} BenchLayoutStat;
+
+extern BenchLayoutStat bench_layout_stats[BENCH_LAYOUT_TYPES];
+extern void bench_stats_reset(void);
+
+/* Scripted input for frame i (Tab, arrows, Enter, PageDown in rotation) */
+extern void bench_input_script(int frame, CELS_Input* out);
+
+/* Run one frame with the given input and fill out */
+extern void bench_frame(ecs_world_t* world, const CELS_Input* input, float dt,
+                        BenchFrame* out);
+
+/* Peak resident set size in KiB */
+extern long bench_peak_rss_kb(void);
+
+/* ============================================================================
+ * JSON
+ * ============================================================================ */
+
+/* Minimal streaming writer: comma placement is tracked per nesting level */
+typedef struct BenchJson {
+    FILE* out;
+    int depth;
+    bool first[16];
+} BenchJson;
+
+extern void bench_json_begin(BenchJson* j, FILE* out);
+extern void bench_json_end(BenchJson* j);
+extern void bench_json_object(BenchJson* j, const char* key);   /* key NULL in arrays */
+extern void bench_json_array(BenchJson* j, const char* key);
+extern void bench_json_close(BenchJson* j, char bracket);        /* '}' or ']' */
+extern void bench_json_num(BenchJson* j, const char* key, double value);
+extern void bench_json_int(BenchJson* j, const char* key, long long value);
+extern void bench_json_str(BenchJson* j, const char* key, const char* value);
+
+#endif /* CELS_WIDGETS_BENCH_HARNESS_H */
@@ -29,13 +29,20 @@
  *
  * Each composition:
  *   1. Attaches ClayUI with the widget's layout function
- *   2. Attaches the widget's data component with props
+ *   2. Attaches the widget's data component with props (W_HAS writes
+ *      only when the props changed since the last frame -- see diff.h)
  *   3. Interactive widgets also set W_InteractState for style resolution
  *   4. Container widgets (Panel, ListView) render CEL_Clay_Children()
  *      so child compositions appear inside their layout
  *
+ * Scroll offsets, cursors and expansion live in the entity's W_UiState,
+ * not in composed components. The .scroll_offset and .collapsed props seed
+ * it and are re-applied only when their value changes.
+ *
  * All widgets accept an optional `.style` pointer for visual overrides.
  * Interactive widgets also accept `.disabled` for W_InteractState.
+ * Static display widgets and Panel accept `.memo` to skip their body
+ * while props are unchanged (see diff.h).
  * New props zero-initialize: existing code is unaffected.
  *
  * Requires: #include <cels-widgets/widgets.h> before this header
@@ -49,6 +56,7 @@
 #include <cels-widgets/input.h>
 #include <cels-widgets/layouts.h>
 #include <cels-widgets/presets.h>
+#include <cels-widgets/diff.h>
 #include <cels-layout/layout.h>
 #include <cels-clay/clay_layout.h>
 
@@ -56,45 +64,50 @@
  * Text & Display Compositions
  * ============================================================================ */
 
-CEL_Composition(WText, const char* text; int align; const Widget_TextStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_text_layout);
-    cel_has(W_Text, .text = props.text, .align = props.align, .style = props.style);
+CEL_Composition(WText, const char* text; int align; bool memo; const Widget_TextStyle* style;) {
+    W_MEMO(props, text, align, style);
+    W_HAS(ClayUI, .layout_fn = w_text_layout);
+    W_HAS(W_Text, .text = props.text, .align = props.align, .style = props.style);
 }
 #define Widget_Text(...) cel_init(WText, __VA_ARGS__)
 
-CEL_Composition(WHint, const char* text; const Widget_HintStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_hint_layout);
-    cel_has(W_Hint, .text = props.text, .style = props.style);
+CEL_Composition(WHint, const char* text; bool memo; const Widget_HintStyle* style;) {
+    W_MEMO(props, text, style);
+    W_HAS(ClayUI, .layout_fn = w_hint_layout);
+    W_HAS(W_Hint, .text = props.text, .style = props.style);
 }
 #define Widget_Hint(...) cel_init(WHint, __VA_ARGS__)
 
-CEL_Composition(WCanvas, const char* title; int width; const Widget_CanvasStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_canvas_layout);
-    cel_has(W_Canvas, .title = props.title, .width = props.width, .style = props.style);
+CEL_Composition(WCanvas, const char* title; int width; bool memo; const Widget_CanvasStyle* style;) {
+    W_MEMO(props, title, width, style);
+    W_HAS(ClayUI, .layout_fn = w_canvas_layout);
+    W_HAS(W_Canvas, .title = props.title, .width = props.width, .style = props.style);
 }
 #define Widget_Canvas(...) cel_init(WCanvas, __VA_ARGS__)
 
-CEL_Composition(WInfoBox, const char* title; const char* content; bool border; const Widget_InfoBoxStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_info_box_layout);
-    cel_has(W_InfoBox, .title = props.title, .content = props.content,
-            .border = props.border, .style = props.style);
+CEL_Composition(WInfoBox, const char* title; const char* content; bool border; bool memo; const Widget_InfoBoxStyle* style;) {
+    W_MEMO(props, title, content, border, style);
+    W_HAS(ClayUI, .layout_fn = w_info_box_layout);
+    W_HAS(W_InfoBox, .title = props.title, .content = props.content,
+          .border = props.border, .style = props.style);
 }
 #define Widget_InfoBox(...) cel_init(WInfoBox, __VA_ARGS__)
 
-CEL_Composition(WBadge, const char* text; unsigned char r; unsigned char g; unsigned char b; const Widget_BadgeStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_badge_layout);
-    cel_has(W_Badge, .text = props.text, .r = props.r, .g = props.g, .b = props.b,
-            .style = props.style);
+CEL_Composition(WBadge, const char* text; unsigned char r; unsigned char g; unsigned char b; bool memo; const Widget_BadgeStyle* style;) {
+    W_MEMO(props, text, r, g, b, style);
+    W_HAS(ClayUI, .layout_fn = w_badge_layout);
+    W_HAS(W_Badge, .text = props.text, .r = props.r, .g = props.g, .b = props.b,
+          .style = props.style);
 }
 #define Widget_Badge(...) cel_init(WBadge, __VA_ARGS__)
 
 CEL_Composition(WTextArea, const char* text; int max_width; int max_height; bool scrollable; const Widget_TextAreaStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_text_area_layout);
-    cel_has(W_TextArea, .text = props.text, .max_width = props.max_width,
-            .max_height = props.max_height, .scrollable = props.scrollable,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_text_area_layout);
+    W_HAS(W_TextArea, .text = props.text, .max_width = props.max_width,
+          .max_height = props.max_height, .scrollable = props.scrollable,
+          .style = props.style);
     /* W_Scrollable: scroll state for content overflow, populated by layout */
-    cel_has(W_Scrollable, .scroll_offset = 0, .total_count = 0, .visible_count = 0);
+    W_HAS(W_Scrollable, .total_count = 0, .visible_count = 0);
 }
 #define Widget_TextArea(...) cel_init(WTextArea, __VA_ARGS__)
 
@@ -107,41 +120,45 @@ CEL_Composition(WTextArea, const char* text; int max_width; int max_height; bool
  * ============================================================================ */
 
 CEL_Composition(WButton, const char* label; bool selected; bool focused; bool disabled;
-                 void (*on_press)(void); const Widget_ButtonStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_button_layout);
-    cel_has(W_Button, .label = props.label, .on_press = props.on_press, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected,
-            .focused = props.focused, .disabled = props.disabled);
+                 void (*on_press)(void); uint64_t key; const Widget_ButtonStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_button_layout);
+    W_HAS(W_Button, .label = props.label, .on_press = props.on_press, .style = props.style);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected,
+          .focused = props.focused, .disabled = props.disabled);
+    if (props.key) {
+        W_HAS(W_Key, .key = props.key);
+        cel_has(W_KeyBinding); /* Zero-init; the reconciler binds the key */
+    }
 }
 #define Widget_Button(...) cel_init(WButton, __VA_ARGS__)
 
 CEL_Composition(WSlider, const char* label; float value; float min; float max;
                  bool selected; bool disabled; const Widget_SliderStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_slider_layout);
-    cel_has(W_Slider, .label = props.label, .style = props.style);
-    cel_has(W_RangeValueF, .value = props.value, .min = props.min,
-            .max = props.max, .step = 0.1f);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+    W_HAS(ClayUI, .layout_fn = w_slider_layout);
+    W_HAS(W_Slider, .label = props.label, .style = props.style);
+    W_HAS(W_RangeValueF, .value = props.value, .min = props.min,
+          .max = props.max, .step = 0.1f);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .disabled = props.disabled);
 }
 #define Widget_Slider(...) cel_init(WSlider, __VA_ARGS__)
 
 CEL_Composition(WToggle, const char* label; bool value; bool selected; bool disabled;
                  const Widget_ToggleStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_toggle_layout);
-    cel_has(W_Toggle, .label = props.label, .value = props.value, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+    W_HAS(ClayUI, .layout_fn = w_toggle_layout);
+    W_HAS(W_Toggle, .label = props.label, .value = props.value, .style = props.style);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .disabled = props.disabled);
 }
 #define Widget_Toggle(...) cel_init(WToggle, __VA_ARGS__)
 
 CEL_Composition(WCycle, const char* label; const char* value; bool selected; bool disabled;
                  const Widget_CycleStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_cycle_layout);
-    cel_has(W_Cycle, .label = props.label, .value = props.value, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+    W_HAS(ClayUI, .layout_fn = w_cycle_layout);
+    W_HAS(W_Cycle, .label = props.label, .value = props.value, .style = props.style);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .disabled = props.disabled);
 }
 #define Widget_Cycle(...) cel_init(WCycle, __VA_ARGS__)
 
@@ -151,19 +168,20 @@ CEL_Composition(WCycle, const char* label; const char* value; bool selected; boo
 
 CEL_Composition(WProgressBar, const char* label; float value; bool color_by_value;
                  const Widget_ProgressBarStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_progress_bar_layout);
-    cel_has(W_ProgressBar, .label = props.label,
-            .color_by_value = props.color_by_value, .style = props.style);
-    cel_has(W_RangeValueF, .value = props.value, .min = 0.0f,
-            .max = 1.0f, .step = 0.01f);
+    W_HAS(ClayUI, .layout_fn = w_progress_bar_layout);
+    W_HAS(W_ProgressBar, .label = props.label,
+          .color_by_value = props.color_by_value, .style = props.style);
+    W_HAS(W_RangeValueF, .value = props.value, .min = 0.0f,
+          .max = 1.0f, .step = 0.01f);
 }
 #define Widget_ProgressBar(...) cel_init(WProgressBar, __VA_ARGS__)
 
-CEL_Composition(WMetric, const char* label; const char* value; int status;
+CEL_Composition(WMetric, const char* label; const char* value; int status; bool memo;
                  const Widget_MetricStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_metric_layout);
-    cel_has(W_Metric, .label = props.label, .value = props.value,
-            .status = props.status, .style = props.style);
+    W_MEMO(props, label, value, status, style);
+    W_HAS(ClayUI, .layout_fn = w_metric_layout);
+    W_HAS(W_Metric, .label = props.label, .value = props.value,
+          .status = props.status, .style = props.style);
 }
 #define Widget_Metric(...) cel_init(WMetric, __VA_ARGS__)
 
@@ -171,32 +189,48 @@ CEL_Composition(WMetric, const char* label; const char* value; int status;
  * Container Compositions
  * ============================================================================ */
 
-CEL_Composition(WPanel, const char* title; int border_style; const Widget_PanelStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_panel_layout);
-    cel_has(W_Panel, .title = props.title, .border_style = props.border_style, .style = props.style);
+CEL_Composition(WPanel, const char* title; int border_style; bool memo; const Widget_PanelStyle* style;) {
+    W_MEMO(props, title, border_style, style);
+    W_HAS(ClayUI, .layout_fn = w_panel_layout);
+    W_HAS(W_Panel, .title = props.title, .border_style = props.border_style, .style = props.style);
 }
 #define Widget_Panel(...) cel_init(WPanel, __VA_ARGS__)
 
-CEL_Composition(WDivider, bool vertical; const Widget_DividerStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_divider_layout);
-    cel_has(W_Divider, .vertical = props.vertical, .style = props.style);
+CEL_Composition(WDivider, bool vertical; bool memo; const Widget_DividerStyle* style;) {
+    W_MEMO(props, vertical, style);
+    W_HAS(ClayUI, .layout_fn = w_divider_layout);
+    W_HAS(W_Divider, .vertical = props.vertical, .style = props.style);
 }
 #define Widget_Divider(...) cel_init(WDivider, __VA_ARGS__)
 
 CEL_Composition(WTable, int row_count; const char** keys; const char** values;
+                 W_TableRowFn get_row; void* user_data;
+                 const char* key_header; const char* value_header;
+                 int visible_height; int scroll_offset;
                  const Widget_TableStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_table_layout);
-    cel_has(W_Table, .row_count = props.row_count, .keys = props.keys,
-            .values = props.values, .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_table_layout);
+    W_HAS(W_Table, .row_count = props.row_count, .keys = props.keys,
+          .values = props.values, .get_row = props.get_row,
+          .user_data = props.user_data,
+          .key_header = props.key_header, .value_header = props.value_header,
+          .visible_height = props.visible_height, .style = props.style);
+    /* visible_count excludes the header row; layout refreshes it each frame */
+    W_HAS(W_Scrollable, .total_count = props.row_count,
+          .visible_count = props.visible_height > 0
+              ? props.visible_height - ((props.key_header || props.value_header) ? 1 : 0)
+              : props.row_count);
+    w_ui_scroll_prop(props.scroll_offset);
+    cel_has(W_TableState); /* Zero-init; layout inits once */
 }
 #define Widget_Table(...) cel_init(WTable, __VA_ARGS__)
 
 CEL_Composition(WCollapsible, const char* title; bool collapsed; int indent;
                  bool selected; const Widget_CollapsibleStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_collapsible_layout);
-    cel_has(W_Collapsible, .title = props.title, .collapsed = props.collapsed,
-            .indent = props.indent, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
+    W_HAS(ClayUI, .layout_fn = w_collapsible_layout);
+    W_HAS(W_Collapsible, .title = props.title,
+          .indent = props.indent, .style = props.style);
+    w_ui_expanded_prop(!props.collapsed); /* Enter/Space toggles from here */
+    W_HAS(W_Selectable, .selected = props.selected);
     cel_has(W_InteractState);
     cel_has(W_Focusable);
 }
@@ -204,41 +238,48 @@ CEL_Composition(WCollapsible, const char* title; bool collapsed; int indent;
 
 CEL_Composition(WSplitPane, float ratio; int direction;
                  const Widget_SplitStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_split_pane_layout);
-    cel_has(W_SplitPane, .ratio = props.ratio, .direction = props.direction,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_split_pane_layout);
+    W_HAS(W_SplitPane, .ratio = props.ratio, .direction = props.direction,
+          .style = props.style);
 }
 #define Widget_Split(...) cel_init(WSplitPane, __VA_ARGS__)
 
 CEL_Composition(WScrollContainer, int height; int total_count; int scroll_offset;
                  const Widget_ScrollableStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_scrollable_layout);
-    cel_has(W_ScrollContainer, .height = props.height, .style = props.style);
-    cel_has(W_Scrollable, .scroll_offset = props.scroll_offset,
-            .total_count = props.total_count,
-            .visible_count = props.height);
+    W_HAS(ClayUI, .layout_fn = w_scrollable_layout);
+    W_HAS(W_ScrollContainer, .height = props.height, .style = props.style);
+    W_HAS(W_Scrollable, .total_count = props.total_count,
+          .visible_count = props.height);
+    w_ui_scroll_prop(props.scroll_offset);
 }
 #define Widget_Scrollable(...) cel_init(WScrollContainer, __VA_ARGS__)
 
+CEL_Composition(WThemeScope, const Widget_Theme* theme;) {
+    W_HAS(ClayUI, .layout_fn = w_theme_scope_layout);
+    W_HAS(W_ThemeScope, .theme = props.theme);
+    cel_has(W_ThemeScopeState); /* Zero-init; layout fills the cache */
+}
+#define Widget_ThemeScope(...) cel_init(WThemeScope, __VA_ARGS__)
+
 /* ============================================================================
  * Radio Compositions
  * ============================================================================ */
 
 CEL_Composition(WRadioButton, const char* label; bool selected; int group_id; bool disabled;
                  const Widget_RadioButtonStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_radio_button_layout);
-    cel_has(W_RadioButton, .label = props.label, .group_id = props.group_id, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+    W_HAS(ClayUI, .layout_fn = w_radio_button_layout);
+    W_HAS(W_RadioButton, .label = props.label, .group_id = props.group_id, .style = props.style);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .disabled = props.disabled);
 }
 #define Widget_RadioButton(...) cel_init(WRadioButton, __VA_ARGS__)
 
 CEL_Composition(WRadioGroup, int group_id; int selected_index; int count;
                  const Widget_RadioGroupStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_radio_group_layout);
-    cel_has(W_RadioGroup, .group_id = props.group_id,
-            .selected_index = props.selected_index, .count = props.count,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_radio_group_layout);
+    W_HAS(W_RadioGroup, .group_id = props.group_id,
+          .selected_index = props.selected_index, .count = props.count,
+          .style = props.style);
 }
 #define Widget_RadioGroup(...) cel_init(WRadioGroup, __VA_ARGS__)
 
@@ -248,23 +289,42 @@ CEL_Composition(WRadioGroup, int group_id; int selected_index; int count;
 
 CEL_Composition(WTabBar, int active; int count; const char** labels;
                  const Widget_TabBarStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_tab_bar_layout);
-    cel_has(W_TabBar, .active = props.active, .count = props.count,
-            .labels = props.labels, .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_tab_bar_layout);
+    W_HAS(W_TabBar, .active = props.active, .count = props.count,
+          .labels = props.labels, .style = props.style);
+    cel_has(W_TabBarState); /* Zero-init; layout scrolls and measures */
 }
 #define Widget_TabBar(...) cel_init(WTabBar, __VA_ARGS__)
 
 CEL_Composition(WTabContent, const char* text; const char* hint;
                  const Widget_TabContentStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_tab_content_layout);
-    cel_has(W_TabContent, .text = props.text, .hint = props.hint, .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_tab_content_layout);
+    W_HAS(W_TabContent, .text = props.text, .hint = props.hint, .style = props.style);
 }
 #define Widget_TabContent(...) cel_init(WTabContent, __VA_ARGS__)
 
-CEL_Composition(WStatusBar, const char* left; const char* right;
+CEL_Composition(WTabView, int active; int count; const char** labels; W_TabCache* cache;
+                 const Widget_TabBarStyle* style;) {
+    /* Runs before the children, so Widget_tab_cache_live() sees this frame's tab */
+    if (props.cache) { Widget_tab_cache_touch(props.cache, props.active); }
+    W_HAS(ClayUI, .layout_fn = w_tab_view_layout);
+    W_HAS(W_TabView, .active = props.active, .count = props.count,
+          .labels = props.labels, .cache = props.cache, .style = props.style);
+    cel_has(W_TabBarState); /* Zero-init; layout scrolls and measures */
+}
+#define Widget_TabView(...) cel_init(WTabView, __VA_ARGS__)
+
+CEL_Composition(WTabPage, int index;) {
+    W_HAS(ClayUI, .layout_fn = w_tab_page_layout);
+    W_HAS(W_TabPage, .index = props.index);
+}
+#define Widget_TabPage(...) cel_init(WTabPage, __VA_ARGS__)
+
+CEL_Composition(WStatusBar, const char* left; const char* right; bool memo;
                  const Widget_StatusBarStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_status_bar_layout);
-    cel_has(W_StatusBar, .left = props.left, .right = props.right, .style = props.style);
+    W_MEMO(props, left, right, style);
+    W_HAS(ClayUI, .layout_fn = w_status_bar_layout);
+    W_HAS(W_StatusBar, .left = props.left, .right = props.right, .style = props.style);
 }
 #define Widget_StatusBar(...) cel_init(WStatusBar, __VA_ARGS__)
 
@@ -273,22 +333,36 @@ CEL_Composition(WStatusBar, const char* left; const char* right;
  * ============================================================================ */
 
 CEL_Composition(WListView, int item_count; int selected_index; int scroll_offset;
-                 int visible_count; const Widget_ListViewStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_list_view_layout);
-    cel_has(W_ListView, .item_count = props.item_count,
-            .selected_index = props.selected_index, .style = props.style);
-    cel_has(W_Scrollable, .scroll_offset = props.scroll_offset,
-            .total_count = props.item_count,
-            .visible_count = props.visible_count);
+                 int visible_count; const W_FuzzyIndex* fuzzy;
+                 W_Selection* selection; bool selected; bool focused;
+                 const Widget_ListViewStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_list_view_layout);
+    W_HAS(W_ListView, .item_count = props.item_count,
+          .selected_index = props.selected_index, .fuzzy = props.fuzzy,
+          .selection = props.selection,
+          .style = props.style);
+    W_HAS(W_Scrollable, .total_count = props.item_count,
+          .visible_count = props.visible_count);
+    w_ui_scroll_prop(props.scroll_offset);
+    if (props.selection) {
+        cel_has(W_SelectionState);
+        /* Selection keys reach the list only while selected or focused */
+        W_HAS(W_Selectable, .selected = props.selected);
+        W_HAS(W_InteractState, .selected = props.selected, .focused = props.focused);
+    }
 }
 #define Widget_ListView(...) cel_init(WListView, __VA_ARGS__)
 
 CEL_Composition(WListItem, const char* label; bool selected; void* data; bool disabled;
-                 const Widget_ListItemStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_list_item_layout);
-    cel_has(W_ListItem, .label = props.label, .data = props.data, .style = props.style);
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+                 uint64_t key; const Widget_ListItemStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_list_item_layout);
+    W_HAS(W_ListItem, .label = props.label, .data = props.data, .style = props.style);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .disabled = props.disabled);
+    if (props.key) {
+        W_HAS(W_Key, .key = props.key);
+        cel_has(W_KeyBinding); /* Zero-init; the reconciler binds the key */
+    }
 }
 #define Widget_ListItem(...) cel_init(WListItem, __VA_ARGS__)
 
@@ -301,16 +375,16 @@ CEL_Composition(WTextInput, const char* placeholder; bool password;
                  void (*on_change)(const char* text);
                  void (*on_submit)(const char* text);
                  const Widget_TextInputStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_text_input_layout);
-    cel_has(W_TextInput, .placeholder = props.placeholder,
-            .password = props.password,
-            .max_length = props.max_length,
-            .on_change = props.on_change, .on_submit = props.on_submit,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_text_input_layout);
+    W_HAS(W_TextInput, .placeholder = props.placeholder,
+          .password = props.password,
+          .max_length = props.max_length,
+          .on_change = props.on_change, .on_submit = props.on_submit,
+          .style = props.style);
     cel_has(W_TextInputBuffer); /* Zero-init; behavioral system inits once */
-    cel_has(W_Selectable, .selected = props.selected);
-    cel_has(W_InteractState, .selected = props.selected,
-            .disabled = props.disabled);
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected,
+          .disabled = props.disabled);
     cel_has(W_Focusable);
 }
 #define Widget_TextInput(...) cel_init(WTextInput, __VA_ARGS__)
@@ -322,8 +396,8 @@ CEL_Composition(WTextInput, const char* placeholder; bool password;
 CEL_Composition(WNavigationGroup,
     bool wrap; int direction; /* 0=vertical, 1=horizontal */
 ) {
-    cel_has(ClayUI, .layout_fn = w_navigation_group_layout);
-    cel_has(W_NavigationScope, .wrap = props.wrap, .direction = props.direction);
+    W_HAS(ClayUI, .layout_fn = w_navigation_group_layout);
+    W_HAS(W_NavigationScope, .wrap = props.wrap, .direction = props.direction);
     cel_has(W_Focusable);
 }
 #define Widget_NavigationGroup(...) cel_init(WNavigationGroup, __VA_ARGS__)
@@ -334,61 +408,79 @@ CEL_Composition(WNavigationGroup,
 
 CEL_Composition(WPopup, const char* title; bool visible; bool backdrop; int width; int height;
                  const Widget_PopupStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_popup_layout);
-    cel_has(W_Popup, .title = props.title, .visible = props.visible,
-            .backdrop = props.backdrop,
-            .width = props.width > 0 ? props.width : 40,
-            .height = props.height, .style = props.style);
-    cel_has(W_OverlayState, .visible = props.visible,
-            .z_index = 100, .modal = false);
+    W_HAS(ClayUI, .layout_fn = w_popup_layout);
+    W_HAS(W_Popup, .title = props.title, .visible = props.visible,
+          .backdrop = props.backdrop,
+          .width = props.width > 0 ? props.width : 40,
+          .height = props.height, .style = props.style);
+    W_HAS(W_OverlayState, .visible = props.visible,
+          .z_index = 100, .modal = false);
 }
 #define Widget_Popup(...) cel_init(WPopup, __VA_ARGS__)
 
 CEL_Composition(WModal, const char* title; bool visible; int width; int height;
                  void (*on_dismiss)(void); const Widget_ModalStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_modal_layout);
-    cel_has(W_Modal, .title = props.title, .visible = props.visible,
-            .width = props.width > 0 ? props.width : 50,
-            .height = props.height,
-            .on_dismiss = props.on_dismiss, .style = props.style);
-    cel_has(W_OverlayState, .visible = props.visible,
-            .z_index = 200, .modal = true);
-    cel_has(W_NavigationScope, .wrap = true, .direction = 0);
+    W_HAS(ClayUI, .layout_fn = w_modal_layout);
+    W_HAS(W_Modal, .title = props.title, .visible = props.visible,
+          .width = props.width > 0 ? props.width : 50,
+          .height = props.height,
+          .on_dismiss = props.on_dismiss, .style = props.style);
+    W_HAS(W_OverlayState, .visible = props.visible,
+          .z_index = 200, .modal = true);
+    W_HAS(W_NavigationScope, .wrap = true, .direction = 0);
     cel_has(W_Focusable);
 }
 #define Widget_Modal(...) cel_init(WModal, __VA_ARGS__)
 
 CEL_Composition(WWindow, const char* title; bool visible; int x; int y;
                  int width; int height; int z_order; bool draggable;
-                 void (*on_close)(void); const Widget_WindowStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_window_layout);
-    cel_has(W_Window, .title = props.title, .visible = props.visible,
-            .x = props.x, .y = props.y,
-            .width = props.width > 0 ? props.width : 40,
-            .height = props.height,
-            .z_order = props.z_order,
-            .on_close = props.on_close, .style = props.style);
-    cel_has(W_OverlayState, .visible = props.visible,
-            .z_index = 150 + props.z_order, .modal = true);
-    cel_has(W_NavigationScope, .wrap = true, .direction = 0);
+                 void (*on_close)(void); const Widget_WindowStyle* style;
+                 W_TileTree* tile;) {
+    W_HAS(ClayUI, .layout_fn = w_window_layout);
+    W_HAS(W_Window, .title = props.title, .visible = props.visible,
+          .x = props.x, .y = props.y,
+          .width = props.width > 0 ? props.width : 40,
+          .height = props.height,
+          .z_order = props.z_order,
+          .on_close = props.on_close, .style = props.style);
+    W_HAS(W_OverlayState, .visible = props.visible,
+          .z_index = 150 + props.z_order, .modal = true);
+    W_HAS(W_NavigationScope, .wrap = true, .direction = 0);
     cel_has(W_Focusable);
     if (props.draggable) { cel_has(W_Draggable); }
+    if (props.tile) { W_HAS(W_Tiled, .tree = props.tile); }
 }
 #define Widget_Window(...) cel_init(WWindow, __VA_ARGS__)
 
 CEL_Composition(WToast, const char* message; float duration; int severity; int position;
                  const Widget_ToastStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_toast_layout);
-    cel_has(W_Toast, .message = props.message,
-            .duration = props.duration > 0 ? props.duration : 3.0f,
-            .elapsed = 0, .severity = props.severity,
-            .position = props.position, .dismissed = false,
-            .style = props.style);
-    cel_has(W_OverlayState, .visible = true,
-            .z_index = 300, .modal = false);
+    W_HAS(ClayUI, .layout_fn = w_toast_layout);
+    W_HAS(W_Toast, .message = props.message,
+          .duration = props.duration > 0 ? props.duration : 3.0f,
+          .elapsed = 0, .severity = props.severity,
+          .position = props.position, .dismissed = false,
+          .style = props.style);
+    W_HAS(W_OverlayState, .visible = true,
+          .z_index = 300, .modal = false);
 }
 #define Widget_Toast(...) cel_init(WToast, __VA_ARGS__)
 
+CEL_Composition(WToastStack, W_ToastManager* manager; const Widget_ToastStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_toast_stack_layout);
+    W_HAS(W_ToastStack, .manager = props.manager, .style = props.style);
+    W_HAS(W_OverlayState, .visible = true,
+          .z_index = 300, .modal = false);
+}
+#define Widget_ToastStack(...) cel_init(WToastStack, __VA_ARGS__)
+
+CEL_Composition(WPerfOverlay, int toggle_key; bool start_visible; int position;) {
+    W_HAS(ClayUI, .layout_fn = w_perf_overlay_layout);
+    W_HAS(W_PerfOverlay, .toggle_key = props.toggle_key,
+          .start_visible = props.start_visible, .position = props.position);
+    cel_has(W_PerfOverlayState); /* Zero-init; W_PerfOverlaySample fills it */
+}
+#define Widget_PerfOverlay(...) cel_init(WPerfOverlay, __VA_ARGS__)
+
 /* ============================================================================
  * Data Visualization Compositions
  * ============================================================================ */
@@ -396,21 +488,21 @@ CEL_Composition(WToast, const char* message; float duration; int severity; int p
 CEL_Composition(WSpark, const float* values; int count;
                  float min; float max; bool has_min; bool has_max;
                  const Widget_SparkStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_spark_layout);
-    cel_has(W_Spark, .values = props.values, .count = props.count,
-            .min = props.min, .max = props.max,
-            .has_min = props.has_min, .has_max = props.has_max,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_spark_layout);
+    W_HAS(W_Spark, .values = props.values, .count = props.count,
+          .min = props.min, .max = props.max,
+          .has_min = props.has_min, .has_max = props.has_max,
+          .style = props.style);
 }
 #define Widget_Spark(...) cel_init(WSpark, __VA_ARGS__)
 
 CEL_Composition(WBarChart, const W_BarChartEntry* entries; int count;
                  float max_value; bool gradient;
                  const Widget_BarChartStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_bar_chart_layout);
-    cel_has(W_BarChart, .entries = props.entries, .count = props.count,
-            .max_value = props.max_value, .gradient = props.gradient,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_bar_chart_layout);
+    W_HAS(W_BarChart, .entries = props.entries, .count = props.count,
+          .max_value = props.max_value, .gradient = props.gradient,
+          .style = props.style);
 }
 #define Widget_BarChart(...) cel_init(WBarChart, __VA_ARGS__)
 
@@ -421,33 +513,126 @@ CEL_Composition(WBarChart, const W_BarChartEntry* entries; int count;
 CEL_Composition(WLogViewer, const W_LogEntry* entries; int entry_count;
                  int visible_height; int severity_filter; int scroll_offset;
                  const Widget_LogViewerStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_log_viewer_layout);
+    W_HAS(ClayUI, .layout_fn = w_log_viewer_layout);
     /* visible_height: >0 = FIXED, <0 = GROW (fill parent), 0 = default (10) */
-    cel_has(W_LogViewer, .entries = props.entries,
-            .entry_count = props.entry_count,
-            .visible_height = props.visible_height != 0 ? props.visible_height : 10,
-            .severity_filter = props.severity_filter > 0 ? props.severity_filter : 0xF,
-            .style = props.style);
-    cel_has(W_Scrollable, .scroll_offset = props.scroll_offset,
-            .total_count = props.entry_count,
-            .visible_count = props.visible_height > 0 ? (props.visible_height - 2) :
-                             props.visible_height < 0 ? props.entry_count :
-                             8 /* default: 10 - 2 */);
+    W_HAS(W_LogViewer, .entries = props.entries,
+          .entry_count = props.entry_count,
+          .visible_height = props.visible_height != 0 ? props.visible_height : 10,
+          .severity_filter = props.severity_filter > 0 ? props.severity_filter : 0xF,
+          .style = props.style);
+    W_HAS(W_Scrollable, .total_count = props.entry_count,
+          .visible_count = props.visible_height > 0 ? (props.visible_height - 2) :
+                           props.visible_height < 0 ? props.entry_count :
+                           8 /* default: 10 - 2 */);
+    w_ui_scroll_prop(props.scroll_offset);
     cel_has(W_LogViewerState); /* Zero-init; layout inits once */
 }
 #define Widget_LogViewer(...) cel_init(WLogViewer, __VA_ARGS__)
 
+/* ============================================================================
+ * Command Palette Composition
+ * ============================================================================ */
+
+CEL_Composition(WCommandPalette, bool visible; int width; int max_results;
+                 const char* placeholder; void (*on_dismiss)(void);
+                 const Widget_CommandPaletteStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_command_palette_layout);
+    W_HAS(W_CommandPalette, .visible = props.visible,
+          .width = props.width > 0 ? props.width : 60,
+          .max_results = props.max_results > 0 ? props.max_results : 12,
+          .placeholder = props.placeholder ? props.placeholder : "Type a command...",
+          .on_dismiss = props.on_dismiss, .style = props.style);
+    W_HAS(W_OverlayState, .visible = props.visible,
+          .z_index = 300, .modal = true);
+    cel_has(W_CommandPaletteState); /* Zero-init; focus system resets on open */
+}
+#define Widget_CommandPalette(...) cel_init(WCommandPalette, __VA_ARGS__)
+
+/* ============================================================================
+ * Data Grid Composition
+ * ============================================================================ */
+
+CEL_Composition(WDataGrid, const W_DataGridColumn* columns; int column_count;
+                 int row_count; W_DataGridIndex* index; int frozen_columns;
+                 int visible_height; int visible_width; int selected_row;
+                 int scroll_offset; W_Selection* selection;
+                 bool selected; bool focused;
+                 const Widget_DataGridStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_datagrid_layout);
+    /* frozen_columns: 0 = default (1 key column), <0 = none */
+    W_HAS(W_DataGrid, .columns = props.columns,
+          .column_count = props.column_count,
+          .row_count = props.row_count,
+          .index = props.index,
+          .frozen_columns = props.frozen_columns > 0 ? props.frozen_columns :
+                            props.frozen_columns < 0 ? 0 : 1,
+          .visible_height = props.visible_height > 0 ? props.visible_height : 12,
+          .visible_width = props.visible_width > 0 ? props.visible_width : 80,
+          .selected_row = props.selected_row,
+          .selection = props.selection,
+          .style = props.style);
+    W_HAS(W_Scrollable, .total_count = props.row_count,
+          .visible_count = (props.visible_height > 0 ? props.visible_height : 12) - 1);
+    w_ui_scroll_prop(props.scroll_offset);
+    cel_has(W_DataGridState); /* Zero-init; focus system moves col_offset */
+    if (props.selection) { cel_has(W_SelectionState); }
+    /* Keys reach the grid only while selected or focused */
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .focused = props.focused);
+}
+#define Widget_DataGrid(...) cel_init(WDataGrid, __VA_ARGS__)
+
+/* ============================================================================
+ * Tree View Composition
+ * ============================================================================ */
+
+CEL_Composition(WTreeView, W_TreeModel* model; int visible_height;
+                 void (*on_activate)(uint64_t id);
+                 bool selected; bool focused;
+                 const Widget_TreeViewStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_tree_view_layout);
+    W_HAS(W_TreeView, .model = props.model,
+          .visible_height = props.visible_height > 0 ? props.visible_height : 12,
+          .on_activate = props.on_activate,
+          .style = props.style);
+    cel_has(W_Scrollable); /* Zero-init; layout and focus keep the extent */
+    /* Keys reach the tree only while selected or focused */
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .focused = props.focused);
+}
+#define Widget_TreeView(...) cel_init(WTreeView, __VA_ARGS__)
+
+/* ============================================================================
+ * File Browser Composition
+ * ============================================================================ */
+
+CEL_Composition(WFileBrowser, W_DirListing* listing; int visible_height;
+                 void (*on_open)(const char* path);
+                 bool selected; bool focused;
+                 const Widget_FileBrowserStyle* style;) {
+    W_HAS(ClayUI, .layout_fn = w_file_browser_layout);
+    W_HAS(W_FileBrowser, .listing = props.listing,
+          .visible_height = props.visible_height > 0 ? props.visible_height : 16,
+          .on_open = props.on_open,
+          .style = props.style);
+    cel_has(W_Scrollable); /* Zero-init; layout and focus keep the extent */
+    /* Keys reach the browser only while selected or focused */
+    W_HAS(W_Selectable, .selected = props.selected);
+    W_HAS(W_InteractState, .selected = props.selected, .focused = props.focused);
+}
+#define Widget_FileBrowser(...) cel_init(WFileBrowser, __VA_ARGS__)
+
 /* ============================================================================
  * Powerline Compositions
  * ============================================================================ */
 
 CEL_Composition(WPowerline, const W_PowerlineSegment* segments; int segment_count;
                  int separator_style; const Widget_PowerlineStyle* style;) {
-    cel_has(ClayUI, .layout_fn = w_powerline_layout);
-    cel_has(W_Powerline, .segments = props.segments,
-            .segment_count = props.segment_count,
-            .separator_style = props.separator_style,
-            .style = props.style);
+    W_HAS(ClayUI, .layout_fn = w_powerline_layout);
+    W_HAS(W_Powerline, .segments = props.segments,
+          .segment_count = props.segment_count,
+          .separator_style = props.separator_style,
+          .style = props.style);
 }
 #define Widget_Powerline(...) cel_init(WPowerline, __VA_ARGS__)
 
@@ -473,20 +658,29 @@ CEL_Composition(WPowerline, const W_PowerlineSegment* segments; int segment_coun
 #define WRadioGroup(...)  Widget_RadioGroup(__VA_ARGS__)
 #define WTabBar(...)      Widget_TabBar(__VA_ARGS__)
 #define WTabContent(...)  Widget_TabContent(__VA_ARGS__)
+#define WTabView(...)     Widget_TabView(__VA_ARGS__)
+#define WTabPage(...)     Widget_TabPage(__VA_ARGS__)
 #define WStatusBar(...)   Widget_StatusBar(__VA_ARGS__)
 #define WListView(...)    Widget_ListView(__VA_ARGS__)
 #define WListItem(...)    Widget_ListItem(__VA_ARGS__)
 #define WCollapsible(...) Widget_Collapsible(__VA_ARGS__)
 #define WSplitPane(...)   Widget_Split(__VA_ARGS__)
 #define WScrollContainer(...) Widget_Scrollable(__VA_ARGS__)
+#define WThemeScope(...)  Widget_ThemeScope(__VA_ARGS__)
 #define WPopup(...)       Widget_Popup(__VA_ARGS__)
 #define WModal(...)       Widget_Modal(__VA_ARGS__)
 #define WWindow(...)      Widget_Window(__VA_ARGS__)
 #define WToast(...)       Widget_Toast(__VA_ARGS__)
+#define WToastStack(...)  Widget_ToastStack(__VA_ARGS__)
+#define WPerfOverlay(...) Widget_PerfOverlay(__VA_ARGS__)
 #define WTextInput(...)   Widget_TextInput(__VA_ARGS__)
 #define WSpark(...)       Widget_Spark(__VA_ARGS__)
 #define WBarChart(...)    Widget_BarChart(__VA_ARGS__)
 #define WPowerline(...)   Widget_Powerline(__VA_ARGS__)
 #define WLogViewer(...)   Widget_LogViewer(__VA_ARGS__)
+#define WDataGrid(...)    Widget_DataGrid(__VA_ARGS__)
+#define WCommandPalette(...) Widget_CommandPalette(__VA_ARGS__)
+#define WTreeView(...)    Widget_TreeView(__VA_ARGS__)
+#define WFileBrowser(...) Widget_FileBrowser(__VA_ARGS__)
 
 #endif /* CELS_WIDGETS_COMPOSITIONS_H */
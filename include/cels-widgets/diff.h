@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Prop diffing for compositions
+ *
+ * Compositions re-run every frame, and a plain cel_has() writes the
+ * component (and bumps its change tick) even when the props are the same
+ * as last frame. W_HAS() hashes the props it is given and only writes
+ * when they differ from the props it applied last time on this entity:
+ *
+ *   CEL_Composition(WText, const char* text; ...) {
+ *       W_HAS(ClayUI, .layout_fn = w_text_layout);
+ *       W_HAS(W_Text, .text = props.text, .style = props.style);
+ *   }
+ *
+ * The diff is against the previous props, not the live component, so
+ * state a system wrote into the same component (a scroll offset, a
+ * selection made through the API) survives recomposition. When the props
+ * do change, only the fields named in the call are written; the others
+ * keep their live values. The first call on an entity attaches the
+ * component with cel_has() as before.
+ *
+ * The props image is built field by field on zeroed memory, so padding is
+ * always zero and equal props always hash equal. Pointer props compare by
+ * address, so a label buffer rewritten in place is not a change -- the
+ * component already points at it. Every argument must be a designated
+ * field (.name = value); at most W_HAS_FIELDS of them.
+ *
+ * Bare cel_has(T) calls (zero-init state components) are left as they
+ * are: their stored value is owned by systems, not props.
+ *
+ * Memoized compositions go one step further. A composition that takes a
+ * `bool memo;` prop starts its body with W_MEMO(props, field, ...): when
+ * .memo is set and the listed props hash the same as last frame, the body
+ * returns before touching any component. The fields are packed back to
+ * back before hashing, so compound-literal padding never makes a miss;
+ * list every prop the body reads. Each child composition is its own body,
+ * so a static section skips entirely when its children are memoized too:
+ *
+ *   Widget_Panel(.title = "Settings", .memo = true) {
+ *       Widget_Text(.text = "Audio", .memo = true) {}
+ *       Widget_Metric(.label = "Rate", .value = rate_str, .memo = true) {}
+ *   }
+ */
+
+#ifndef CELS_WIDGETS_DIFF_H
+#define CELS_WIDGETS_DIFF_H
+
+#include <cels/cels.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum W_PropDiff {
+    W_PROP_SAME,                /* Props equal the last applied: no write */
+    W_PROP_NEW,                 /* Component missing: attach with cel_has() */
+    W_PROP_CHANGED              /* Props changed: write the named fields */
+} W_PropDiff;
+
+/* Compare the props image with the last one W_HAS applied for this
+ * component on the composing entity and record it. On W_PROP_CHANGED
+ * *live receives the stored component. Call only from a composition. */
+extern W_PropDiff w_prop_diff(cels_entity_t component_id, const void* props, size_t size,
+                              const void** live);
+
+/* Write value to the composing entity's component */
+extern void w_prop_write(cels_entity_t component_id, const void* value, size_t size);
+
+/* _W_FIELDS(v, .a = x, .b = y) -> v.a = x; v.b = y; */
+#define W_HAS_FIELDS 16
+#define _W_CAT(a, b) _W_CAT_(a, b)
+#define _W_CAT_(a, b) a##b
+#define _W_NARG(...) _W_NARG_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define _W_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define _W_F1(v, f) v f;
+#define _W_F2(v, f, ...) v f; _W_F1(v, __VA_ARGS__)
+#define _W_F3(v, f, ...) v f; _W_F2(v, __VA_ARGS__)
+#define _W_F4(v, f, ...) v f; _W_F3(v, __VA_ARGS__)
+#define _W_F5(v, f, ...) v f; _W_F4(v, __VA_ARGS__)
+#define _W_F6(v, f, ...) v f; _W_F5(v, __VA_ARGS__)
+#define _W_F7(v, f, ...) v f; _W_F6(v, __VA_ARGS__)
+#define _W_F8(v, f, ...) v f; _W_F7(v, __VA_ARGS__)
+#define _W_F9(v, f, ...) v f; _W_F8(v, __VA_ARGS__)
+#define _W_F10(v, f, ...) v f; _W_F9(v, __VA_ARGS__)
+#define _W_F11(v, f, ...) v f; _W_F10(v, __VA_ARGS__)
+#define _W_F12(v, f, ...) v f; _W_F11(v, __VA_ARGS__)
+#define _W_F13(v, f, ...) v f; _W_F12(v, __VA_ARGS__)
+#define _W_F14(v, f, ...) v f; _W_F13(v, __VA_ARGS__)
+#define _W_F15(v, f, ...) v f; _W_F14(v, __VA_ARGS__)
+#define _W_F16(v, f, ...) v f; _W_F15(v, __VA_ARGS__)
+#define _W_FIELDS(v, ...) _W_CAT(_W_F, _W_NARG(__VA_ARGS__))(v, __VA_ARGS__)
+
+/* cel_has() that writes only when the props changed since the last call.
+ * Props are evaluated more than once, so they must be side-effect free
+ * (they are plain props.x reads in every composition). */
+#define W_HAS(T, ...) do { \
+    T _w_props; \
+    memset(&_w_props, 0, sizeof(T)); \
+    _W_FIELDS(_w_props, __VA_ARGS__) \
+    const void* _w_live = NULL; \
+    W_PropDiff _w_diff = w_prop_diff(T##_id, &_w_props, sizeof(T), &_w_live); \
+    if (_w_diff == W_PROP_NEW) { \
+        cel_has(T, __VA_ARGS__); \
+    } else if (_w_diff == W_PROP_CHANGED) { \
+        T _w_val = *(const T*)_w_live; \
+        _W_FIELDS(_w_val, __VA_ARGS__) \
+        w_prop_write(T##_id, &_w_val, sizeof(T)); \
+    } \
+} while (0)
+
+/* True when props hash the same as last frame on the composing entity.
+ * On a miss the new hash is stored (in W_Memo). */
+extern bool w_memo_hit(const void* props, size_t size);
+
+/* _W_PACK(buf, n, p, a, b) -> appends the bytes of p.a, then p.b */
+#define _W_P1(b, n, p, f) memcpy((b) + (n), &(p).f, sizeof((p).f)); (n) += sizeof((p).f);
+#define _W_P2(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P1(b, n, p, __VA_ARGS__)
+#define _W_P3(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P2(b, n, p, __VA_ARGS__)
+#define _W_P4(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P3(b, n, p, __VA_ARGS__)
+#define _W_P5(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P4(b, n, p, __VA_ARGS__)
+#define _W_P6(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P5(b, n, p, __VA_ARGS__)
+#define _W_P7(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P6(b, n, p, __VA_ARGS__)
+#define _W_P8(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P7(b, n, p, __VA_ARGS__)
+#define _W_P9(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P8(b, n, p, __VA_ARGS__)
+#define _W_P10(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P9(b, n, p, __VA_ARGS__)
+#define _W_P11(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P10(b, n, p, __VA_ARGS__)
+#define _W_P12(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P11(b, n, p, __VA_ARGS__)
+#define _W_P13(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P12(b, n, p, __VA_ARGS__)
+#define _W_P14(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P13(b, n, p, __VA_ARGS__)
+#define _W_P15(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P14(b, n, p, __VA_ARGS__)
+#define _W_P16(b, n, p, f, ...) _W_P1(b, n, p, f) _W_P15(b, n, p, __VA_ARGS__)
+#define _W_PACK(b, n, p, ...) _W_CAT(_W_P, _W_NARG(__VA_ARGS__))(b, n, p, __VA_ARGS__)
+
+/* Skip the rest of a composition body when .memo is set and the listed
+ * props are unchanged. Must be the first statement of the body. */
+#define W_MEMO(p, ...) do { \
+    if ((p).memo) { \
+        unsigned char _w_image[sizeof(p)]; \
+        size_t _w_len = 0; \
+        _W_PACK(_w_image, _w_len, p, __VA_ARGS__) \
+        if (w_memo_hit(_w_image, _w_len)) return; \
+    } \
+} while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_DIFF_H */
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Fuzzy filtering
+ *
+ * fzf-style subsequence matching with word-boundary, camelCase and
+ * consecutive-run bonuses. Smart case: an all-lowercase query matches
+ * case-insensitively, any uppercase character makes it case-sensitive.
+ *
+ * A W_FuzzyIndex filters a caller-owned string array and keeps the ranked
+ * matches. Typing more characters only rescans the previous match set;
+ * large scans are split across the job pool (see jobs.h).
+ *
+ * Usage:
+ *   static W_FuzzyIndex* fz;
+ *   fz = Widget_fuzzy_create();
+ *   Widget_fuzzy_set_items(fz, names, name_count);
+ *   Widget_fuzzy_set_query(fz, input_text);     // each edit
+ *
+ *   Widget_ListView(.fuzzy = fz, .visible_count = 20) { ...items... }
+ */
+
+#ifndef CELS_WIDGETS_FUZZY_H
+#define CELS_WIDGETS_FUZZY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Max query length in bytes (longer queries are truncated) */
+#define W_FUZZY_QUERY_MAX 128
+
+/* Opaque ranked match set over a string array */
+typedef struct W_FuzzyIndex W_FuzzyIndex;
+
+extern W_FuzzyIndex* Widget_fuzzy_create(void);
+extern void Widget_fuzzy_destroy(W_FuzzyIndex* fz);
+
+/* Set the searchable strings (caller-owned, must outlive the index).
+ * Resets the match set; call again whenever the array changes. */
+extern void Widget_fuzzy_set_items(W_FuzzyIndex* fz, const char* const* items, int count);
+
+/* Re-rank for a new query. Returns the number of matches. */
+extern int Widget_fuzzy_set_query(W_FuzzyIndex* fz, const char* query);
+
+/* Item indices ordered best match first. With an empty query every item
+ * matches in source order. */
+extern const int* Widget_fuzzy_matches(const W_FuzzyIndex* fz, int* out_count);
+
+/* Score of the match at `rank` (0 = best) for the current query */
+extern int Widget_fuzzy_match_score(const W_FuzzyIndex* fz, int rank);
+
+/* Heap held by the index: per-item masks, scores and match buffers */
+extern size_t Widget_fuzzy_bytes(const W_FuzzyIndex* fz);
+
+/* Score one string against a query: higher is better, -1 = no match */
+extern int Widget_fuzzy_score(const char* text, const char* query);
+
+/* A query prepared once (smart case applied) for scoring many strings */
+typedef struct W_FuzzyPattern {
+    char text[W_FUZZY_QUERY_MAX];
+    int len;
+    bool case_sensitive;
+    uint64_t mask;              /* Character classes the query needs */
+} W_FuzzyPattern;
+
+extern void Widget_fuzzy_prepare(W_FuzzyPattern* pattern, const char* query);
+
+/* Same result as Widget_fuzzy_score() with the pattern's query */
+extern int Widget_fuzzy_score_prepared(const char* text, const W_FuzzyPattern* pattern);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_FUZZY_H */
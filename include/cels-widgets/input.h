@@ -96,12 +96,33 @@ extern cels_entity_t widgets_nav_scope_active(void);
 extern void widgets_focus_system_register(void);
 
 /*
- * Register behavioral systems (RangeClamp, ScrollClamp, NavigationScope).
+ * One focus system frame with explicit input. The W_FocusSystem callback
+ * calls this with the backend's input and the W_Focusable count; headless
+ * drivers (benchmarks, replays) call it directly.
+ */
+struct ecs_world_t;
+extern void widgets_focus_step(struct ecs_world_t* world, const CELS_Input* input,
+                               int focus_count);
+
+/*
+ * Register behavioral systems (RangeClamp, toasts, perf overlay).
  * Called by Widgets_init() after behavioral components are registered.
  * Forward declaration -- implementation in Plan 03.
  */
 extern void widgets_behavioral_systems_register(void);
 
+/*
+ * Register radio group registry observers (radio.c).
+ * Called by Widgets_init() after widget components are registered.
+ */
+extern void widgets_radio_register(void);
+
+/*
+ * Register window tiling observers (tiling.c).
+ * Called by Widgets_init() after widget components are registered.
+ */
+extern void widgets_tiling_register(void);
+
 /*
  * Text input behavioral system: processes raw_key into buffer edits.
  * Called from the focus system each frame with world, current input, and
@@ -119,6 +140,34 @@ extern void text_input_system_run(struct ecs_world_t* world,
  */
 extern bool text_input_is_active(struct ecs_world_t* world);
 
+/*
+ * Keyed reconciliation: moves selection, focus and scope/scroll position
+ * with W_Key when children are inserted, removed or reordered. Called
+ * from the focus system each frame before navigation.
+ */
+extern void widgets_keyed_reconcile(struct ecs_world_t* world);
+
+/* Heap held by the reconciler's move list, stash and scope fixes */
+extern size_t widgets_keyed_heap_bytes(void);
+
+/*
+ * Per-frame queries: ecs_query() allocates, so the focus and behavioral
+ * passes keep each query in a static W_QueryCache, created on first use
+ * and reused every frame after. A new world (cels runs one per process)
+ * recreates it, including one allocated at a finalized world's address:
+ * finalizing a world bumps the generation the caches are checked against.
+ */
+struct ecs_query_t;
+struct ecs_query_desc_t;
+typedef struct W_QueryCache {
+    struct ecs_world_t* world;
+    struct ecs_query_t* query;
+    unsigned generation;        /* World generation the query was built in */
+} W_QueryCache;
+extern struct ecs_query_t* widgets_query_cached(W_QueryCache* cache,
+                                                struct ecs_world_t* world,
+                                                const struct ecs_query_desc_t* desc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Background job pool
+ *
+ * Small fixed-size worker pool for widget work that must never block a
+ * frame (data grid sort/filter, directory scans). Workers start lazily on
+ * the first submit. Jobs must not touch the ECS world: they operate on
+ * caller-owned data and publish results that layout functions pick up on
+ * a later frame.
+ *
+ * Usage:
+ *   static void build_index(void* arg) { ... }
+ *   if (!w_jobs_submit(build_index, job)) build_index(job);  // queue full
+ *
+ *   static void score_range(void* arg, int begin, int end) { ... }
+ *   w_jobs_parallel_for(count, 4096, score_range, ctx);     // blocks
+ */
+
+#ifndef CELS_WIDGETS_JOBS_H
+#define CELS_WIDGETS_JOBS_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Max worker threads (actual count: online CPUs - 1, clamped to [1, max]) */
+#define W_JOBS_MAX_WORKERS 8
+
+/* Pending job queue capacity */
+#define W_JOBS_QUEUE_SIZE 256
+
+/* Job entry point, runs on a worker thread */
+typedef void (*W_JobFn)(void* arg);
+
+/* Queue a job. Returns false when the queue is full (caller may run inline). */
+extern bool w_jobs_submit(W_JobFn fn, void* arg);
+
+/* Range body for w_jobs_parallel_for: processes [begin, end) */
+typedef void (*W_JobRangeFn)(void* arg, int begin, int end);
+
+/* Split [0, count) into chunks of at least `grain` items and run them on the
+ * workers and the calling thread. Returns when every chunk has finished.
+ * Small ranges (count <= grain) run inline with no synchronization. */
+extern void w_jobs_parallel_for(int count, int grain, W_JobRangeFn fn, void* arg);
+
+/* Number of worker threads (starts the pool if needed) */
+extern int w_jobs_worker_count(void);
+
+/* Drain the queue and join all workers. The pool restarts on the next submit. */
+extern void w_jobs_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_JOBS_H */
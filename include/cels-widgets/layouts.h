@@ -65,6 +65,7 @@ extern void w_table_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_collapsible_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_split_pane_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_scrollable_layout(struct ecs_world_t* world, cels_entity_t self);
+extern void w_theme_scope_layout(struct ecs_world_t* world, cels_entity_t self);
 
 /* Radio */
 extern void w_radio_button_layout(struct ecs_world_t* world, cels_entity_t self);
@@ -73,6 +74,8 @@ extern void w_radio_group_layout(struct ecs_world_t* world, cels_entity_t self);
 /* Navigation */
 extern void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_tab_content_layout(struct ecs_world_t* world, cels_entity_t self);
+extern void w_tab_view_layout(struct ecs_world_t* world, cels_entity_t self);
+extern void w_tab_page_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_status_bar_layout(struct ecs_world_t* world, cels_entity_t self);
 
 /* List */
@@ -90,6 +93,7 @@ extern void w_popup_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_modal_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_window_layout(struct ecs_world_t* world, cels_entity_t self);
 extern void w_toast_layout(struct ecs_world_t* world, cels_entity_t self);
+extern void w_toast_stack_layout(struct ecs_world_t* world, cels_entity_t self);
 
 /* Data Visualization */
 extern void w_spark_layout(struct ecs_world_t* world, cels_entity_t self);
@@ -101,4 +105,26 @@ extern void w_powerline_layout(struct ecs_world_t* world, cels_entity_t self);
 /* Data Visualization - Log Viewer */
 extern void w_log_viewer_layout(struct ecs_world_t* world, cels_entity_t self);
 
+/* Overlays - Command Palette */
+extern void w_command_palette_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* Data Visualization - Data Grid */
+extern void w_datagrid_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* Data Visualization - Tree View */
+extern void w_tree_view_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* Data Visualization - File Browser */
+extern void w_file_browser_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* Diagnostics - Performance Overlay */
+extern void w_perf_overlay_layout(struct ecs_world_t* world, cels_entity_t self);
+
+/* Border decoration ring shared by bordered layouts: W_BORDER_DECOR_MAX
+ * slots reused every frame. Running allocation count (wraps); per-frame
+ * use is the difference between two frames. */
+#define W_BORDER_DECOR_MAX 128
+extern unsigned w_border_decor_allocs(void);
+extern size_t w_border_decor_bytes(void);
+
 #endif /* CELS_WIDGETS_LAYOUTS_H */
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Memory footprint report
+ *
+ * Per widget type, for sizing a session:
+ *
+ *   - instances: entities carrying the widget's props component
+ *   - component bytes: every component on those entities at its full
+ *     sizeof, so inline buffers (W_TextInputBuffer.buffer[256],
+ *     W_PerfOverlayState.frame_ms[]) are included
+ *   - heap bytes: models the props point at (grid indexes, selections,
+ *     fuzzy indexes, tab caches, tree models, directory listings, toast
+ *     managers), each counted once even when widgets share it
+ *   - Clay arena share: elements the type opened last frame times the
+ *     arena's bytes per element (Clay_MinMemorySize() / max elements)
+ *   - string bytes handed to Clay text elements last frame
+ *   - border-decor ring slots taken last frame
+ *
+ * The per-frame columns come from the cost counters (profile.h), so they
+ * need a CELS_WIDGETS_PROFILE build; Clay elements and string bytes also
+ * need CELS_WIDGETS_PROFILE_CLAY. Without them those columns are 0 and
+ * the flags below say so. An entity counts toward the first type whose
+ * props component it carries, in the order of W_MemoryReport.types.
+ *
+ * Heap shared by all widgets (the UI-state slab, the keyed-list stash) is
+ * reported once, outside the per-type rows. Caller-owned data the props
+ * only borrow (row strings, chart values) is not counted. Heap sizes are
+ * read on the UI thread; a directory scan still running reports its
+ * entries but not its name storage.
+ *
+ * Usage:
+ *   W_MemoryReport r;
+ *   Widget_memory_report(world, &r);
+ *   Widget_memory_report_print(&r, stderr);
+ */
+
+#ifndef CELS_WIDGETS_MEMORY_H
+#define CELS_WIDGETS_MEMORY_H
+
+#include <flecs.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Widget types in the report (one per w_*_layout) */
+#define W_MEMORY_TYPES 48
+
+typedef struct W_MemoryTypeStat {
+    const char* name;           /* Props component, e.g. "W_Button" */
+    int instances;
+    size_t component_bytes;     /* All components, inline buffers included */
+    size_t heap_bytes;          /* Owned models, each counted once */
+    size_t clay_bytes;          /* Clay arena share, last frame */
+    uint64_t clay_elements;     /* Last frame */
+    uint64_t text_bytes;        /* Last frame */
+    uint64_t border_decors;     /* Last frame */
+} W_MemoryTypeStat;
+
+typedef struct W_MemoryReport {
+    W_MemoryTypeStat types[W_MEMORY_TYPES];
+    int type_count;
+
+    /* Totals over all types */
+    int instances;
+    size_t component_bytes;
+    size_t heap_bytes;
+
+    /* Library-wide heap, shared by every widget */
+    size_t ui_state_bytes;      /* UI-state slab (scroll, cursor, expansion) */
+    size_t keyed_bytes;         /* Keyed-list reconciliation buffers */
+
+    /* Clay arena: fixed size, shared by every widget */
+    size_t clay_arena_bytes;
+    int clay_max_elements;
+    uint64_t clay_elements;     /* Last frame, all layouts */
+    uint64_t text_bytes;        /* Last frame, all layouts */
+
+    /* Border-decor ring: W_BORDER_DECOR_MAX slots reused every frame */
+    size_t border_decor_bytes;
+    uint64_t border_decors;     /* Last frame; > capacity means the ring wrapped */
+
+    bool frame_counted;         /* Per-frame columns valid (profile build) */
+    bool clay_counted;          /* Clay element / string columns valid */
+} W_MemoryReport;
+
+/* Fill out from the live world and the last profiled frame */
+extern void Widget_memory_report(ecs_world_t* world, W_MemoryReport* out);
+
+/* Human-readable table, one row per type with instances */
+extern void Widget_memory_report_print(const W_MemoryReport* report, FILE* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_MEMORY_H */
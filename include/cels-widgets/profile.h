@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Cost counters
+ *
+ * With CELS_WIDGETS_PROFILE (CMake option of the same name) every
+ * w_*_layout and every process_* pass in focus.c is a profiling site.
+ * Each site records, exclusive of nested sites:
+ *
+ *   - nanoseconds and call count
+ *   - Clay elements opened (needs CELS_WIDGETS_PROFILE_CLAY, set by CMake
+ *     when the linker supports --wrap; otherwise 0). The same wrap counts
+ *     render commands per frame.
+ *   - ECS writes: ecs_set_id / ecs_ensure_id / ecs_add_id /
+ *     ecs_remove_id / ecs_modified_id from library code.
+ *     ecs_get_mut_id only fetches a pointer and is not counted; the
+ *     ecs_set_id that usually follows it is. Writes made by compositions
+ *     in consumer code (cel_has / W_HAS) are not counted either, though
+ *     they are most of a frame's writes
+ *   - string bytes passed to Clay text elements (same wrap as the element
+ *     counts) and border decorations taken from the shared ring
+ *
+ * A frame runs from one widgets_focus_step() to the next. Stats are kept
+ * for the frame in progress, the last completed frame and in total.
+ * Without CELS_WIDGETS_PROFILE the sites compile to nothing and the query
+ * functions report no sites.
+ *
+ * Usage:
+ *   int n;
+ *   const W_ProfileStat* s = Widget_profile_last_frame(&n);
+ *   for (int i = 0; i < n; i++) printf("%s %llu\n", s[i].name, s[i].ns);
+ *
+ *   Widget_profile_trace_begin("frames.json");   // chrome://tracing
+ *   ...
+ *   Widget_profile_trace_end();
+ */
+
+#ifndef CELS_WIDGETS_PROFILE_H
+#define CELS_WIDGETS_PROFILE_H
+
+#include <flecs.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Max distinct profiling sites (43 layouts + focus passes fit easily) */
+#define W_PROFILE_SITES 96
+
+typedef enum W_ProfileKind {
+    W_PROFILE_KIND_LAYOUT,      /* w_*_layout */
+    W_PROFILE_KIND_FOCUS,       /* process_* in focus.c */
+    W_PROFILE_KIND_COUNT
+} W_ProfileKind;
+
+typedef struct W_ProfileStat {
+    const char* name;           /* Function name, e.g. "w_button_layout" */
+    W_ProfileKind kind;
+    uint64_t calls;
+    uint64_t ns;                /* Exclusive of nested sites */
+    uint64_t ns_inclusive;
+    uint64_t clay_elements;     /* Exclusive; element + text opens */
+    uint64_t ecs_writes;        /* Exclusive */
+    uint64_t text_bytes;        /* Exclusive; needs CELS_WIDGETS_PROFILE_CLAY */
+    uint64_t border_decors;     /* Exclusive; W_BORDER_DECOR_MAX ring slots */
+} W_ProfileStat;
+
+typedef struct W_ProfileFrame {
+    uint64_t index;             /* Frames completed before this one */
+    uint64_t ns;                /* Wall time, focus step to focus step */
+    uint64_t layout_ns;         /* Top-level layout sites, inclusive */
+    uint64_t focus_ns;          /* Top-level focus sites, inclusive */
+    uint64_t clay_elements;     /* All elements opened in the frame */
+    uint64_t ecs_writes;        /* All counted writes in the frame */
+    uint64_t text_bytes;        /* String bytes passed to Clay */
+    uint64_t border_decors;     /* Ring slots taken; > W_BORDER_DECOR_MAX wraps */
+    long long render_commands;  /* Clay_EndLayout result; -1 = not counted */
+} W_ProfileFrame;
+
+/* Runtime switch; on by default in CELS_WIDGETS_PROFILE builds */
+extern void Widget_profile_enable(bool enabled);
+extern bool Widget_profile_enabled(void);
+
+/* Clear all counters (sites stay registered) */
+extern void Widget_profile_reset(void);
+
+/* Per-site stats; arrays are indexed by site and valid until the next
+ * frame boundary. count receives the number of registered sites. */
+extern const W_ProfileStat* Widget_profile_last_frame(int* count);
+extern const W_ProfileStat* Widget_profile_totals(int* count);
+extern W_ProfileFrame Widget_profile_last_frame_summary(void);
+extern uint64_t Widget_profile_frame_count(void);
+
+/* Close the frame in progress. widgets_focus_step() calls this; call it
+ * directly when driving layouts without the focus system. */
+extern void Widget_profile_frame_mark(void);
+
+/* Chrome trace-event JSON (chrome://tracing, Perfetto): one complete
+ * event per site call, one instant event per frame. Returns false if the
+ * file cannot be opened. */
+extern bool Widget_profile_trace_begin(const char* path);
+extern void Widget_profile_trace_end(void);
+
+/* Running Clay element totals since start (both 0 without
+ * CELS_WIDGETS_PROFILE_CLAY); lets other tools share the one wrap. */
+extern void Widget_profile_clay_counts(long long* elements, long long* text_elements);
+
+/* ============================================================================
+ * Sites
+ *
+ * Put W_PROFILE_LAYOUT() / W_PROFILE_FOCUS() first in the function body;
+ * the scope closes on every return through a cleanup attribute, so
+ * profile builds need GCC or Clang.
+ * ============================================================================ */
+
+typedef struct W_ProfileScope {
+    int site;                   /* -1 = not recording */
+    int depth;
+} W_ProfileScope;
+
+extern W_ProfileScope w_profile_scope_begin(int* site, W_ProfileKind kind, const char* name);
+extern void w_profile_scope_end(W_ProfileScope* scope);
+extern void w_profile_count_write(void);
+extern void w_profile_count_decor(void);
+
+#ifdef CELS_WIDGETS_PROFILE
+
+#define W_PROFILE_SCOPE(kind, name)                                           \
+    static int _w_prof_site = -1;                                             \
+    W_ProfileScope _w_prof_scope __attribute__((cleanup(w_profile_scope_end))) \
+        = w_profile_scope_begin(&_w_prof_site, (kind), (name))
+
+/* Count ECS writes made by library sources that include this header.
+ * Function-like macros do not recurse, so the real calls still happen. */
+#define ecs_set_id(...)      (w_profile_count_write(), ecs_set_id(__VA_ARGS__))
+#define ecs_ensure_id(...)   (w_profile_count_write(), ecs_ensure_id(__VA_ARGS__))
+#define ecs_add_id(...)      (w_profile_count_write(), ecs_add_id(__VA_ARGS__))
+#define ecs_remove_id(...)   (w_profile_count_write(), ecs_remove_id(__VA_ARGS__))
+#define ecs_modified_id(...) (w_profile_count_write(), ecs_modified_id(__VA_ARGS__))
+
+#else
+
+#define W_PROFILE_SCOPE(kind, name) ((void)0)
+
+#endif
+
+#define W_PROFILE_LAYOUT() W_PROFILE_SCOPE(W_PROFILE_KIND_LAYOUT, __func__)
+#define W_PROFILE_FOCUS()  W_PROFILE_SCOPE(W_PROFILE_KIND_FOCUS, __func__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_PROFILE_H */
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Multi-selection set
+ *
+ * Compressed bitset over item indices, roaring-style: indices are split
+ * into 65536-wide chunks and each chunk stores either a sorted run list
+ * or a plain bitmap, whichever is smaller. Range operations touch whole
+ * chunks at once, so select-all, invert and shift-range over millions of
+ * items cost O(chunks + runs), not O(items).
+ *
+ * Usage:
+ *   static W_Selection* sel;
+ *   sel = Widget_selection_create();
+ *   Widget_DataGrid(.columns = cols, ..., .selection = sel);
+ *
+ *   for (int i = Widget_selection_next(sel, 0); i >= 0;
+ *        i = Widget_selection_next(sel, i + 1)) { ... }
+ */
+
+#ifndef CELS_WIDGETS_SELECTION_H
+#define CELS_WIDGETS_SELECTION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opaque selection set over non-negative int indices */
+typedef struct W_Selection W_Selection;
+
+extern W_Selection* Widget_selection_create(void);
+extern void Widget_selection_destroy(W_Selection* sel);
+extern void Widget_selection_clear(W_Selection* sel);
+
+/* Range operations on [begin, end) */
+extern void Widget_selection_add_range(W_Selection* sel, int begin, int end);
+extern void Widget_selection_remove_range(W_Selection* sel, int begin, int end);
+extern void Widget_selection_flip_range(W_Selection* sel, int begin, int end);
+
+/* Single-index operations */
+extern void Widget_selection_set(W_Selection* sel, int index, bool selected);
+extern void Widget_selection_toggle(W_Selection* sel, int index);
+extern bool Widget_selection_contains(const W_Selection* sel, int index);
+
+/* Number of selected indices */
+extern long long Widget_selection_count(const W_Selection* sel);
+
+/* Heap held by the set: chunk table, run arrays and bitmaps */
+extern size_t Widget_selection_bytes(const W_Selection* sel);
+
+/* First selected index >= from (-1 = none) */
+extern int Widget_selection_next(const W_Selection* sel, int from);
+
+/* First selected run touching [from, ...): returns its start (clamped to
+ * from) and writes its exclusive end. -1 = none. Iterates in O(runs). */
+extern int Widget_selection_next_run(const W_Selection* sel, int from, int* out_end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELS_WIDGETS_SELECTION_H */
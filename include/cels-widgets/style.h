@@ -330,6 +330,8 @@ typedef struct Widget_StatusBarStyle {
 /* ListView style */
 typedef struct Widget_ListViewStyle {
     W_STYLE_COMMON_FIELDS
+    CEL_Color       marked_bg;       /* {0} = theme surface_raised (multi-selected items) */
+    CEL_Color       cursor_bg;       /* {0} = theme interactive_active (selection cursor) */
 } Widget_ListViewStyle;
 
 /* ListItem style */
@@ -412,6 +414,45 @@ typedef struct Widget_LogViewerStyle {
     CEL_Color       timestamp_color; /* {0} = theme content_muted */
 } Widget_LogViewerStyle;
 
+/* CommandPalette style */
+typedef struct Widget_CommandPaletteStyle {
+    W_STYLE_COMMON_FIELDS
+    CEL_Color       hint_color;      /* {0} = theme content_muted (key hints) */
+    CEL_Color       selected_bg;     /* {0} = theme interactive_active */
+    CEL_Color       prompt_color;    /* {0} = theme primary */
+} Widget_CommandPaletteStyle;
+
+/* DataGrid style */
+typedef struct Widget_DataGridStyle {
+    W_STYLE_COMMON_FIELDS
+    CEL_Color       header_color;    /* {0} = theme content_title */
+    CEL_Color       frozen_color;    /* {0} = theme content_muted (frozen columns) */
+    CEL_Color       selected_bg;     /* {0} = theme interactive_active */
+    CEL_Color       marked_bg;       /* {0} = theme surface_raised (multi-selected rows) */
+    CEL_Color       track_color;     /* {0} = theme surface_alt (scrollbar track) */
+    CEL_Color       thumb_color;     /* {0} = theme content_muted (scrollbar thumb) */
+} Widget_DataGridStyle;
+
+/* TreeView: virtualized hierarchy */
+typedef struct Widget_TreeViewStyle {
+    W_STYLE_COMMON_FIELDS
+    CEL_Color       expander_color;  /* {0} = theme content_muted (arrows) */
+    CEL_Color       selected_bg;     /* {0} = theme interactive_active */
+    CEL_Color       track_color;     /* {0} = theme surface_alt (scrollbar track) */
+    CEL_Color       thumb_color;     /* {0} = theme content_muted (scrollbar thumb) */
+} Widget_TreeViewStyle;
+
+/* FileBrowser: virtualized directory list */
+typedef struct Widget_FileBrowserStyle {
+    W_STYLE_COMMON_FIELDS
+    CEL_Color       dir_color;       /* {0} = theme primary (directories) */
+    CEL_Color       meta_color;      /* {0} = theme content_muted (sizes, status) */
+    CEL_Color       header_color;    /* {0} = theme content_title (path line) */
+    CEL_Color       selected_bg;     /* {0} = theme interactive_active */
+    CEL_Color       track_color;     /* {0} = theme surface_alt (scrollbar track) */
+    CEL_Color       thumb_color;     /* {0} = theme content_muted (scrollbar thumb) */
+} Widget_FileBrowserStyle;
+
 /* ============================================================================
  * Helpers -- resolve style overrides with fallbacks
  *
@@ -435,6 +476,28 @@ static inline CEL_Color Widget_resolve_color(CEL_Color override, CEL_Color fallb
     return _cel_resolve_clay_color(override, fallback);
 }
 
+/* Linear blend a -> b for t in [0,1] (clamped); result is opaque */
+static inline CEL_Color w_color_lerp(CEL_Color a, CEL_Color b, float t) {
+    if (t <= 0.0f) return a;
+    if (t >= 1.0f) return b;
+    return (CEL_Color){
+        .r = (float)(a.r + (b.r - a.r) * t),
+        .g = (float)(a.g + (b.g - a.g) * t),
+        .b = (float)(a.b + (b.b - a.b) * t),
+        .a = 255
+    };
+}
+
+/* Three-stop gradient: start -> mid -> end based on normalized [0,1] value */
+static inline CEL_Color w_value_gradient(float normalized,
+                                         CEL_Color start, CEL_Color mid, CEL_Color end) {
+    if (normalized < 0.5f) {
+        return w_color_lerp(start, mid, normalized * 2.0f);
+    } else {
+        return w_color_lerp(mid, end, (normalized - 0.5f) * 2.0f);
+    }
+}
+
 /* ============================================================================
  * Preset Styles
  *
@@ -44,6 +44,7 @@
 #define CELS_WIDGETS_THEME_H
 
 #include <cels-layout/types.h>
+#include <stdint.h>
 
 /* ============================================================================
  * Widget_Theme - Semantic visual tokens for widget rendering
@@ -367,6 +368,69 @@ extern void Widget_set_theme(const Widget_Theme* theme);
  * root compositions to detect theme changes if needed. */
 extern bool Widget_theme_changed(void);
 
+/* ============================================================================
+ * Color Depth
+ *
+ * Without truecolor, Widget_get_theme() returns the active theme compiled
+ * to the terminal palette: every color is replaced by its nearest palette
+ * color when the theme or depth is set, so layouts never convert per cell.
+ * 256-color mode matches the 6x6x6 cube and gray ramp; 16-color mode the
+ * xterm default system colors. Style overrides are not compiled -- pass
+ * them through Widget_quantize_color if they must match exactly.
+ * ============================================================================ */
+
+typedef enum Widget_ColorDepth {
+    WIDGET_COLOR_TRUECOLOR = 0,
+    WIDGET_COLOR_256,
+    WIDGET_COLOR_16
+} Widget_ColorDepth;
+
+/* Set the terminal color depth (default truecolor); recompiles the theme */
+extern void Widget_set_color_depth(Widget_ColorDepth depth);
+extern Widget_ColorDepth Widget_get_color_depth(void);
+
+/* Nearest palette color for the current depth (identity for truecolor).
+ * Alpha is kept. One table lookup. */
+extern CEL_Color Widget_quantize_color(CEL_Color color);
+
+/* Palette index (0-255) for the current depth, -1 for truecolor */
+extern int Widget_color_index(CEL_Color color);
+
+/* ============================================================================
+ * Scoped Themes
+ *
+ * A W_ThemeScope subtree sees its own theme from Widget_get_theme():
+ * the scope layout resolves the effective theme (parent theme with the
+ * scope's set tokens on top) and pushes it around its children.
+ *
+ *   static const Widget_Theme ALERT = { .border = _W_V(220, 80, 80) };
+ *   Widget_ThemeScope(.theme = &ALERT) {
+ *       Widget_Panel(.title = "Alerts") { ... }   // red border
+ *   }
+ * ============================================================================ */
+
+/* Effective theme of one scope, valid for one parent theme + generation */
+typedef struct Widget_ThemeCache {
+    Widget_Theme resolved;
+    const Widget_Theme* parent;
+    const Widget_Theme* overrides;
+    uint32_t parent_generation;
+    uint32_t generation;            /* 0 = empty; changes on every re-merge */
+} Widget_ThemeCache;
+
+/* Generation of the theme Widget_get_theme() returns; changes whenever
+ * that theme's contents may have changed */
+extern uint32_t Widget_theme_generation(void);
+
+/* Effective theme for overrides under the current theme. Merges only when
+ * the cache was built for a different parent, generation or overrides. */
+extern const Widget_Theme* Widget_theme_resolve(Widget_ThemeCache* cache,
+                                                const Widget_Theme* overrides);
+
+/* Make theme current until the matching pop (scope layouts only) */
+extern void Widget_theme_push(const Widget_Theme* theme, uint32_t generation);
+extern void Widget_theme_pop(void);
+
 /* ============================================================================
  * Backward Compatibility (v0.2 -> v0.3)
  * ============================================================================ */
@@ -52,6 +52,8 @@
 
 #include <cels/cels.h>
 #include <cels-widgets/style.h>
+#include <cels-widgets/fuzzy.h>
+#include <cels-widgets/selection.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -173,18 +175,46 @@ cel_component(W_Divider, {
     const Widget_DividerStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
-/* Table: key-value table display */
+/* TableRowFn: data-source row accessor for W_Table. Writes the key and value
+ * strings for `row` (NULL = empty cell). Only called for rows being rendered
+ * or measured, so sources can format lazily into their own storage. */
+typedef void (*W_TableRowFn)(void* user_data, int row,
+                             const char** key, const char** value);
+
+/* Table: key-value table display.
+ * Rows come from the keys/values arrays, or from get_row when set (data-source
+ * mode). With visible_height > 0 only the rows in the W_Scrollable window are
+ * laid out; the key column width tracks the widest key (see W_TableState). */
 cel_component(W_Table, {
     int row_count;          /* Number of rows */
     const char** keys;      /* Array of key strings */
     const char** values;    /* Array of value strings */
+    W_TableRowFn get_row;   /* Row accessor (NULL = use keys/values arrays) */
+    void* user_data;        /* Passed through to get_row */
+    const char* key_header;   /* Key column header (NULL + NULL value_header = no header) */
+    const char* value_header; /* Value column header */
+    int visible_height;     /* Viewport rows incl. header (0 = render all rows) */
     const Widget_TableStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
-/* Collapsible: expandable/collapsible content section with title */
+/* TableState: persistent key column measurement for W_Table.
+ * Zero-initialized by composition; layout function inits once via .initialized.
+ * Appended rows are measured as they arrive and rendered rows are re-measured
+ * every frame, so the column only grows immediately. A rolling rescan measures
+ * a bounded slice of rows per frame and lets the column shrink once a full
+ * pass has completed -- no frame ever walks every row. */
+cel_component(W_TableState, {
+    int key_width;          /* Current key column width in cells */
+    int measured_rows;      /* Rows [0, measured_rows) have been measured once */
+    int rescan_row;         /* Next row for the rolling rescan */
+    int rescan_width;       /* Widest key seen by the in-progress rescan */
+    bool initialized;       /* One-time init flag (same pattern as W_LogViewerState) */
+});
+
+/* Collapsible: expandable/collapsible content section with title.
+ * Expansion lives in the entity's W_UiState (expanded). */
 cel_component(W_Collapsible, {
     const char* title;      /* Section title text */
-    bool collapsed;         /* true = children hidden, false = expanded */
     int indent;             /* Nesting depth for indentation (0 = top level) */
     const Widget_CollapsibleStyle* style; /* Visual overrides (NULL = defaults) */
 });
@@ -196,6 +226,20 @@ cel_component(W_SplitPane, {
     const Widget_SplitStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+/* ThemeScope: theme overrides for a subtree. Set tokens in .theme replace
+ * the inherited ones (color and attr separately); zero tokens inherit.
+ * Scopes nest; see Widget_theme_resolve in theme.h. */
+cel_component(W_ThemeScope, {
+    const Widget_Theme* theme;  /* Partial theme (NULL = inherit everything) */
+});
+
+/* ThemeScopeState: cached effective theme for W_ThemeScope.
+ * Zero-initialized by composition; the layout re-merges only when the
+ * parent theme, its generation or the overrides change. */
+cel_component(W_ThemeScopeState, {
+    Widget_ThemeCache cache;
+});
+
 /* ScrollContainer: generic scrollable viewport with scrollbar gutter */
 cel_component(W_ScrollContainer, {
     int height;             /* Viewport height in rows (required, determines visible_count) */
@@ -213,19 +257,33 @@ cel_component(W_RadioButton, {
     const Widget_RadioButtonStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
-/* Radio group: container for radio button state */
+/* Radio group: container for radio button state.
+ * Buttons with the same group_id are indexed by a registry (radio.c):
+ * selecting one deselects the rest, and selected_index/count are kept in
+ * sync with the members. selected_index is applied when its value changes;
+ * otherwise the registry keeps the choice made by navigation or
+ * Widget_radio_select(). */
 cel_component(W_RadioGroup, {
     int group_id;           /* Group identifier */
-    int selected_index;     /* Currently selected option index */
+    int selected_index;     /* Currently selected option index (-1 = none) */
     int count;              /* Total number of options */
     const Widget_RadioGroupStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+struct ecs_world_t;
+
+/* Selected radio button of a group (0 = none) */
+extern cels_entity_t Widget_radio_selected(int group_id);
+/* Select option index of a group (-1 = clear). False if out of range. */
+extern bool Widget_radio_select(struct ecs_world_t* world, int group_id, int index);
+
 /* ============================================================================
  * Navigation Components
  * ============================================================================ */
 
-/* Tab bar: horizontal tab strip with numbered labels */
+/* Tab bar: horizontal tab strip with numbered labels.
+ * When the tabs do not fit the terminal width only a window of tabs around
+ * the active one is laid out, with "< n" / "n >" counts of hidden tabs. */
 cel_component(W_TabBar, {
     int active;             /* Index of the currently active tab */
     int count;              /* Total number of tabs */
@@ -233,6 +291,19 @@ cel_component(W_TabBar, {
     const Widget_TabBarStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+#define W_TAB_WIDTH_CACHE 64
+
+/* TabBarState: scroll window + label width cache for the tab strip.
+ * Zero-initialized by composition, maintained by layout. Widths are cached
+ * per label pointer in a small direct-mapped table (tab index mod
+ * W_TAB_WIDTH_CACHE), so only labels entering the window are measured.
+ * A label rewritten in place keeps its old width until its slot is reused. */
+cel_component(W_TabBarState, {
+    int first;                                  /* First laid-out tab */
+    const char* width_key[W_TAB_WIDTH_CACHE];   /* Label pointer per slot */
+    int width[W_TAB_WIDTH_CACHE];               /* Cached label width (cells) */
+});
+
 /* Tab content: placeholder content area for a tab */
 cel_component(W_TabContent, {
     const char* text;       /* Main placeholder text (centered) */
@@ -240,6 +311,50 @@ cel_component(W_TabContent, {
     const Widget_TabContentStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+/* Opaque keep-alive set for W_TabView: the active tab plus the
+ * keep_alive most recently active tabs, most recent first */
+typedef struct W_TabCache W_TabCache;
+
+extern W_TabCache* Widget_tab_cache_create(int keep_alive);
+extern void Widget_tab_cache_destroy(W_TabCache* cache);
+/* Make index the most recent tab; evicts the least recent past keep_alive */
+extern void Widget_tab_cache_touch(W_TabCache* cache, int index);
+/* True when tab index should be composed this frame */
+extern bool Widget_tab_cache_live(const W_TabCache* cache, int index);
+/* Forget a tab (e.g. when it is closed) */
+extern void Widget_tab_cache_evict(W_TabCache* cache, int index);
+/* Heap held by the cache */
+extern size_t Widget_tab_cache_bytes(const W_TabCache* cache);
+
+/* Tab view: tab strip plus content area showing only the active page.
+ * Compose one Widget_TabPage for every tab, live or not, so each page
+ * keeps its child slot; only a live page composes its children. Inactive
+ * live pages stay composed (their entities and state survive) but are
+ * not laid out, and an evicted page composes nothing under it:
+ *
+ *   Widget_TabView(.labels = names, .count = 24, .active = cur, .cache = tabs) {
+ *       for (int i = 0; i < 24; i++) {
+ *           Widget_TabPage(.index = i) {
+ *               if (Widget_tab_cache_live(tabs, i)) Dashboard(i);
+ *           }
+ *       }
+ *   }
+ *
+ * Skipping the Widget_TabPage call itself would shift the slots of the
+ * pages after it, and those pages would be recomposed as new entities. */
+cel_component(W_TabView, {
+    int active;             /* Index of the active tab */
+    int count;              /* Total number of tabs */
+    const char** labels;    /* Array of tab label strings (count elements) */
+    W_TabCache* cache;      /* Keep-alive set (NULL = app composes every tab) */
+    const Widget_TabBarStyle* style; /* Tab strip overrides (NULL = defaults) */
+});
+
+/* Tab page: content of one tab inside a W_TabView */
+cel_component(W_TabPage, {
+    int index;              /* Tab index this page belongs to */
+});
+
 /* Status bar: bottom status line with left and right sections */
 cel_component(W_StatusBar, {
     const char* left;       /* Left-aligned text */
@@ -251,13 +366,31 @@ cel_component(W_StatusBar, {
  * List Components
  * ============================================================================ */
 
-/* List view: scrollable list container (scroll via W_Scrollable component) */
+/* List view: scrollable list container (scroll via W_Scrollable component).
+ * With a fuzzy index only matching children are laid out, best match first;
+ * child i must correspond to item i of the index. With a selection the
+ * list keeps its own cursor (W_SelectionState) and marks selected items;
+ * its selection keys apply only while it is selected or focused. */
 cel_component(W_ListView, {
     int item_count;         /* Total number of items */
     int selected_index;     /* Currently selected item index */
+    const W_FuzzyIndex* fuzzy; /* Match filter (NULL = show all children) */
+    W_Selection* selection; /* Multi-selection over item indices (NULL = none) */
     const Widget_ListViewStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+/* SelectionState: cursor + shift-range anchor for multi-select lists/grids.
+ * Zero-initialized by composition when a selection is set. Keys (focus
+ * system): Up/Down move, Space toggles, 'v' anchors at the cursor and
+ * makes Up/Down extend the range until pressed again, Ctrl+A selects
+ * all, '*' inverts. Shift+Up/Down extend directly on backends that
+ * report them (see CELS_KEY_SHIFT_UP in focus.c). */
+cel_component(W_SelectionState, {
+    int cursor;             /* Display row under the cursor */
+    int anchor;             /* Display row where the current range started */
+    bool extending;         /* 'v' range mode: Up/Down extend from anchor */
+});
+
 /* List item: individual item in a list view (selection via W_Selectable component) */
 cel_component(W_ListItem, {
     const char* label;      /* Item label text */
@@ -287,6 +420,49 @@ cel_component(W_InteractState, {
     bool disabled;      /* Interaction disabled */
 });
 
+/* ============================================================================
+ * Keyed Children
+ * ============================================================================
+ *
+ * Entities are matched to children by position, so inserting a row at the
+ * front of a dynamic list shifts every entity down one item. A .key prop
+ * gives each row a stable identity: each frame the keyed reconciler finds
+ * entities whose key changed since last frame and moves their selection,
+ * focus and the scope's selected_index/scroll offset with the key. Rows
+ * whose key did not change are not touched.
+ *
+ * Usage:
+ *   for (int i = 0; i < n; i++)
+ *       Widget_ListItem(.label = items[i].name, .key = items[i].id);
+ */
+
+/* Key: stable identity of a child within its parent (0 = unkeyed) */
+cel_component(W_Key, {
+    uint64_t key;
+});
+
+/* KeyBinding: key the entity carried last frame (0 = not bound yet).
+ * Keyed compositions attach it zero-initialized so binding a key does not
+ * change the entity's table; only the reconciler writes it. */
+cel_component(W_KeyBinding, {
+    uint64_t key;
+});
+
+/* Memo: props hash of a memoized composition's last run (see diff.h) */
+cel_component(W_Memo, {
+    uint64_t props_hash;
+});
+
+/* Prop hashes: props last applied by each W_HAS on an entity (see diff.h) */
+#define W_PROP_SLOTS 8
+cel_component(W_PropHashes, {
+    uint64_t component[W_PROP_SLOTS];   /* Component id; 0 = free slot */
+    uint64_t hash[W_PROP_SLOTS];
+});
+
+/* Hash a string id into a key (FNV-1a, never 0) */
+extern uint64_t Widget_key_str(const char* s);
+
 /* ============================================================================
  * Behavioral Components
  * ============================================================================
@@ -325,10 +501,11 @@ cel_component(W_RangeValueI, {
     int step;               /* Increment step (0 = 1) */
 });
 
-/* Scrollable: scroll state for list views, text areas, etc.
- * Built-in ScrollClamp system enforces scroll_offset bounds each frame. */
+/* Scrollable: scroll extent for list views, text areas, etc.
+ * The offset itself lives in the entity's W_UiState; read and move it with
+ * Widget_scroll_offset() / Widget_scroll_set(), which clamp it to
+ * [0, total_count - visible_count]. */
 cel_component(W_Scrollable, {
-    int scroll_offset;      /* First visible item/line index */
     int total_count;        /* Total number of items/lines */
     int visible_count;      /* Number of visible items/lines */
 });
@@ -385,6 +562,55 @@ cel_component(W_Toast, {
     const Widget_ToastStyle* style; /* Visual overrides (NULL = defaults) */
 });
 
+/* Toast manager: pooled, stacked, deduplicated toasts drawn by a single
+ * W_ToastStack entity. Each position shows up to visible_limit toasts and
+ * queues the rest; pushing a message that is already live bumps its count
+ * instead of adding a toast. Messages are copied (truncated to
+ * W_TOAST_MSG_MAX - 1 bytes).
+ *
+ *   static W_ToastManager* toasts;
+ *   toasts = Widget_toasts_create(3);
+ *   Widget_ToastStack(.manager = toasts) {}
+ *   Widget_toast_push(toasts, "Disk full", 3, 0, 0);
+ */
+#define W_TOAST_POOL 256            /* Live toasts (visible + queued), all positions */
+#define W_TOAST_VISIBLE_MAX 8       /* Upper bound for visible_limit */
+#define W_TOAST_POSITIONS 4         /* Same positions as W_Toast.position */
+#define W_TOAST_MSG_MAX 128
+
+typedef struct W_ToastRecord {
+    char message[W_TOAST_MSG_MAX];
+    int severity;           /* 0=info, 1=success, 2=warning, 3=error */
+    int position;           /* 0=bottom-right, 1=bottom-center, 2=top-right, 3=top-center */
+    float duration;         /* Seconds visible after the last push */
+    float elapsed;          /* Time since shown or last deduplicated push */
+    int count;              /* Pushes merged into this toast */
+} W_ToastRecord;
+
+typedef struct W_ToastManager W_ToastManager;
+
+extern W_ToastManager* Widget_toasts_create(int visible_limit); /* 0 = 3 */
+extern void Widget_toasts_destroy(W_ToastManager* m);
+extern size_t Widget_toasts_bytes(const W_ToastManager* m); /* Fixed pool */
+extern void Widget_toasts_clear(W_ToastManager* m);
+/* Queue a toast (duration <= 0 = 3s). False if the pool is full. */
+extern bool Widget_toast_push(W_ToastManager* m, const char* message, int severity,
+                              int position, float duration);
+/* Age visible toasts and promote queued ones (run by the W_ToastStackTimer system) */
+extern void Widget_toasts_tick(W_ToastManager* m, float dt);
+/* Visible toasts at a position, oldest first; returns how many were written */
+extern int Widget_toasts_visible(const W_ToastManager* m, int position,
+                                 const W_ToastRecord** out, int max);
+extern int Widget_toasts_queued(const W_ToastManager* m, int position);
+/* Pushes lost because the pool was full */
+extern long long Widget_toasts_dropped(const W_ToastManager* m);
+
+/* ToastStack: draws every live toast of a manager */
+cel_component(W_ToastStack, {
+    W_ToastManager* manager;
+    const Widget_ToastStyle* style; /* Visual overrides (NULL = defaults) */
+});
+
 /* Popup: centered floating overlay container */
 cel_component(W_Popup, {
     const char* title;      /* Optional popup title */
@@ -425,6 +651,40 @@ cel_component(W_Draggable, {
     bool moving;            /* Currently in move mode */
 });
 
+/* Tiling: binary space partition of the screen for W_Window. Visible
+ * windows carrying W_Tiled get a tile from their tree (x/y/width/height
+ * are ignored); opening, closing or resizing a window re-tiles only the
+ * affected subtree. A new window splits the active tile along its longer
+ * axis. In move mode ('m', with .draggable) arrow keys resize the tile.
+ *
+ *   static W_TileTree* tiles;
+ *   tiles = Widget_tile_tree_create();
+ *   Widget_Window(.title = "Logs", .visible = true, .tile = tiles) { ... }
+ */
+typedef struct W_TileTree W_TileTree;
+
+typedef struct W_TileRect {
+    int x, y;               /* Top-left, in cells */
+    int w, h;
+} W_TileRect;
+
+extern W_TileTree* Widget_tile_tree_create(void);
+extern void Widget_tile_tree_destroy(W_TileTree* tree);
+/* Screen area to tile (default 80x24); re-tiles everything only when it changes */
+extern void Widget_tile_area(W_TileTree* tree, int x, int y, int w, int h);
+extern bool Widget_tile_insert(W_TileTree* tree, cels_entity_t window);
+extern void Widget_tile_remove(W_TileTree* tree, cels_entity_t window);
+/* Make window's tile the one split by the next insert */
+extern void Widget_tile_focus(W_TileTree* tree, cels_entity_t window);
+/* Move the nearest split boundary on each axis by dx cells / dy rows */
+extern void Widget_tile_resize(W_TileTree* tree, cels_entity_t window, int dx, int dy);
+extern bool Widget_tile_rect(const W_TileTree* tree, cels_entity_t window, W_TileRect* out);
+extern int Widget_tile_count(const W_TileTree* tree);
+
+cel_component(W_Tiled, {
+    W_TileTree* tree;
+});
+
 /* ============================================================================
  * Data Visualization Components
  * ============================================================================ */
@@ -480,6 +740,301 @@ cel_component(W_LogViewerState, {
     bool initialized;       /* One-time init flag (same pattern as W_TextInputBuffer) */
 });
 
+/* ============================================================================
+ * Command Palette Components
+ * ============================================================================ */
+
+/* Registry capacity and result cap */
+#define W_PALETTE_MAX_COMMANDS 4096
+#define W_PALETTE_MAX_RESULTS  64
+
+/* Command: one registered action (NOT a CEL_Define, plain struct).
+ * Strings are caller-owned (static/global); the struct itself is copied. */
+typedef struct W_Command {
+    const char* id;             /* Stable identifier (frecency is keyed by slot) */
+    const char* label;          /* Searchable display name */
+    const char* key_hint;       /* Shortcut shown right-aligned (NULL = none) */
+    void (*run)(void* user_data); /* Invoked when chosen */
+    void* user_data;            /* Passed through to run */
+} W_Command;
+
+/* Register a command. Returns its index, or -1 when the registry is full.
+ * Re-registering an existing id replaces it in place. */
+extern int Widget_palette_register(const W_Command* cmd);
+extern void Widget_palette_clear(void);
+extern int Widget_palette_command_count(void);
+extern const W_Command* Widget_palette_command(int index);
+
+/* Ranked command indices for a query (match score + frecency), best first.
+ * Cached per query: repeated calls within a frame are free, and typing
+ * narrows the previous match set. */
+extern const int* Widget_palette_results(const char* query, int max_results, int* out_count);
+
+/* Run a command and record the use for frecency ranking. Use counts are
+ * halved periodically, so commands that fall out of use drop back. */
+extern void Widget_palette_run(int index);
+
+/* CommandPalette: modal fuzzy command launcher over the palette registry.
+ * While visible it consumes printable keys, Backspace, Up/Down, Enter and
+ * Escape (see process_command_palette in focus.c). */
+cel_component(W_CommandPalette, {
+    bool visible;               /* Display state */
+    int width;                  /* Palette width (0 = 60 default) */
+    int max_results;            /* Result rows (0 = 12 default) */
+    const char* placeholder;    /* Hint shown for an empty query */
+    void (*on_dismiss)(void);   /* Called on Escape or after a command runs */
+    const Widget_CommandPaletteStyle* style; /* Visual overrides (NULL = defaults) */
+});
+
+/* CommandPaletteState: persistent query + selection.
+ * Zero-initialized by composition; reset each time the palette opens. */
+cel_component(W_CommandPaletteState, {
+    char query[W_FUZZY_QUERY_MAX]; /* Current query text */
+    int query_len;              /* Query length in bytes */
+    int selected;               /* Highlighted result row */
+    bool was_visible;           /* Previous frame visibility (reset on open) */
+});
+
+/* ============================================================================
+ * Data Grid Components
+ * ============================================================================ */
+
+/* Column kinds for W_DataGridColumn.kind */
+#define W_GRID_TEXT  0
+#define W_GRID_INT   1
+#define W_GRID_FLOAT 2
+
+/* Max sort keys in one W_DataGridQuery */
+#define W_DATAGRID_MAX_SORT_KEYS 4
+
+/* DataGridColumn: one column of columnar data (NOT a CEL_Define, plain struct).
+ * Exactly one data pointer is used, selected by kind. Data is caller-owned
+ * and must stay unchanged while a sort/filter request is in flight. */
+typedef struct W_DataGridColumn {
+    const char* title;          /* Header text */
+    int kind;                   /* W_GRID_TEXT / W_GRID_INT / W_GRID_FLOAT */
+    const char* const* text;    /* W_GRID_TEXT values (NULL entries render empty) */
+    const long long* ints;      /* W_GRID_INT values */
+    const double* floats;       /* W_GRID_FLOAT values */
+    int width;                  /* Column width in cells (0 = 12) */
+    int precision;              /* Decimal places for W_GRID_FLOAT (0 = 2) */
+} W_DataGridColumn;
+
+/* DataGridSortKey: one sort key (NOT a CEL_Define, plain struct) */
+typedef struct W_DataGridSortKey {
+    int column;                 /* Column index */
+    bool descending;            /* false = ascending */
+} W_DataGridSortKey;
+
+/* DataGridQuery: sort keys + substring filter applied to build a row index */
+typedef struct W_DataGridQuery {
+    W_DataGridSortKey keys[W_DATAGRID_MAX_SORT_KEYS]; /* Primary key first */
+    int key_count;              /* Number of sort keys (0 = source order) */
+    int filter_column;          /* Column matched by filter (-1 = any text column) */
+    const char* filter;         /* Case-insensitive substring (NULL/"" = no filter) */
+    bool fuzzy;                 /* Fuzzy-match filter; ranks by score when key_count = 0 */
+} W_DataGridQuery;
+
+/* DataGridIndex: opaque sorted/filtered row permutation. Built on a worker
+ * thread (see jobs.h); the layout keeps showing the previous permutation
+ * until the new one is published, so sorting never blocks a frame. */
+typedef struct W_DataGridIndex W_DataGridIndex;
+
+extern W_DataGridIndex* Widget_datagrid_index_create(void);
+extern void Widget_datagrid_index_destroy(W_DataGridIndex* index);
+
+/* Request a rebuild. Supersedes (cancels) any request still in flight. */
+extern void Widget_datagrid_index_request(W_DataGridIndex* index,
+                                          const W_DataGridColumn* columns,
+                                          int column_count, int row_count,
+                                          const W_DataGridQuery* query);
+
+/* Latest published permutation (UI thread only). Returns NULL before the
+ * first result -- callers treat that as source order. Valid until the
+ * next call. */
+extern const int* Widget_datagrid_index_rows(W_DataGridIndex* index, int* out_count);
+
+/* True while a request is queued or running */
+extern bool Widget_datagrid_index_busy(const W_DataGridIndex* index);
+
+/* Heap held by the index: published and pending permutations (UI thread) */
+extern size_t Widget_datagrid_index_bytes(W_DataGridIndex* index);
+
+/* Sort direction of column in the published result: 1 = asc, -1 = desc, 0 = unsorted */
+extern int Widget_datagrid_index_sort_dir(const W_DataGridIndex* index, int column);
+
+/* DataGrid: columnar grid with frozen header/leading columns and row + column
+ * virtualization. Only rows in the W_Scrollable window and columns that fit
+ * in visible_width are laid out. Paging and column keys apply only while
+ * the grid is selected or focused. */
+cel_component(W_DataGrid, {
+    const W_DataGridColumn* columns; /* Column array (caller-owned, static/global) */
+    int column_count;           /* Number of columns */
+    int row_count;              /* Rows in every column */
+    W_DataGridIndex* index;     /* Sorted/filtered order (NULL = source order) */
+    int frozen_columns;         /* Leading columns pinned during horizontal scroll */
+    int visible_height;         /* Viewport rows including header */
+    int visible_width;          /* Viewport width in cells for column virtualization */
+    int selected_row;           /* Highlighted display row (-1 = none) */
+    W_Selection* selection;     /* Multi-selection over source rows (NULL = none) */
+    const Widget_DataGridStyle* style; /* Visual overrides (NULL = defaults) */
+});
+
+/* DataGridState: persistent horizontal scroll position.
+ * Zero-initialized by composition; the focus system moves col_offset with
+ * Left/Right while the grid is selected. */
+cel_component(W_DataGridState, {
+    int col_offset;             /* First scrolled (non-frozen) column */
+    int scroll_columns;         /* Scrollable columns that fit (written by layout) */
+});
+
+/* ============================================================================
+ * Tree View Components
+ * ============================================================================ */
+
+/* TreeNode: one child reported by a W_TreeSource (NOT a CEL_Define, plain struct) */
+typedef struct W_TreeNode {
+    uint64_t id;                /* Caller node id (unique, stable across reloads) */
+    const char* label;          /* Row text (caller-owned, valid while visible) */
+    bool has_children;          /* Shows an expander; children load on first expand */
+} W_TreeNode;
+
+/* TreeSource: lazy child provider (NOT a CEL_Define, plain struct).
+ * Children of a node are only requested when it is expanded, so the full
+ * hierarchy never has to exist in memory. */
+typedef struct W_TreeSource {
+    uint64_t root;              /* Id whose children form the top level */
+    int (*child_count)(void* user_data, uint64_t parent);
+    void (*child_at)(void* user_data, uint64_t parent, int index, W_TreeNode* out);
+    void* user_data;
+} W_TreeSource;
+
+/* TreeRow: one visible row of a W_TreeModel (read-only to callers) */
+typedef struct W_TreeRow {
+    uint64_t id;
+    const char* label;
+    int depth;                  /* 0 = top level */
+    bool has_children;
+    bool expanded;
+} W_TreeRow;
+
+/* TreeModel: opaque flattened list of visible rows in depth-first order.
+ * Expand splices a node's children in after it; collapse removes its
+ * subtree range. Expanded state is remembered per id, so re-expanding a
+ * parent restores its open descendants. UI thread only. */
+typedef struct W_TreeModel W_TreeModel;
+
+extern W_TreeModel* Widget_tree_create(const W_TreeSource* source);
+extern void Widget_tree_destroy(W_TreeModel* model);
+
+/* Rebuild visible rows from the source (keeps expanded state) */
+extern void Widget_tree_reload(W_TreeModel* model);
+
+extern int Widget_tree_row_count(const W_TreeModel* model);
+/* Heap held by the model: visible rows, expanded set and splice scratch */
+extern size_t Widget_tree_bytes(const W_TreeModel* model);
+extern const W_TreeRow* Widget_tree_row(const W_TreeModel* model, int row);
+
+/* Expand/collapse a visible row. Return the number of rows inserted/removed. */
+extern int Widget_tree_expand(W_TreeModel* model, int row);
+extern int Widget_tree_collapse(W_TreeModel* model, int row);
+
+/* Toggle an expandable row. Returns false for leaves. */
+extern bool Widget_tree_toggle(W_TreeModel* model, int row);
+
+/* Visible row of the node's parent (-1 for top-level rows) */
+extern int Widget_tree_parent_row(const W_TreeModel* model, int row);
+
+/* TreeView: virtualized hierarchy over a W_TreeModel. Only rows in the
+ * W_Scrollable window are laid out. Up/Down move, Right expands or steps
+ * into the first child, Left collapses or steps to the parent, Enter
+ * toggles (or activates a leaf). Keys apply only while the tree is
+ * selected or focused. The cursor row is the entity's W_UiState.cursor;
+ * node expansion is kept in the model. */
+cel_component(W_TreeView, {
+    W_TreeModel* model;         /* Row model (caller-owned) */
+    int visible_height;         /* Viewport rows */
+    void (*on_activate)(uint64_t id); /* Called on Enter over a leaf */
+    const Widget_TreeViewStyle* style; /* Visual overrides (NULL = defaults) */
+});
+
+/* ============================================================================
+ * File Browser Components
+ * ============================================================================ */
+
+/* Max directory path length in bytes */
+#define W_DIR_PATH_MAX 4096
+
+/* Entry kinds for W_DirEntry.type */
+#define W_DIRENT_FILE  0
+#define W_DIRENT_DIR   1
+#define W_DIRENT_LINK  2
+#define W_DIRENT_OTHER 3
+
+/* Sort keys for Widget_dir_set_sort (directories always sort first) */
+#define W_DIR_SORT_NAME  0
+#define W_DIR_SORT_SIZE  1
+#define W_DIR_SORT_MTIME 2
+
+/* DirEntry: one scanned entry (read-only; stable until the next open) */
+typedef struct W_DirEntry {
+    const char* name;
+    long long size;             /* Bytes (0 when stat failed) */
+    long long mtime;            /* Seconds since epoch */
+    int type;                   /* W_DIRENT_* (symlinks are not followed) */
+} W_DirEntry;
+
+/* DirListing: opaque directory model. Widget_dir_open() scans on the job
+ * pool (see jobs.h); entries become visible in batches as they are read
+ * and are re-ordered once the background sort publishes. UI thread only. */
+typedef struct W_DirListing W_DirListing;
+
+extern W_DirListing* Widget_dir_create(void);
+extern void Widget_dir_destroy(W_DirListing* listing);
+
+/* Start scanning path (cancels the previous scan). False if path is too long. */
+extern bool Widget_dir_open(W_DirListing* listing, const char* path);
+
+/* Open the directory at display index / the parent directory */
+extern bool Widget_dir_enter(W_DirListing* listing, int index);
+extern bool Widget_dir_up(W_DirListing* listing);
+
+extern const char* Widget_dir_path(const W_DirListing* listing);
+
+/* Entries visible so far. Also adopts a newly sorted order, so call it
+ * once per frame before Widget_dir_entry(). */
+extern int Widget_dir_count(W_DirListing* listing);
+extern const W_DirEntry* Widget_dir_entry(const W_DirListing* listing, int index);
+
+/* Heap held by the listing: entry chunks, sorted order and, once the scan
+ * is done, its name blocks (UI thread) */
+extern size_t Widget_dir_bytes(W_DirListing* listing);
+
+/* Full path of the entry at index into buf. Returns the snprintf length (-1 if none). */
+extern int Widget_dir_entry_path(const W_DirListing* listing, int index,
+                                 char* buf, int buf_size);
+
+/* True until the read and the final sort have finished */
+extern bool Widget_dir_scanning(const W_DirListing* listing);
+
+/* errno from opening the directory (0 = ok) */
+extern int Widget_dir_error(const W_DirListing* listing);
+
+/* Re-sort off the UI thread (W_DIR_SORT_*) */
+extern void Widget_dir_set_sort(W_DirListing* listing, int sort_key, bool descending);
+
+/* FileBrowser: virtualized directory list over a W_DirListing. Up/Down and
+ * PgUp/PgDn/Home/End move the cursor, Enter opens a directory or calls
+ * on_open for a file, Left/Backspace goes to the parent directory. Keys
+ * apply only while the browser is selected or focused. The cursor row is
+ * the entity's W_UiState.cursor, reset on directory change. */
+cel_component(W_FileBrowser, {
+    W_DirListing* listing;      /* Directory model (caller-owned) */
+    int visible_height;         /* Viewport rows including the path header */
+    void (*on_open)(const char* path); /* Called on Enter over a file */
+    const Widget_FileBrowserStyle* style; /* Visual overrides (NULL = defaults) */
+});
+
 /* ============================================================================
  * Powerline Components
  * ============================================================================ */
@@ -504,6 +1059,101 @@ extern void Widget_set_powerline_glyphs(bool enabled);
 /* Query current powerline glyph mode */
 extern bool Widget_powerline_glyphs_enabled(void);
 
+/* ============================================================================
+ * Performance Overlay Components
+ * ============================================================================
+ *
+ * Floating HUD with FPS, a frame-time sparkline and the last frame's
+ * costs. The W_PerfOverlaySample system records one sample per frame and
+ * flips visibility when toggle_key arrives as raw_key (ignored while a
+ * text input is active). Phase times, ECS writes and Clay counts come
+ * from the cost counters (profile.h) and read "-" in builds without
+ * CELS_WIDGETS_PROFILE.
+ *
+ *   Widget_PerfOverlay(.toggle_key = '`', .position = 2) {}
+ */
+#define W_PERF_HISTORY 32           /* Frame-time samples in the sparkline */
+
+cel_component(W_PerfOverlay, {
+    int toggle_key;         /* raw_key that shows/hides the HUD (0 = '`') */
+    bool start_visible;     /* Visibility before the first toggle */
+    int position;           /* Toast positions: 0=bottom-right, 1=bottom-center,
+                               2=top-right, 3=top-center */
+});
+
+/* PerfOverlayState: samples and visibility (persistent, written by the
+ * W_PerfOverlaySample system). Counters are -1 when not measured. */
+cel_component(W_PerfOverlayState, {
+    bool initialized;
+    bool visible;
+    float frame_ms[W_PERF_HISTORY]; /* Ring of frame times */
+    int head;               /* Next write slot */
+    int count;              /* Valid samples */
+    float fps;              /* Mean over the ring */
+    float focus_ms;         /* Last completed frame, top-level sites */
+    float layout_ms;
+    long long clay_elements;
+    long long render_commands;
+    long long ecs_writes;   /* Library writes only; compositions are not counted */
+    int decor_used;         /* Border decoration slots used last frame */
+    unsigned decor_mark;    /* w_border_decor_allocs() at the last sample */
+});
+
+/* ============================================================================
+ * Persistent UI State
+ * ============================================================================
+ *
+ * Compositions rewrite their components from props every frame, so state
+ * a system changes (drag mode, cursor, scroll, expansion) does not survive
+ * in those components. W_UiState is a per-entity record kept outside the
+ * composed components: slab-allocated, found in O(1) through the
+ * W_UiStateRef component, and released when the entity is deleted.
+ * Pointers stay valid until then.
+ */
+
+typedef struct W_UiState {
+    int cursor;             /* Cursor row/item (tree view, file browser) */
+    int anchor;             /* Range anchor (shift-select) */
+    int scroll_offset;      /* First visible row/line (W_Scrollable) */
+    bool expanded;          /* Expansion (collapsibles) */
+    bool drag_moving;       /* Window move mode */
+
+    /* Last prop values applied by w_ui_scroll_prop / w_ui_expanded_prop */
+    uint8_t props_applied;  /* W_UI_PROP_* bits */
+    bool expanded_prop;
+    int scroll_prop;
+} W_UiState;
+
+#define W_UI_PROP_SCROLL   (1u << 0)
+#define W_UI_PROP_EXPANDED (1u << 1)
+
+/* UiStateRef: slab slot of the entity's W_UiState. Added on first
+ * Widget_ui_state() call; compositions never write it. */
+cel_component(W_UiStateRef, {
+    uint32_t slot;
+});
+
+struct ecs_world_t;
+
+/* State for entity, zero-initialized on first use */
+extern W_UiState* Widget_ui_state(struct ecs_world_t* world, cels_entity_t entity);
+/* State for entity if it has any (NULL = never used) */
+extern W_UiState* Widget_ui_state_find(struct ecs_world_t* world, cels_entity_t entity);
+/* Heap held by the slab, shared by every entity with UI state */
+extern size_t Widget_ui_state_bytes(void);
+
+/* Scroll offset of a W_Scrollable entity, clamped to its current extent */
+extern int Widget_scroll_offset(struct ecs_world_t* world, cels_entity_t entity);
+/* Move the scroll offset (clamped); returns the stored offset */
+extern int Widget_scroll_set(struct ecs_world_t* world, cels_entity_t entity, int offset);
+
+/* Composition helpers: seed the composing entity's UI state from a prop.
+ * The prop is applied on first use and again only when its value changes,
+ * so a scroll or toggle made since then survives recomposition. Call only
+ * from a composition. */
+extern void w_ui_scroll_prop(int scroll_offset);
+extern void w_ui_expanded_prop(bool expanded);
+
 /* ============================================================================
  * Module API
  * ============================================================================ */
@@ -23,13 +23,19 @@
  * Systems:
  *   W_RangeClampF   - Clamps W_RangeValueF.value to [min, max] at PostUpdate
  *   W_RangeClampI   - Clamps W_RangeValueI.value to [min, max] at PostUpdate
- *   W_ScrollClamp   - Clamps W_Scrollable.scroll_offset to valid range at PostUpdate
  *   W_ToastTimer    - Auto-dismiss timer for W_Toast notifications at PostUpdate
+ *   W_ToastStackTimer - Ages and promotes W_ToastStack manager toasts at PostUpdate
+ *   W_PerfOverlaySample - Frame sample + toggle key for W_PerfOverlay HUDs
  *   TextInputSystem - Processes raw_key into W_TextInputBuffer edits (insert/delete/cursor)
+ *
+ * Scroll offsets need no system: they live in W_UiState and are clamped
+ * whenever they are read or moved (Widget_scroll_offset, uistate.c).
  */
 
 #include <cels-widgets/widgets.h>
 #include <cels-widgets/input.h>
+#include <cels-widgets/layouts.h>
+#include <cels-widgets/profile.h>
 #include <flecs.h>
 #include <string.h>
 
@@ -57,18 +63,6 @@ static void range_clamp_i_run(CELS_Iter* it) {
     }
 }
 
-static void scroll_clamp_run(CELS_Iter* it) {
-    int count = cels_iter_count(it);
-    W_Scrollable* scrolls = (W_Scrollable*)cels_iter_column(it, W_Scrollable_id, sizeof(W_Scrollable));
-    if (!scrolls) return;
-    for (int i = 0; i < count; i++) {
-        int max_offset = scrolls[i].total_count - scrolls[i].visible_count;
-        if (max_offset < 0) max_offset = 0;
-        if (scrolls[i].scroll_offset < 0) scrolls[i].scroll_offset = 0;
-        if (scrolls[i].scroll_offset > max_offset) scrolls[i].scroll_offset = max_offset;
-    }
-}
-
 /* W_ToastTimer: auto-dismiss timer for toast notifications */
 static void toast_timer_run(CELS_Iter* it) {
     int count = cels_iter_count(it);
@@ -84,6 +78,80 @@ static void toast_timer_run(CELS_Iter* it) {
     }
 }
 
+/* W_ToastStackTimer: expires manager toasts and promotes queued ones */
+static void toast_stack_timer_run(CELS_Iter* it) {
+    int count = cels_iter_count(it);
+    W_ToastStack* stacks = (W_ToastStack*)cels_iter_column(it, W_ToastStack_id, sizeof(W_ToastStack));
+    float dt = cels_iter_delta_time(it);
+    if (!stacks) return;
+    for (int i = 0; i < count; i++) {
+        Widget_toasts_tick(stacks[i].manager, dt);
+    }
+}
+
+/* W_PerfOverlaySample: records one frame sample per overlay and handles
+ * the toggle key. Runs after the focus step, so the profile summary it
+ * reads is the previous (completed) frame. */
+static void perf_overlay_sample_run(CELS_Iter* it) {
+    int count = cels_iter_count(it);
+    W_PerfOverlay* cfgs = (W_PerfOverlay*)cels_iter_column(it, W_PerfOverlay_id, sizeof(W_PerfOverlay));
+    W_PerfOverlayState* states = (W_PerfOverlayState*)cels_iter_column(
+        it, W_PerfOverlayState_id, sizeof(W_PerfOverlayState));
+    float dt = cels_iter_delta_time(it);
+    if (!cfgs || !states) return;
+
+    CELS_Context* ctx = cels_get_context();
+    const CELS_Input* input = cels_input_get(ctx);
+    bool profiling = Widget_profile_enabled();
+    W_ProfileFrame frame = Widget_profile_last_frame_summary();
+    unsigned decor_allocs = w_border_decor_allocs();
+
+    for (int i = 0; i < count; i++) {
+        W_PerfOverlayState* st = &states[i];
+        if (!st->initialized) {
+            st->initialized = true;
+            st->visible = cfgs[i].start_visible;
+            st->decor_mark = decor_allocs;
+        }
+
+        /* Toggle on the key press; typing into a text input does not count */
+        int key = cfgs[i].toggle_key ? cfgs[i].toggle_key : '`';
+        if (input && input->has_raw_key && input->raw_key == key &&
+            !text_input_is_active(cels_get_world(ctx))) {
+            st->visible = !st->visible;
+        }
+
+        st->frame_ms[st->head] = dt * 1000.0f;
+        st->head = (st->head + 1) % W_PERF_HISTORY;
+        if (st->count < W_PERF_HISTORY) st->count++;
+
+        float sum_ms = 0.0f;
+        for (int k = 0; k < st->count; k++) sum_ms += st->frame_ms[k];
+        st->fps = sum_ms > 0.0f ? (float)st->count * 1000.0f / sum_ms : 0.0f;
+
+        st->decor_used = (int)(decor_allocs - st->decor_mark);
+        st->decor_mark = decor_allocs;
+
+        if (profiling) {
+            st->focus_ms = (float)frame.focus_ns / 1e6f;
+            st->layout_ms = (float)frame.layout_ns / 1e6f;
+            st->ecs_writes = (long long)frame.ecs_writes;
+#ifdef CELS_WIDGETS_PROFILE_CLAY
+            st->clay_elements = (long long)frame.clay_elements;
+#else
+            st->clay_elements = -1;
+#endif
+            st->render_commands = frame.render_commands;
+        } else {
+            st->focus_ms = -1.0f;
+            st->layout_ms = -1.0f;
+            st->ecs_writes = -1;
+            st->clay_elements = -1;
+            st->render_commands = -1;
+        }
+    }
+}
+
 /* ============================================================================
  * TextInputSystem: processes raw_key into W_TextInputBuffer edits
  *
@@ -108,7 +176,8 @@ void text_input_system_run(ecs_world_t* world, const CELS_Input* input,
     cel_register(W_InteractState);
 
     /* Query all entities with both W_TextInput and W_TextInputBuffer */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_TextInput_id }, { .id = W_TextInputBuffer_id }}
     });
     if (!q) return;
@@ -261,8 +330,6 @@ void text_input_system_run(ecs_world_t* world, const CELS_Input* input,
                        sizeof(W_TextInputBuffer), buf);
         }
     }
-
-    ecs_query_fini(q);
 }
 
 /* ============================================================================
@@ -277,7 +344,8 @@ bool text_input_is_active(ecs_world_t* world) {
     cel_register(W_Selectable);
     cel_register(W_InteractState);
 
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_TextInputBuffer_id }}
     });
     if (!q) return false;
@@ -296,7 +364,6 @@ bool text_input_is_active(ecs_world_t* world) {
             }
         }
     }
-    ecs_query_fini(q);
     return active;
 }
 
@@ -314,6 +381,9 @@ void widgets_behavioral_systems_register(void) {
     cel_register(W_RangeValueI);
     cel_register(W_Scrollable);
     cel_register(W_Toast);
+    cel_register(W_ToastStack);
+    cel_register(W_PerfOverlay);
+    cel_register(W_PerfOverlayState);
     cel_register(W_TextInput);
     cel_register(W_TextInputBuffer);
 
@@ -325,11 +395,15 @@ void widgets_behavioral_systems_register(void) {
     cels_system_declare("W_RangeClampI", CELS_Phase_OnUpdate,
                         range_clamp_i_run, range_i_comps, 1);
 
-    cels_entity_t scroll_comps[] = { W_Scrollable_id };
-    cels_system_declare("W_ScrollClamp", CELS_Phase_OnUpdate,
-                        scroll_clamp_run, scroll_comps, 1);
-
     cels_entity_t toast_comps[] = { W_Toast_id };
     cels_system_declare("W_ToastTimer", CELS_Phase_OnUpdate,
                         toast_timer_run, toast_comps, 1);
+
+    cels_entity_t toast_stack_comps[] = { W_ToastStack_id };
+    cels_system_declare("W_ToastStackTimer", CELS_Phase_OnUpdate,
+                        toast_stack_timer_run, toast_stack_comps, 1);
+
+    cels_entity_t perf_comps[] = { W_PerfOverlay_id, W_PerfOverlayState_id };
+    cels_system_declare("W_PerfOverlaySample", CELS_Phase_OnUpdate,
+                        perf_overlay_sample_run, perf_comps, 2);
 }
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - DataGrid row index (background sort/filter)
+ *
+ * A W_DataGridIndex holds the row permutation the grid layout renders.
+ * Each request snapshots the query, bumps a generation counter and hands
+ * the work to the job pool:
+ *
+ *   1. Filter: scan rows, keep those whose cell contains the substring
+ *      (fuzzy mode: score every row in parallel, keep matches)
+ *   2. Sort:   bottom-up merge sort (stable) over the multi-key comparator,
+ *      then fuzzy score (best first)
+ *   3. Publish: if the generation is still current, swap the result into
+ *      the pending slot under the lock; otherwise discard it
+ *
+ * A newer request cancels older ones cooperatively: running jobs poll the
+ * generation between filter blocks and merge passes and exit early.
+ *
+ * The UI thread adopts the pending result on its next
+ * Widget_datagrid_index_rows() call. Until then it keeps rendering the
+ * previous permutation, so a frame never waits on a sort. A request the
+ * job queue has no room for is kept (the newest one only) and submitted
+ * again from that same call, instead of running on the UI thread.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/jobs.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/* Filter text is copied into the job (caller strings may be stack buffers) */
+#define W_DATAGRID_FILTER_MAX 128
+
+/* Rows filtered between cancellation checks (also the fuzzy chunk size) */
+#define W_DATAGRID_CANCEL_STRIDE 4096
+
+/* ============================================================================
+ * Index State
+ * ============================================================================ */
+
+struct W_DataGridIndex {
+    pthread_mutex_t lock;
+    pthread_cond_t idle;            /* Signalled when in_flight drops */
+    atomic_uint generation;         /* Bumped per request; stale jobs cancel */
+    atomic_int in_flight;           /* Queued + running jobs */
+
+    /* Worker -> UI handoff (guarded by lock) */
+    int* pending;
+    int pending_count;
+    W_DataGridSortKey pending_keys[W_DATAGRID_MAX_SORT_KEYS];
+    int pending_key_count;
+    bool has_pending;
+
+    /* Adopted result (UI thread only) */
+    int* front;
+    int front_count;
+    W_DataGridSortKey front_keys[W_DATAGRID_MAX_SORT_KEYS];
+    int front_key_count;
+
+    struct DataGridJob* deferred;   /* Queue was full; counted in in_flight */
+};
+
+typedef struct DataGridJob {
+    W_DataGridIndex* index;
+    unsigned gen;
+    const W_DataGridColumn* columns;
+    int column_count;
+    int row_count;
+    W_DataGridSortKey keys[W_DATAGRID_MAX_SORT_KEYS];
+    int key_count;
+    int filter_column;
+    char filter[W_DATAGRID_FILTER_MAX];
+    bool fuzzy;
+    W_FuzzyPattern pattern;         /* filter, prepared once (fuzzy mode) */
+    int* scores;                    /* Fuzzy score per source row (fuzzy mode) */
+} DataGridJob;
+
+/* ============================================================================
+ * Filter + Compare
+ * ============================================================================ */
+
+static bool datagrid_cancelled(const DataGridJob* job) {
+    return atomic_load_explicit(&job->index->generation, memory_order_relaxed) != job->gen;
+}
+
+/* Case-insensitive substring match (needle already lower-cased) */
+static bool datagrid_contains(const char* hay, const char* needle) {
+    if (!hay) return false;
+    for (; *hay; hay++) {
+        const char* h = hay;
+        const char* n = needle;
+        while (*h && *n && tolower((unsigned char)*h) == *n) { h++; n++; }
+        if (!*n) return true;
+    }
+    return false;
+}
+
+static bool datagrid_row_matches(const DataGridJob* job, int row) {
+    if (job->filter_column >= 0) {
+        const W_DataGridColumn* c = &job->columns[job->filter_column];
+        return c->kind == W_GRID_TEXT && c->text && datagrid_contains(c->text[row], job->filter);
+    }
+    for (int i = 0; i < job->column_count; i++) {
+        const W_DataGridColumn* c = &job->columns[i];
+        if (c->kind == W_GRID_TEXT && c->text && datagrid_contains(c->text[row], job->filter)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Best fuzzy score over the filter column(s), -1 = no match */
+static int datagrid_row_score(const DataGridJob* job, int row) {
+    if (job->filter_column >= 0) {
+        const W_DataGridColumn* c = &job->columns[job->filter_column];
+        if (c->kind != W_GRID_TEXT || !c->text) return -1;
+        return Widget_fuzzy_score_prepared(c->text[row], &job->pattern);
+    }
+    int best = -1;
+    for (int i = 0; i < job->column_count; i++) {
+        const W_DataGridColumn* c = &job->columns[i];
+        if (c->kind != W_GRID_TEXT || !c->text) continue;
+        int sc = Widget_fuzzy_score_prepared(c->text[row], &job->pattern);
+        if (sc > best) best = sc;
+    }
+    return best;
+}
+
+static void datagrid_score_range(void* arg, int begin, int end) {
+    DataGridJob* job = (DataGridJob*)arg;
+    bool cancelled = datagrid_cancelled(job);
+    for (int i = begin; i < end; i++) {
+        job->scores[i] = cancelled ? -1 : datagrid_row_score(job, i);
+    }
+}
+
+static int datagrid_compare(const DataGridJob* job, int a, int b) {
+    for (int k = 0; k < job->key_count; k++) {
+        const W_DataGridColumn* c = &job->columns[job->keys[k].column];
+        int r = 0;
+        if (c->kind == W_GRID_TEXT && c->text) {
+            const char* x = c->text[a] ? c->text[a] : "";
+            const char* y = c->text[b] ? c->text[b] : "";
+            r = strcmp(x, y);
+        } else if (c->kind == W_GRID_INT && c->ints) {
+            r = (c->ints[a] > c->ints[b]) - (c->ints[a] < c->ints[b]);
+        } else if (c->kind == W_GRID_FLOAT && c->floats) {
+            double x = c->floats[a], y = c->floats[b];
+            /* NaN sorts after every number */
+            if (x != x || y != y) r = (x != x) - (y != y);
+            else r = (x > y) - (x < y);
+        }
+        if (r != 0) return job->keys[k].descending ? -r : r;
+    }
+    if (job->scores) {
+        return (job->scores[a] < job->scores[b]) - (job->scores[a] > job->scores[b]);
+    }
+    return 0;
+}
+
+/* Stable bottom-up merge sort. Returns the buffer holding the result
+ * (rows or tmp), or NULL when cancelled. */
+static int* datagrid_sort(const DataGridJob* job, int* rows, int* tmp, int n) {
+    int* src = rows;
+    int* dst = tmp;
+    for (int width = 1; width < n; width *= 2) {
+        if (datagrid_cancelled(job)) return NULL;
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int i = lo, j = mid, o = lo;
+            while (i < mid && j < hi) {
+                /* <= keeps equal keys in source order (stability) */
+                if (datagrid_compare(job, src[i], src[j]) <= 0) dst[o++] = src[i++];
+                else dst[o++] = src[j++];
+            }
+            while (i < mid) dst[o++] = src[i++];
+            while (j < hi) dst[o++] = src[j++];
+        }
+        int* swap = src; src = dst; dst = swap;
+    }
+    return src;
+}
+
+/* ============================================================================
+ * Worker Job
+ * ============================================================================ */
+
+static void datagrid_job_run(void* arg) {
+    DataGridJob* job = (DataGridJob*)arg;
+    W_DataGridIndex* idx = job->index;
+    int n = job->row_count;
+    int* rows = (int*)malloc(sizeof(int) * (size_t)(n > 0 ? n : 1));
+    int* tmp = NULL;
+    int* result = NULL;
+    int count = 0;
+
+    if (!rows) goto done;
+
+    /* 1. Filter */
+    bool filtering = job->filter[0] != '\0';
+    if (filtering && job->fuzzy) {
+        job->scores = (int*)malloc(sizeof(int) * (size_t)(n > 0 ? n : 1));
+        if (!job->scores) goto done;
+        Widget_fuzzy_prepare(&job->pattern, job->filter);
+        w_jobs_parallel_for(n, W_DATAGRID_CANCEL_STRIDE, datagrid_score_range, job);
+        if (datagrid_cancelled(job)) goto done;
+        for (int i = 0; i < n; i++) {
+            if (job->scores[i] >= 0) rows[count++] = i;
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            if ((i % W_DATAGRID_CANCEL_STRIDE) == 0 && datagrid_cancelled(job)) goto done;
+            if (!filtering || datagrid_row_matches(job, i)) rows[count++] = i;
+        }
+    }
+
+    /* 2. Sort */
+    result = rows;
+    if ((job->key_count > 0 || job->scores) && count > 1) {
+        tmp = (int*)malloc(sizeof(int) * (size_t)count);
+        if (!tmp) { result = NULL; goto done; }
+        result = datagrid_sort(job, rows, tmp, count);
+    }
+
+done:
+    /* 3. Publish (or discard) -- idx must not be touched after unlock */
+    pthread_mutex_lock(&idx->lock);
+    if (result && !datagrid_cancelled(job)) {
+        free(idx->pending);
+        idx->pending = result;
+        idx->pending_count = count;
+        memcpy(idx->pending_keys, job->keys, sizeof(job->keys));
+        idx->pending_key_count = job->key_count;
+        idx->has_pending = true;
+    } else {
+        result = NULL;
+    }
+    atomic_fetch_sub(&idx->in_flight, 1);
+    pthread_cond_broadcast(&idx->idle);
+    pthread_mutex_unlock(&idx->lock);
+
+    /* Free whichever buffers were not published */
+    if (rows != result) free(rows);
+    if (tmp != result) free(tmp);
+    free(job->scores);
+    free(job);
+}
+
+/* UI thread: retry the deferred request, or drop it once superseded */
+static void datagrid_submit_deferred(W_DataGridIndex* idx) {
+    if (idx->deferred && w_jobs_submit(datagrid_job_run, idx->deferred)) {
+        idx->deferred = NULL;
+    }
+}
+
+static void datagrid_drop_deferred(W_DataGridIndex* idx) {
+    if (!idx->deferred) return;
+    free(idx->deferred);
+    idx->deferred = NULL;
+    atomic_fetch_sub(&idx->in_flight, 1);
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_DataGridIndex* Widget_datagrid_index_create(void) {
+    W_DataGridIndex* idx = (W_DataGridIndex*)calloc(1, sizeof(W_DataGridIndex));
+    if (!idx) return NULL;
+    pthread_mutex_init(&idx->lock, NULL);
+    pthread_cond_init(&idx->idle, NULL);
+    atomic_init(&idx->generation, 0u);
+    atomic_init(&idx->in_flight, 0);
+    return idx;
+}
+
+void Widget_datagrid_index_destroy(W_DataGridIndex* idx) {
+    if (!idx) return;
+
+    /* Cancel in-flight jobs and wait for them to release the index */
+    atomic_fetch_add(&idx->generation, 1u);
+    datagrid_drop_deferred(idx);
+    pthread_mutex_lock(&idx->lock);
+    while (atomic_load(&idx->in_flight) > 0) {
+        pthread_cond_wait(&idx->idle, &idx->lock);
+    }
+    pthread_mutex_unlock(&idx->lock);
+
+    free(idx->pending);
+    free(idx->front);
+    pthread_cond_destroy(&idx->idle);
+    pthread_mutex_destroy(&idx->lock);
+    free(idx);
+}
+
+void Widget_datagrid_index_request(W_DataGridIndex* idx,
+                                   const W_DataGridColumn* columns,
+                                   int column_count, int row_count,
+                                   const W_DataGridQuery* query) {
+    if (!idx || !columns || column_count <= 0 || row_count < 0) return;
+
+    DataGridJob* job = (DataGridJob*)calloc(1, sizeof(DataGridJob));
+    if (!job) return;
+    job->index = idx;
+    job->columns = columns;
+    job->column_count = column_count;
+    job->row_count = row_count;
+    job->filter_column = -1;
+
+    if (query) {
+        /* Snapshot keys, dropping out-of-range columns */
+        for (int k = 0; k < query->key_count && k < W_DATAGRID_MAX_SORT_KEYS; k++) {
+            if (query->keys[k].column < 0 || query->keys[k].column >= column_count) continue;
+            job->keys[job->key_count++] = query->keys[k];
+        }
+        if (query->filter_column < column_count) job->filter_column = query->filter_column;
+        job->fuzzy = query->fuzzy;
+        if (query->filter) {
+            /* Substring mode matches lower-cased; fuzzy keeps case (smart case) */
+            int i = 0;
+            for (; query->filter[i] && i < W_DATAGRID_FILTER_MAX - 1; i++) {
+                job->filter[i] = job->fuzzy ? query->filter[i]
+                                            : (char)tolower((unsigned char)query->filter[i]);
+            }
+            job->filter[i] = '\0';
+        }
+    }
+
+    /* New generation cancels anything still running or deferred */
+    job->gen = atomic_fetch_add(&idx->generation, 1u) + 1u;
+    atomic_fetch_add(&idx->in_flight, 1);
+    datagrid_drop_deferred(idx);
+
+    /* Queue full: keep it for the next Widget_datagrid_index_rows() */
+    idx->deferred = job;
+    datagrid_submit_deferred(idx);
+}
+
+const int* Widget_datagrid_index_rows(W_DataGridIndex* idx, int* out_count) {
+    if (!idx) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+    datagrid_submit_deferred(idx);
+
+    /* Adopt a freshly published result */
+    pthread_mutex_lock(&idx->lock);
+    if (idx->has_pending) {
+        free(idx->front);
+        idx->front = idx->pending;
+        idx->front_count = idx->pending_count;
+        memcpy(idx->front_keys, idx->pending_keys, sizeof(idx->front_keys));
+        idx->front_key_count = idx->pending_key_count;
+        idx->pending = NULL;
+        idx->has_pending = false;
+    }
+    pthread_mutex_unlock(&idx->lock);
+
+    if (out_count) *out_count = idx->front_count;
+    return idx->front;
+}
+
+bool Widget_datagrid_index_busy(const W_DataGridIndex* idx) {
+    if (!idx) return false;
+    return atomic_load(&((W_DataGridIndex*)idx)->in_flight) > 0;
+}
+
+size_t Widget_datagrid_index_bytes(W_DataGridIndex* idx) {
+    if (!idx) return 0;
+    size_t bytes = sizeof(*idx) + (size_t)idx->front_count * sizeof(int);
+    pthread_mutex_lock(&idx->lock);
+    if (idx->has_pending) bytes += (size_t)idx->pending_count * sizeof(int);
+    pthread_mutex_unlock(&idx->lock);
+    if (idx->deferred) bytes += sizeof(DataGridJob);
+    return bytes;
+}
+
+int Widget_datagrid_index_sort_dir(const W_DataGridIndex* idx, int column) {
+    if (!idx) return 0;
+    for (int k = 0; k < idx->front_key_count; k++) {
+        if (idx->front_keys[k].column == column) {
+            return idx->front_keys[k].descending ? -1 : 1;
+        }
+    }
+    return 0;
+}
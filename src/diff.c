@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Prop diffing (see diff.h)
+ */
+
+#include <cels-widgets/diff.h>
+#include <cels-widgets/widgets.h>
+#include <flecs.h>
+#include <string.h>
+
+/* FNV-1a over raw bytes; 0 is reserved for "never applied" */
+static uint64_t props_hash(const void* data, size_t size) {
+    const unsigned char* b = (const unsigned char*)data;
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        h ^= b[i];
+        h *= 0x100000001B3ull;
+    }
+    return h ? h : 1;
+}
+
+W_PropDiff w_prop_diff(cels_entity_t component_id, const void* props, size_t size,
+                       const void** live) {
+    CELS_Context* ctx = cels_get_context();
+    ecs_world_t* world = cels_get_world(ctx);
+    cels_entity_t entity = cels_get_current_entity();
+    if (!world || entity == 0 || component_id == 0) return W_PROP_NEW;
+
+    uint64_t h = props_hash(props, size);
+    cel_register(W_PropHashes);
+    const W_PropHashes* cur = (const W_PropHashes*)ecs_get_id(world, entity, W_PropHashes_id);
+    W_PropHashes next = cur ? *cur : (W_PropHashes){0};
+
+    int slot = -1;
+    for (int i = 0; i < W_PROP_SLOTS; i++) {
+        if (next.component[i] == component_id) { slot = i; break; }
+        if (slot < 0 && next.component[i] == 0) slot = i;
+    }
+
+    bool has = ecs_has_id(world, entity, component_id);
+    bool same = slot >= 0 && next.component[slot] == component_id && next.hash[slot] == h;
+    if (has && same) return W_PROP_SAME;
+
+    /* Out of slots: no record, so every frame rewrites the named fields
+     * (values equal, other fields untouched) -- redundant, never wrong */
+    if (slot >= 0) {
+        next.component[slot] = component_id;
+        next.hash[slot] = h;
+        ecs_set_id(world, entity, W_PropHashes_id, sizeof(W_PropHashes), &next);
+    }
+
+    /* Fetched after the hash write, which may have moved the entity */
+    *live = has ? ecs_get_id(world, entity, component_id) : NULL;
+    return *live ? W_PROP_CHANGED : W_PROP_NEW;
+}
+
+void w_prop_write(cels_entity_t component_id, const void* value, size_t size) {
+    CELS_Context* ctx = cels_get_context();
+    ecs_world_t* world = cels_get_world(ctx);
+    cels_entity_t entity = cels_get_current_entity();
+    if (!world || entity == 0) return;
+    ecs_set_id(world, entity, component_id, size, value);
+}
+
+bool w_memo_hit(const void* props, size_t size) {
+    CELS_Context* ctx = cels_get_context();
+    ecs_world_t* world = cels_get_world(ctx);
+    cels_entity_t entity = cels_get_current_entity();
+    if (!world || entity == 0) return false;
+
+    uint64_t h = props_hash(props, size);
+
+    cel_register(W_Memo);
+    const W_Memo* memo = (const W_Memo*)ecs_get_id(world, entity, W_Memo_id);
+    if (memo && memo->props_hash == h) return true;
+
+    W_Memo next = { .props_hash = h };
+    ecs_set_id(world, entity, W_Memo_id, sizeof(W_Memo), &next);
+    return false;
+}
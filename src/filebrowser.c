@@ -0,0 +1,570 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Directory listing (background scan + sort)
+ *
+ * Each Widget_dir_open() starts a DirScan on the job pool:
+ *
+ *   1. Read: getdents64 in 64 KiB batches (readdir elsewhere), statx per
+ *      entry for size/mtime. Entries are appended to fixed 4096-entry
+ *      chunks and names to 64 KiB blocks, so nothing the UI can see ever
+ *      moves. After each batch the entry count is published with a
+ *      release store -- the layout shows entries as they arrive.
+ *   2. Sort: when the read finishes, merge sort a permutation (directories
+ *      first, then the active key) and hand it to the UI under the lock.
+ *
+ * The UI thread shows the sorted prefix followed by any entries that
+ * arrived after the snapshot, so a million-entry directory never blocks
+ * a frame. Opening another directory cancels the running scan; scans are
+ * refcounted so a worker can finish safely after the listing moved on.
+ * When the job queue is full the scan or sort is not run inline: it stays
+ * flagged on the listing and is submitted again on the next
+ * Widget_dir_count() (every frame the browser is laid out).
+ */
+
+#define _GNU_SOURCE
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/jobs.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#define W_DIR_USE_GETDENTS 1
+#else
+#define W_DIR_USE_GETDENTS 0
+#endif
+
+/* Entries per chunk (power of two) and max chunks: 16M entries */
+#define W_DIR_CHUNK_SHIFT 12
+#define W_DIR_CHUNK_SIZE (1 << W_DIR_CHUNK_SHIFT)
+#define W_DIR_MAX_CHUNKS 4096
+
+/* getdents64 buffer and name block size */
+#define W_DIR_BATCH_BYTES (64 * 1024)
+#define W_DIR_NAME_BLOCK (64 * 1024)
+
+/* ============================================================================
+ * Scan State
+ * ============================================================================ */
+
+typedef struct DirNameBlock {
+    struct DirNameBlock* next;
+    size_t used;
+    char data[W_DIR_NAME_BLOCK];
+} DirNameBlock;
+
+typedef struct DirScan {
+    atomic_int refs;
+    atomic_bool cancel;
+    atomic_bool done;               /* Read + final sort finished */
+    atomic_int count;               /* Published entries (release/acquire) */
+    atomic_int error;               /* errno from opening the directory */
+
+    W_DirEntry* chunks[W_DIR_MAX_CHUNKS];
+    DirNameBlock* names;            /* Worker-owned until the scan is freed */
+
+    /* Sort request + worker -> UI handoff (guarded by lock) */
+    pthread_mutex_t lock;
+    unsigned sort_gen;
+    int sort_key;
+    bool descending;
+    int* pending;
+    int pending_count;
+    bool has_pending;
+
+    char path[W_DIR_PATH_MAX];
+} DirScan;
+
+struct W_DirListing {
+    DirScan* scan;                  /* Current scan (listing holds one ref) */
+    int sort_key;
+    bool descending;
+
+    /* Adopted order (UI thread only) */
+    int* order;
+    int order_count;
+
+    /* Jobs the queue had no room for, resubmitted from Widget_dir_count */
+    bool scan_deferred;
+    bool sort_deferred;
+};
+
+static void dir_scan_release(DirScan* scan) {
+    if (!scan || atomic_fetch_sub(&scan->refs, 1) != 1) return;
+    for (int c = 0; c < W_DIR_MAX_CHUNKS && scan->chunks[c]; c++) free(scan->chunks[c]);
+    while (scan->names) {
+        DirNameBlock* next = scan->names->next;
+        free(scan->names);
+        scan->names = next;
+    }
+    free(scan->pending);
+    pthread_mutex_destroy(&scan->lock);
+    free(scan);
+}
+
+static W_DirEntry* dir_scan_entry(DirScan* scan, int i) {
+    return &scan->chunks[i >> W_DIR_CHUNK_SHIFT][i & (W_DIR_CHUNK_SIZE - 1)];
+}
+
+/* ============================================================================
+ * Read
+ * ============================================================================ */
+
+static const char* dir_intern_name(DirScan* scan, const char* name, size_t len) {
+    if (!scan->names || scan->names->used + len + 1 > W_DIR_NAME_BLOCK) {
+        DirNameBlock* b = (DirNameBlock*)malloc(sizeof(DirNameBlock));
+        if (!b) return NULL;
+        b->next = scan->names;
+        b->used = 0;
+        scan->names = b;
+    }
+    char* dst = scan->names->data + scan->names->used;
+    memcpy(dst, name, len);
+    dst[len] = '\0';
+    scan->names->used += len + 1;
+    return dst;
+}
+
+/* Fill entry n (not yet visible). Returns 1 = appended, 0 = skipped
+ * ("." / ".."), -1 = out of space. */
+static int dir_append(DirScan* scan, int dir_fd, int n, const char* name, int d_type) {
+    size_t len = strlen(name);
+    if (len == 0 || (name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.')))) {
+        return 0;
+    }
+    int c = n >> W_DIR_CHUNK_SHIFT;
+    if (c >= W_DIR_MAX_CHUNKS) return -1;
+    if (!scan->chunks[c]) {
+        scan->chunks[c] = (W_DirEntry*)malloc(sizeof(W_DirEntry) * W_DIR_CHUNK_SIZE);
+        if (!scan->chunks[c]) return -1;
+    }
+
+    W_DirEntry* e = dir_scan_entry(scan, n);
+    e->name = dir_intern_name(scan, name, len);
+    if (!e->name) return -1;
+    e->size = 0;
+    e->mtime = 0;
+    e->type = W_DIRENT_OTHER;
+    bool have_stat = false;
+
+#if defined(STATX_TYPE)
+    struct statx stx;
+    if (statx(dir_fd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC,
+              STATX_TYPE | STATX_SIZE | STATX_MTIME, &stx) == 0) {
+        have_stat = true;
+        e->size = (long long)stx.stx_size;
+        e->mtime = (long long)stx.stx_mtime.tv_sec;
+        if (S_ISDIR(stx.stx_mode)) e->type = W_DIRENT_DIR;
+        else if (S_ISLNK(stx.stx_mode)) e->type = W_DIRENT_LINK;
+        else if (S_ISREG(stx.stx_mode)) e->type = W_DIRENT_FILE;
+    }
+#else
+    struct stat st;
+    if (fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+        have_stat = true;
+        e->size = (long long)st.st_size;
+        e->mtime = (long long)st.st_mtime;
+        if (S_ISDIR(st.st_mode)) e->type = W_DIRENT_DIR;
+        else if (S_ISLNK(st.st_mode)) e->type = W_DIRENT_LINK;
+        else if (S_ISREG(st.st_mode)) e->type = W_DIRENT_FILE;
+    }
+#endif
+    /* stat failed (raced with unlink, no permission): fall back to d_type */
+    if (!have_stat) {
+        if (d_type == DT_DIR) e->type = W_DIRENT_DIR;
+        else if (d_type == DT_LNK) e->type = W_DIRENT_LINK;
+        else if (d_type == DT_REG) e->type = W_DIRENT_FILE;
+    }
+    return 1;
+}
+
+#if W_DIR_USE_GETDENTS
+struct dir_linux_dirent64 {
+    unsigned long long d_ino;
+    long long d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+#endif
+
+static void dir_read(DirScan* scan) {
+    int fd = open(scan->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        atomic_store(&scan->error, errno);
+        return;
+    }
+
+    int n = 0;
+    bool full = false;
+#if W_DIR_USE_GETDENTS
+    char* buf = (char*)malloc(W_DIR_BATCH_BYTES);
+    if (!buf) {
+        close(fd);
+        atomic_store(&scan->error, ENOMEM);
+        return;
+    }
+    while (!full && !atomic_load_explicit(&scan->cancel, memory_order_relaxed)) {
+        long got = syscall(SYS_getdents64, fd, buf, W_DIR_BATCH_BYTES);
+        if (got <= 0) break;
+        for (long off = 0; off < got;) {
+            struct dir_linux_dirent64* d = (struct dir_linux_dirent64*)(buf + off);
+            off += d->d_reclen;
+            int r = dir_append(scan, fd, n, d->d_name, d->d_type);
+            if (r < 0) { full = true; break; }
+            n += r;
+        }
+        atomic_store_explicit(&scan->count, n, memory_order_release);
+    }
+    free(buf);
+    close(fd);
+#else
+    DIR* dir = fdopendir(fd);
+    if (!dir) {
+        atomic_store(&scan->error, errno);
+        close(fd);
+        return;
+    }
+    struct dirent* d;
+    while (!full && (d = readdir(dir)) != NULL) {
+        int r = dir_append(scan, dirfd(dir), n, d->d_name, d->d_type);
+        if (r < 0) { full = true; break; }
+        n += r;
+        /* Publish in batches like the getdents path */
+        if (r && (n & 1023) == 0) {
+            atomic_store_explicit(&scan->count, n, memory_order_release);
+            if (atomic_load_explicit(&scan->cancel, memory_order_relaxed)) break;
+        }
+    }
+    atomic_store_explicit(&scan->count, n, memory_order_release);
+    closedir(dir);
+#endif
+}
+
+/* ============================================================================
+ * Sort
+ * ============================================================================ */
+
+typedef struct DirSortCtx {
+    DirScan* scan;
+    int key;
+    bool descending;
+} DirSortCtx;
+
+static int dir_compare(const DirSortCtx* ctx, int a, int b) {
+    const W_DirEntry* ea = dir_scan_entry(ctx->scan, a);
+    const W_DirEntry* eb = dir_scan_entry(ctx->scan, b);
+    /* Directories first regardless of direction */
+    bool da = ea->type == W_DIRENT_DIR, db = eb->type == W_DIRENT_DIR;
+    if (da != db) return da ? -1 : 1;
+
+    int c = 0;
+    if (ctx->key == W_DIR_SORT_SIZE) {
+        c = (ea->size > eb->size) - (ea->size < eb->size);
+    } else if (ctx->key == W_DIR_SORT_MTIME) {
+        c = (ea->mtime > eb->mtime) - (ea->mtime < eb->mtime);
+    }
+    if (c == 0) {
+        c = strcasecmp(ea->name, eb->name);
+        if (c == 0) c = strcmp(ea->name, eb->name);
+    }
+    return ctx->descending ? -c : c;
+}
+
+/* Bottom-up merge sort of [0, count). Returns the buffer holding the result
+ * (rows or tmp), or NULL when cancelled. */
+static int* dir_sort(const DirSortCtx* ctx, int* rows, int* tmp, int count) {
+    int* src = rows;
+    int* dst = tmp;
+    for (int width = 1; width < count; width *= 2) {
+        if (atomic_load_explicit(&ctx->scan->cancel, memory_order_relaxed)) return NULL;
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                dst[k++] = dir_compare(ctx, src[j], src[i]) < 0 ? src[j++] : src[i++];
+            }
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        int* t = src; src = dst; dst = t;
+    }
+    return src;
+}
+
+/* Sort the entries read so far with the latest requested key and publish.
+ * Returns false if a newer sort request arrived meanwhile. */
+static bool dir_sort_publish(DirScan* scan, bool finish) {
+    pthread_mutex_lock(&scan->lock);
+    unsigned gen = scan->sort_gen;
+    DirSortCtx ctx = { .scan = scan, .key = scan->sort_key, .descending = scan->descending };
+    pthread_mutex_unlock(&scan->lock);
+
+    int count = atomic_load_explicit(&scan->count, memory_order_acquire);
+    int* rows = (int*)malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    int* tmp = (int*)malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    int* result = NULL;
+    if (rows && tmp) {
+        for (int i = 0; i < count; i++) rows[i] = i;
+        result = dir_sort(&ctx, rows, tmp, count);
+    }
+
+    bool current;
+    pthread_mutex_lock(&scan->lock);
+    current = (gen == scan->sort_gen);
+    if (current && result) {
+        free(scan->pending);
+        scan->pending = result;
+        scan->pending_count = count;
+        scan->has_pending = true;
+    } else {
+        result = NULL;
+    }
+    /* `done` flips under the lock so a concurrent set_sort either sees it
+     * (and queues its own sort) or bumps sort_gen before this check */
+    if (finish && current) atomic_store(&scan->done, true);
+    pthread_mutex_unlock(&scan->lock);
+
+    if (rows != result) free(rows);
+    if (tmp != result) free(tmp);
+    return current || atomic_load_explicit(&scan->cancel, memory_order_relaxed);
+}
+
+/* ============================================================================
+ * Jobs
+ * ============================================================================ */
+
+static void dir_scan_job(void* arg) {
+    DirScan* scan = (DirScan*)arg;
+    dir_read(scan);
+    /* Re-sort until no newer sort request raced with this one */
+    while (!dir_sort_publish(scan, true)) {}
+    atomic_store(&scan->done, true);
+    dir_scan_release(scan);
+}
+
+static void dir_sort_job(void* arg) {
+    DirScan* scan = (DirScan*)arg;
+    dir_sort_publish(scan, false);
+    dir_scan_release(scan);
+}
+
+/* Submit deferred jobs. The job's scan reference is taken only once the
+ * queue accepts it; the listing's own reference keeps the scan alive
+ * meanwhile. A pending scan sorts when it finishes, so a deferred sort
+ * waits for it. */
+static void dir_submit_deferred(W_DirListing* dl) {
+    DirScan* scan = dl->scan;
+    if (!scan) return;
+    if (dl->scan_deferred) {
+        atomic_fetch_add(&scan->refs, 1);
+        if (w_jobs_submit(dir_scan_job, scan)) {
+            dl->scan_deferred = false;
+            dl->sort_deferred = false;
+        } else {
+            atomic_fetch_sub(&scan->refs, 1);
+        }
+        return;
+    }
+    if (dl->sort_deferred) {
+        atomic_fetch_add(&scan->refs, 1);
+        if (w_jobs_submit(dir_sort_job, scan)) {
+            dl->sort_deferred = false;
+        } else {
+            atomic_fetch_sub(&scan->refs, 1);
+        }
+    }
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_DirListing* Widget_dir_create(void) {
+    return (W_DirListing*)calloc(1, sizeof(W_DirListing));
+}
+
+void Widget_dir_destroy(W_DirListing* dl) {
+    if (!dl) return;
+    if (dl->scan) {
+        atomic_store(&dl->scan->cancel, true);
+        dir_scan_release(dl->scan);
+    }
+    free(dl->order);
+    free(dl);
+}
+
+bool Widget_dir_open(W_DirListing* dl, const char* path) {
+    if (!dl || !path || strlen(path) >= W_DIR_PATH_MAX) return false;
+
+    DirScan* scan = (DirScan*)calloc(1, sizeof(DirScan));
+    if (!scan) return false;
+    atomic_init(&scan->refs, 1);    /* listing; the job adds its own */
+    atomic_init(&scan->cancel, false);
+    atomic_init(&scan->done, false);
+    atomic_init(&scan->count, 0);
+    atomic_init(&scan->error, 0);
+    pthread_mutex_init(&scan->lock, NULL);
+    scan->sort_key = dl->sort_key;
+    scan->descending = dl->descending;
+    strcpy(scan->path, path);
+
+    /* Supersede the previous scan */
+    if (dl->scan) {
+        atomic_store(&dl->scan->cancel, true);
+        dir_scan_release(dl->scan);
+    }
+    dl->scan = scan;
+    free(dl->order);
+    dl->order = NULL;
+    dl->order_count = 0;
+
+    dl->scan_deferred = true;
+    dl->sort_deferred = false;
+    dir_submit_deferred(dl);
+    return true;
+}
+
+bool Widget_dir_enter(W_DirListing* dl, int index) {
+    const W_DirEntry* e = Widget_dir_entry(dl, index);
+    if (!e) return false;
+    char path[W_DIR_PATH_MAX];
+    if (Widget_dir_entry_path(dl, index, path, sizeof(path)) >= (int)sizeof(path)) return false;
+    if (e->type == W_DIRENT_LINK) {
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) return false;
+    } else if (e->type != W_DIRENT_DIR) {
+        return false;
+    }
+    return Widget_dir_open(dl, path);
+}
+
+bool Widget_dir_up(W_DirListing* dl) {
+    if (!dl || !dl->scan) return false;
+    char path[W_DIR_PATH_MAX];
+    strcpy(path, dl->scan->path);
+    size_t len = strlen(path);
+    while (len > 1 && path[len - 1] == '/') path[--len] = '\0';
+    char* slash = strrchr(path, '/');
+    if (!slash) return Widget_dir_open(dl, strcmp(path, ".") == 0 ? ".." : ".");
+    if (slash == path) {
+        if (len == 1) return false; /* Already at "/" */
+        path[1] = '\0';
+    } else {
+        *slash = '\0';
+    }
+    return Widget_dir_open(dl, path);
+}
+
+const char* Widget_dir_path(const W_DirListing* dl) {
+    return (dl && dl->scan) ? dl->scan->path : "";
+}
+
+int Widget_dir_count(W_DirListing* dl) {
+    if (!dl || !dl->scan) return 0;
+    DirScan* scan = dl->scan;
+    dir_submit_deferred(dl);
+
+    /* Adopt a freshly published order */
+    pthread_mutex_lock(&scan->lock);
+    if (scan->has_pending) {
+        free(dl->order);
+        dl->order = scan->pending;
+        dl->order_count = scan->pending_count;
+        scan->pending = NULL;
+        scan->has_pending = false;
+    }
+    pthread_mutex_unlock(&scan->lock);
+
+    return atomic_load_explicit(&scan->count, memory_order_acquire);
+}
+
+size_t Widget_dir_bytes(W_DirListing* dl) {
+    if (!dl) return 0;
+    size_t bytes = sizeof(*dl) + (size_t)dl->order_count * sizeof(int);
+    DirScan* scan = dl->scan;
+    if (!scan) return bytes;
+
+    int count = atomic_load_explicit(&scan->count, memory_order_acquire);
+    int chunks = (count + W_DIR_CHUNK_SIZE - 1) >> W_DIR_CHUNK_SHIFT;
+    bytes += sizeof(*scan) + (size_t)chunks * W_DIR_CHUNK_SIZE * sizeof(W_DirEntry);
+
+    /* The worker owns the name blocks until the scan is done */
+    if (atomic_load_explicit(&scan->done, memory_order_acquire)) {
+        for (const DirNameBlock* b = scan->names; b; b = b->next) bytes += sizeof(*b);
+    }
+    pthread_mutex_lock(&scan->lock);
+    if (scan->has_pending) bytes += (size_t)scan->pending_count * sizeof(int);
+    pthread_mutex_unlock(&scan->lock);
+    return bytes;
+}
+
+const W_DirEntry* Widget_dir_entry(const W_DirListing* dl, int index) {
+    if (!dl || !dl->scan || index < 0) return NULL;
+    if (index >= atomic_load_explicit(&dl->scan->count, memory_order_acquire)) return NULL;
+    int src = index < dl->order_count ? dl->order[index] : index;
+    return dir_scan_entry(dl->scan, src);
+}
+
+int Widget_dir_entry_path(const W_DirListing* dl, int index, char* buf, int buf_size) {
+    const W_DirEntry* e = Widget_dir_entry(dl, index);
+    if (!e || !buf || buf_size <= 0) return -1;
+    const char* dir = dl->scan->path;
+    size_t len = strlen(dir);
+    const char* sep = (len > 0 && dir[len - 1] == '/') ? "" : "/";
+    return snprintf(buf, (size_t)buf_size, "%s%s%s", dir, sep, e->name);
+}
+
+bool Widget_dir_scanning(const W_DirListing* dl) {
+    return dl && dl->scan && !atomic_load(&dl->scan->done);
+}
+
+int Widget_dir_error(const W_DirListing* dl) {
+    return (dl && dl->scan) ? atomic_load(&dl->scan->error) : 0;
+}
+
+void Widget_dir_set_sort(W_DirListing* dl, int sort_key, bool descending) {
+    if (!dl) return;
+    dl->sort_key = sort_key;
+    dl->descending = descending;
+    DirScan* scan = dl->scan;
+    if (!scan) return;
+
+    pthread_mutex_lock(&scan->lock);
+    scan->sort_gen++;
+    scan->sort_key = sort_key;
+    scan->descending = descending;
+    bool done = atomic_load(&scan->done);
+    pthread_mutex_unlock(&scan->lock);
+
+    /* Still reading: the scan job sorts with the new key when it finishes */
+    if (done) {
+        dl->sort_deferred = true;
+        dir_submit_deferred(dl);
+    }
+}
@@ -35,7 +35,9 @@
 
 #include <cels-widgets/widgets.h>
 #include <cels-widgets/input.h>
+#include <cels-widgets/profile.h>
 #include <flecs.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Backend quit guard -- provided by the backend input module (e.g., tui_input.c).
@@ -50,6 +52,54 @@ extern void tui_input_set_quit_guard(bool (*guard_fn)(void));
 
 static CELS_Input s_prev_input = {0};
 
+/* ============================================================================
+ * Query Cache
+ * ============================================================================ */
+
+/* A world's queries die with it, and the next world may be allocated at
+ * the same address; the generation tells the two apart */
+static unsigned s_query_generation = 1;
+static ecs_world_t* s_query_world = NULL;
+
+static void query_cache_world_fini(ecs_world_t* world, void* ctx) {
+    (void)world;
+    (void)ctx;
+    s_query_generation++;
+    s_query_world = NULL;
+}
+
+ecs_query_t* widgets_query_cached(W_QueryCache* cache, ecs_world_t* world,
+                                  const ecs_query_desc_t* desc) {
+    if (s_query_world != world) {
+        s_query_world = world;
+        ecs_atfini(world, query_cache_world_fini, NULL);
+    }
+    if (cache->world != world || cache->generation != s_query_generation || !cache->query) {
+        cache->world = world;
+        cache->generation = s_query_generation;
+        cache->query = ecs_query_init(world, desc);
+    }
+    return cache->query;
+}
+
+/* ============================================================================
+ * Keyboard Ownership
+ * ============================================================================ */
+
+/* Keyboard-driven widgets (file browser, ...) take keys only while
+ * selected, focused, or holding the focus ring. With several on screen,
+ * ungated passes would move all of them at once. */
+static bool widget_owns_keys(ecs_world_t* world, ecs_entity_t entity) {
+    const W_Selectable* sel = (const W_Selectable*)ecs_get_id(
+        world, entity, W_Selectable_id);
+    if (sel && sel->selected) return true;
+    const W_InteractState* ist = (const W_InteractState*)ecs_get_id(
+        world, entity, W_InteractState_id);
+    if (ist && ist->focused) return true;
+    cel_register(W_FocusState);
+    return W_FocusState.focused_entity == entity;
+}
+
 /* ============================================================================
  * Navigation Scope Management
  * ============================================================================ */
@@ -87,6 +137,7 @@ cels_entity_t widgets_nav_scope_active(void) {
 #define MAX_NAV_CHILDREN 64
 
 static void process_navigation_groups(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     cel_register(W_NavigationScope);
     cel_register(W_Selectable);
     cel_register(W_InteractState);
@@ -94,7 +145,8 @@ static void process_navigation_groups(ecs_world_t* world, const CELS_Input* inpu
     cel_register(W_Collapsible);
 
     /* Query all entities with W_NavigationScope */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_NavigationScope_id }}
     });
     if (!q) return;
@@ -173,15 +225,20 @@ static void process_navigation_groups(ecs_world_t* world, const CELS_Input* inpu
                 ecs_entity_t child = children[i];
                 bool is_selected = (i == scope->selected_index);
 
-                /* Set W_Selectable.selected */
-                W_Selectable sel_val = { .selected = is_selected };
-                ecs_set_id(world, child, W_Selectable_id,
-                           sizeof(W_Selectable), &sel_val);
+                /* Set W_Selectable.selected (only on change: radio groups
+                 * and other observers react to every OnSet) */
+                const W_Selectable* cur = (const W_Selectable*)ecs_get_id(
+                    world, child, W_Selectable_id);
+                if (!cur || cur->selected != is_selected) {
+                    W_Selectable sel_val = { .selected = is_selected };
+                    ecs_set_id(world, child, W_Selectable_id,
+                               sizeof(W_Selectable), &sel_val);
+                }
 
                 /* Set W_InteractState.selected (preserve other fields) */
                 const W_InteractState* ist = (const W_InteractState*)ecs_get_id(
                     world, child, W_InteractState_id);
-                if (ist) {
+                if (ist && ist->selected != is_selected) {
                     W_InteractState new_ist = *ist;
                     new_ist.selected = is_selected;
                     ecs_set_id(world, child, W_InteractState_id,
@@ -201,21 +258,19 @@ static void process_navigation_groups(ecs_world_t* world, const CELS_Input* inpu
                     btn->on_press();
                 }
 
-                /* Collapsible toggle: Enter/Space toggles collapsed state */
+                /* Collapsible toggle: Enter/Space toggles expansion */
                 if (ecs_has_id(world, selected_child, W_Collapsible_id)) {
-                    W_Collapsible* col = (W_Collapsible*)ecs_get_mut_id(
-                        world, selected_child, W_Collapsible_id);
-                    if (col) {
-                        col->collapsed = !col->collapsed;
-                        ecs_set_id(world, selected_child, W_Collapsible_id,
-                                   sizeof(W_Collapsible), col);
+                    W_UiState* ui = Widget_ui_state_find(world, selected_child);
+                    if (!ui) {
+                        /* No state yet: expanded, as the layout draws it */
+                        ui = Widget_ui_state(world, selected_child);
+                        if (ui) ui->expanded = true;
                     }
+                    if (ui) ui->expanded = !ui->expanded;
                 }
             }
         }
     }
-
-    ecs_query_fini(q);
 }
 
 /* ============================================================================
@@ -273,6 +328,7 @@ static ecs_entity_t find_nav_scope_under(ecs_world_t* world, ecs_entity_t parent
 }
 
 static void process_split_pane_navigation(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     /* Only act on Ctrl+Arrow edge (not held) */
     if (!input->has_raw_key) return;
     if (input->raw_key < CELS_KEY_CTRL_UP || input->raw_key > CELS_KEY_CTRL_LEFT) return;
@@ -282,7 +338,8 @@ static void process_split_pane_navigation(ecs_world_t* world, const CELS_Input*
     cel_register(W_NavigationScope);
 
     /* Query all W_SplitPane entities */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_SplitPane_id }}
     });
     if (!q) return;
@@ -362,8 +419,6 @@ static void process_split_pane_navigation(ecs_world_t* world, const CELS_Input*
             }
         }
     }
-
-    ecs_query_fini(q);
 }
 
 /* ============================================================================
@@ -375,11 +430,13 @@ static void process_split_pane_navigation(ecs_world_t* world, const CELS_Input*
  * ============================================================================ */
 
 static void process_scrollable_navigation(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     cel_register(W_ScrollContainer);
     cel_register(W_Scrollable);
     cel_register(W_NavigationScope);
 
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_ScrollContainer_id }}
     });
     if (!q) return;
@@ -395,16 +452,13 @@ static void process_scrollable_navigation(ecs_world_t* world, const CELS_Input*
         for (int e = 0; e < qit.count; e++) {
             ecs_entity_t sc_entity = qit.entities[e];
 
-            W_Scrollable* scr = (W_Scrollable*)ecs_get_mut_id(
+            const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(
                 world, sc_entity, W_Scrollable_id);
             if (!scr || scr->visible_count <= 0) continue;
 
-            const W_ScrollContainer* sc = (const W_ScrollContainer*)ecs_get_id(
-                world, sc_entity, W_ScrollContainer_id);
-            (void)sc;
-
             int visible = scr->visible_count;
             int total = scr->total_count;
+            int offset = Widget_scroll_offset(world, sc_entity);
 
             /* --- Auto-scroll to selected child --- */
             /* Find NavigationScope under this scrollable (child or grandchild) */
@@ -415,37 +469,612 @@ static void process_scrollable_navigation(ecs_world_t* world, const CELS_Input*
                 if (scope) {
                     int sel = scope->selected_index;
                     /* Scroll up to show selected */
-                    if (sel < scr->scroll_offset) {
-                        scr->scroll_offset = sel;
+                    if (sel < offset) {
+                        offset = sel;
                     }
                     /* Scroll down to show selected */
-                    if (sel >= scr->scroll_offset + visible) {
-                        scr->scroll_offset = sel - visible + 1;
+                    if (sel >= offset + visible) {
+                        offset = sel - visible + 1;
                     }
                 }
             }
 
             /* --- Keyboard scroll (edge-detected) --- */
             if (pgup_edge) {
-                scr->scroll_offset -= visible;
+                offset -= visible;
             }
             if (pgdn_edge) {
-                scr->scroll_offset += visible;
+                offset += visible;
             }
             if (home_edge) {
-                scr->scroll_offset = 0;
+                offset = 0;
             }
             if (end_edge && total > visible) {
-                scr->scroll_offset = total - visible;
+                offset = total - visible;
+            }
+
+            /* Clamped to [0, total - visible] */
+            Widget_scroll_set(world, sc_entity, offset);
+        }
+    }
+}
+
+/* ============================================================================
+ * Command Palette Input
+ *
+ * While a W_CommandPalette is visible it owns the keyboard:
+ *   - Printable keys / Backspace edit the query (resets selection)
+ *   - Up/Down move the highlighted result (wraps)
+ *   - Enter dismisses the palette, then runs the highlighted command
+ *   - Escape dismisses
+ * Returns true when input was consumed so other processing is skipped.
+ * ============================================================================ */
+
+static bool process_command_palette(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
+    cel_register(W_CommandPalette);
+    cel_register(W_CommandPaletteState);
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_CommandPalette_id }}
+    });
+    if (!q) return false;
+
+    bool escape_pressed = (input->has_raw_key && input->raw_key == 27 &&
+                           !(s_prev_input.has_raw_key && s_prev_input.raw_key == 27));
+    bool up_edge   = (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f);
+    bool down_edge = (input->axis_left[1] > 0.5f && s_prev_input.axis_left[1] <= 0.5f);
+    /* Space may also raise button_accept -- it is query text here */
+    bool accept_edge = (input->button_accept && !s_prev_input.button_accept &&
+                        !(input->has_raw_key && input->raw_key == ' '));
+
+    bool consumed = false;
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t entity = qit.entities[e];
+            const W_CommandPalette* pal = (const W_CommandPalette*)ecs_get_id(
+                world, entity, W_CommandPalette_id);
+            W_CommandPaletteState* st = (W_CommandPaletteState*)ecs_get_mut_id(
+                world, entity, W_CommandPaletteState_id);
+            if (!pal || !st) continue;
+
+            if (!pal->visible) {
+                if (st->was_visible) {
+                    st->was_visible = false;
+                    ecs_set_id(world, entity, W_CommandPaletteState_id,
+                               sizeof(W_CommandPaletteState), st);
+                }
+                continue;
             }
 
-            /* Write back (ScrollClampSystem enforces bounds at PostUpdate) */
-            ecs_set_id(world, sc_entity, W_Scrollable_id,
-                       sizeof(W_Scrollable), scr);
+            /* Fresh query each time the palette opens */
+            if (!st->was_visible) {
+                memset(st->query, 0, sizeof(st->query));
+                st->query_len = 0;
+                st->selected = 0;
+                st->was_visible = true;
+            }
+            consumed = true;
+
+            if (escape_pressed) {
+                ecs_set_id(world, entity, W_CommandPaletteState_id,
+                           sizeof(W_CommandPaletteState), st);
+                if (pal->on_dismiss) pal->on_dismiss();
+                continue;
+            }
+
+            /* Query editing (same key semantics as the text input system) */
+            if (input->has_raw_key && input->raw_key >= 32 && input->raw_key <= 126 &&
+                st->query_len < (int)sizeof(st->query) - 1) {
+                st->query[st->query_len++] = (char)input->raw_key;
+                st->query[st->query_len] = '\0';
+                st->selected = 0;
+            }
+            if (input->key_backspace && st->query_len > 0) {
+                st->query[--st->query_len] = '\0';
+                st->selected = 0;
+            }
+
+            int result_count = 0;
+            const int* results = Widget_palette_results(st->query, pal->max_results,
+                                                        &result_count);
+            if (result_count > 0) {
+                if (up_edge) st->selected = (st->selected - 1 + result_count) % result_count;
+                if (down_edge) st->selected = (st->selected + 1) % result_count;
+                if (st->selected >= result_count) st->selected = result_count - 1;
+            } else {
+                st->selected = 0;
+            }
+
+            ecs_set_id(world, entity, W_CommandPaletteState_id,
+                       sizeof(W_CommandPaletteState), st);
+
+            if (accept_edge && result_count > 0) {
+                int command = results[st->selected];
+                /* Dismiss first so the command may open another overlay */
+                if (pal->on_dismiss) pal->on_dismiss();
+                Widget_palette_run(command);
+            }
         }
     }
 
-    ecs_query_fini(q);
+    return consumed;
+}
+
+/* Quit guard helper: any visible palette takes raw keys (incl. 'q') */
+static bool command_palette_is_visible(ecs_world_t* world) {
+    cel_register(W_CommandPalette);
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_CommandPalette_id }}
+    });
+    if (!q) return false;
+
+    bool visible = false;
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count && !visible; e++) {
+            const W_CommandPalette* pal = (const W_CommandPalette*)ecs_get_id(
+                world, qit.entities[e], W_CommandPalette_id);
+            if (pal && pal->visible) visible = true;
+        }
+    }
+    return visible;
+}
+
+/* ============================================================================
+ * DataGrid Navigation
+ *
+ * For each W_DataGrid that owns the keyboard (selected or focused):
+ *   - Left/Right: shift the first scrolled column (frozen columns stay)
+ *   - PgUp/PgDn/Home/End: page the row window
+ * Bounds are re-clamped by the layout each frame.
+ * ============================================================================ */
+
+static void process_datagrid_navigation(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
+    cel_register(W_DataGrid);
+    cel_register(W_DataGridState);
+    cel_register(W_Scrollable);
+    cel_register(W_Selectable);
+    cel_register(W_InteractState);
+
+    bool left_edge  = (input->axis_left[0] < -0.5f && s_prev_input.axis_left[0] >= -0.5f);
+    bool right_edge = (input->axis_left[0] > 0.5f && s_prev_input.axis_left[0] <= 0.5f);
+    bool pgup_edge  = (input->key_page_up   && !s_prev_input.key_page_up);
+    bool pgdn_edge  = (input->key_page_down && !s_prev_input.key_page_down);
+    bool home_edge  = (input->key_home      && !s_prev_input.key_home);
+    bool end_edge   = (input->key_end       && !s_prev_input.key_end);
+    if (!left_edge && !right_edge && !pgup_edge && !pgdn_edge && !home_edge && !end_edge) {
+        return;
+    }
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_DataGrid_id }}
+    });
+    if (!q) return;
+
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t grid = qit.entities[e];
+            if (!widget_owns_keys(world, grid)) continue;
+
+            W_DataGridState* gs = (W_DataGridState*)ecs_get_mut_id(
+                world, grid, W_DataGridState_id);
+            if (gs && (left_edge || right_edge)) {
+                if (left_edge && gs->col_offset > 0) gs->col_offset--;
+                if (right_edge) gs->col_offset++;
+                ecs_set_id(world, grid, W_DataGridState_id,
+                           sizeof(W_DataGridState), gs);
+            }
+
+            const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(
+                world, grid, W_Scrollable_id);
+            if (scr && scr->visible_count > 0 &&
+                (pgup_edge || pgdn_edge || home_edge || end_edge)) {
+                int offset = Widget_scroll_offset(world, grid);
+                if (pgup_edge) offset -= scr->visible_count;
+                if (pgdn_edge) offset += scr->visible_count;
+                if (home_edge) offset = 0;
+                if (end_edge && scr->total_count > scr->visible_count) {
+                    offset = scr->total_count - scr->visible_count;
+                }
+                Widget_scroll_set(world, grid, offset);
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * Multi-Selection (ListView / DataGrid with a W_Selection)
+ *
+ * For each W_SelectionState entity that owns the keyboard (selected or focused):
+ *   - Up/Down: move the cursor, reset the anchor
+ *   - 'v': anchor at the cursor and select it; until 'v' again, Up/Down
+ *     extend like Shift+Up/Down
+ *   - Shift+Up/Down: move the cursor, add [anchor, cursor] to the selection
+ *   - Space: toggle the item under the cursor
+ *   - Ctrl+A: select every displayed item;  '*': invert displayed items
+ * Display rows map to source indices through the grid's sort/filter index
+ * or the list's fuzzy matches. Unmapped (or pure-permutation) whole-range
+ * operations go straight to the run containers; mapped ones are sorted and
+ * coalesced into runs first.
+ * ============================================================================ */
+
+/* Shift+Arrow key codes, next to the Ctrl+Arrow range. tui_input.c does
+ * not report Shift+Up/Down yet, so until it emits these the 'v' range
+ * mode is the reachable binding; both must change together. */
+#define CELS_KEY_SHIFT_UP   604
+#define CELS_KEY_SHIFT_DOWN 605
+
+static bool raw_key_edge(const CELS_Input* input, int key) {
+    return input->has_raw_key && input->raw_key == key &&
+           !(s_prev_input.has_raw_key && s_prev_input.raw_key == key);
+}
+
+/* Scroll just far enough that row is inside a page-row window */
+static void scroll_to_row(ecs_world_t* world, ecs_entity_t entity, int row, int page) {
+    int offset = Widget_scroll_offset(world, entity);
+    if (row < offset) offset = row;
+    if (row >= offset + page) offset = row - page + 1;
+    Widget_scroll_set(world, entity, offset);
+}
+
+/* Sorted copy of mapped source rows (UI thread only; grows, never shrinks) */
+static int* s_row_scratch = NULL;
+static int s_row_scratch_cap = 0;
+
+static int row_index_cmp(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void selection_apply_range(W_Selection* sel, int begin, int end, int op) {
+    if (op == 0) Widget_selection_add_range(sel, begin, end);
+    else Widget_selection_flip_range(sel, begin, end);
+}
+
+/* Apply op to display rows [lo, hi] (op: 0 = add, 1 = flip). Mapped rows
+ * are sorted and coalesced into runs, so Ctrl+A over a filtered view is
+ * one range call per run of adjacent source rows, not one per row. */
+static void selection_apply_rows(W_Selection* sel, const int* map,
+                                 int lo, int hi, int op) {
+    if (!map) {
+        selection_apply_range(sel, lo, hi + 1, op);
+        return;
+    }
+    int n = hi - lo + 1;
+    if (n > s_row_scratch_cap) {
+        int* p = (int*)realloc(s_row_scratch, sizeof(int) * (size_t)n);
+        if (!p) {
+            for (int r = lo; r <= hi; r++) selection_apply_range(sel, map[r], map[r] + 1, op);
+            return;
+        }
+        s_row_scratch = p;
+        s_row_scratch_cap = n;
+    }
+    memcpy(s_row_scratch, map + lo, sizeof(int) * (size_t)n);
+    qsort(s_row_scratch, (size_t)n, sizeof(int), row_index_cmp);
+
+    for (int i = 0; i < n;) {
+        int j = i + 1;
+        while (j < n && s_row_scratch[j] == s_row_scratch[j - 1] + 1) j++;
+        selection_apply_range(sel, s_row_scratch[i], s_row_scratch[j - 1] + 1, op);
+        i = j;
+    }
+}
+
+static void process_multi_selection(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
+    cel_register(W_SelectionState);
+    cel_register(W_ListView);
+    cel_register(W_DataGrid);
+    cel_register(W_Scrollable);
+    cel_register(W_Selectable);
+    cel_register(W_InteractState);
+
+    bool up_edge     = (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f);
+    bool down_edge   = (input->axis_left[1] > 0.5f && s_prev_input.axis_left[1] <= 0.5f);
+    bool shift_up    = raw_key_edge(input, CELS_KEY_SHIFT_UP);
+    bool shift_down  = raw_key_edge(input, CELS_KEY_SHIFT_DOWN);
+    bool space_edge  = raw_key_edge(input, ' ');
+    bool all_edge    = raw_key_edge(input, 1);   /* Ctrl+A */
+    bool invert_edge = raw_key_edge(input, '*');
+    bool range_edge  = raw_key_edge(input, 'v');
+    if (!up_edge && !down_edge && !shift_up && !shift_down &&
+        !space_edge && !all_edge && !invert_edge && !range_edge) {
+        return;
+    }
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_SelectionState_id }}
+    });
+    if (!q) return;
+
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t ent = qit.entities[e];
+            if (!widget_owns_keys(world, ent)) continue;
+
+            /* Resolve the selection and the display -> source mapping */
+            W_Selection* set = NULL;
+            const int* map = NULL;
+            int total = 0, source_count = 0;
+            const W_DataGrid* grid = (const W_DataGrid*)ecs_get_id(world, ent, W_DataGrid_id);
+            const W_ListView* list = (const W_ListView*)ecs_get_id(world, ent, W_ListView_id);
+            if (grid && grid->selection) {
+                set = grid->selection;
+                source_count = grid->row_count;
+                map = Widget_datagrid_index_rows(grid->index, &total);
+                if (!map) total = grid->row_count;
+            } else if (list && list->selection) {
+                set = list->selection;
+                source_count = list->item_count;
+                total = list->item_count;
+                if (list->fuzzy) map = Widget_fuzzy_matches(list->fuzzy, &total);
+            }
+            if (!set) continue;
+
+            W_SelectionState* ss = (W_SelectionState*)ecs_get_mut_id(
+                world, ent, W_SelectionState_id);
+            if (!ss) continue;
+            if (total <= 0) continue;
+
+            int cur = ss->cursor;
+            if (cur >= total) cur = total - 1;
+            if (cur < 0) cur = 0;
+
+            if (range_edge) {
+                ss->extending = !ss->extending;
+                if (ss->extending) {
+                    ss->anchor = cur;
+                    Widget_selection_set(set, map ? map[cur] : cur, true);
+                }
+            }
+            bool extend = shift_up || shift_down ||
+                          (ss->extending && (up_edge || down_edge));
+            if (up_edge || shift_up) cur = cur > 0 ? cur - 1 : 0;
+            if (down_edge || shift_down) cur = cur < total - 1 ? cur + 1 : total - 1;
+            if ((up_edge || down_edge) && !extend) ss->anchor = cur;
+            if (extend) {
+                int anchor = ss->anchor < total ? ss->anchor : total - 1;
+                int lo = anchor < cur ? anchor : cur;
+                int hi = anchor < cur ? cur : anchor;
+                selection_apply_rows(set, map, lo, hi, 0);
+            }
+            if (space_edge) {
+                Widget_selection_toggle(set, map ? map[cur] : cur);
+                ss->anchor = cur;
+            }
+            /* A sort-only permutation covers every row: use the range path */
+            bool whole = !map || total == source_count;
+            if (all_edge) {
+                selection_apply_rows(set, whole ? NULL : map, 0, total - 1, 0);
+            }
+            if (invert_edge) {
+                selection_apply_rows(set, whole ? NULL : map, 0, total - 1, 1);
+            }
+
+            ss->cursor = cur;
+            ecs_set_id(world, ent, W_SelectionState_id, sizeof(W_SelectionState), ss);
+
+            /* Keep the cursor inside the scroll window */
+            const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(
+                world, ent, W_Scrollable_id);
+            if (scr && scr->visible_count > 0) {
+                scroll_to_row(world, ent, cur, scr->visible_count);
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * TreeView Navigation
+ *
+ * For each W_TreeView that is selected (or has no W_Selectable at all):
+ *   - Up/Down: move the cursor one row
+ *   - Right: expand, or step into the first child when already open
+ *   - Left: collapse, or step to the parent row
+ *   - Enter: toggle an expandable row, activate a leaf
+ *   - PgUp/PgDn/Home/End: move the cursor by a page / to the ends
+ * The scroll window follows the cursor.
+ * ============================================================================ */
+
+static void process_tree_navigation(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
+    cel_register(W_TreeView);
+    cel_register(W_Scrollable);
+    cel_register(W_Selectable);
+
+    bool up_edge    = (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f);
+    bool down_edge  = (input->axis_left[1] > 0.5f && s_prev_input.axis_left[1] <= 0.5f);
+    bool left_edge  = (input->axis_left[0] < -0.5f && s_prev_input.axis_left[0] >= -0.5f);
+    bool right_edge = (input->axis_left[0] > 0.5f && s_prev_input.axis_left[0] <= 0.5f);
+    bool accept_edge = (input->button_accept && !s_prev_input.button_accept);
+    bool pgup_edge  = (input->key_page_up   && !s_prev_input.key_page_up);
+    bool pgdn_edge  = (input->key_page_down && !s_prev_input.key_page_down);
+    bool home_edge  = (input->key_home      && !s_prev_input.key_home);
+    bool end_edge   = (input->key_end       && !s_prev_input.key_end);
+    if (!up_edge && !down_edge && !left_edge && !right_edge && !accept_edge &&
+        !pgup_edge && !pgdn_edge && !home_edge && !end_edge) {
+        return;
+    }
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_TreeView_id }}
+    });
+    if (!q) return;
+
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t tree = qit.entities[e];
+            if (!widget_owns_keys(world, tree)) continue;
+
+            const W_TreeView* tv = (const W_TreeView*)ecs_get_id(
+                world, tree, W_TreeView_id);
+            if (!tv || !tv->model) continue;
+            W_UiState* ui = Widget_ui_state(world, tree);
+            if (!ui) continue;
+
+            W_TreeModel* model = tv->model;
+            int page = tv->visible_height > 0 ? tv->visible_height : 1;
+            int cur = ui->cursor;
+            const W_TreeRow* row = Widget_tree_row(model, cur);
+
+            if (row && right_edge) {
+                if (row->has_children && !row->expanded) {
+                    Widget_tree_expand(model, cur);
+                } else if (row->expanded) {
+                    cur++;
+                }
+            } else if (row && left_edge) {
+                if (row->expanded) {
+                    Widget_tree_collapse(model, cur);
+                } else {
+                    int parent = Widget_tree_parent_row(model, cur);
+                    if (parent >= 0) cur = parent;
+                }
+            } else if (row && accept_edge) {
+                if (row->has_children) {
+                    Widget_tree_toggle(model, cur);
+                } else if (tv->on_activate) {
+                    tv->on_activate(row->id);
+                }
+            }
+            if (up_edge) cur--;
+            if (down_edge) cur++;
+            if (pgup_edge) cur -= page;
+            if (pgdn_edge) cur += page;
+            if (home_edge) cur = 0;
+            if (end_edge) cur = Widget_tree_row_count(model) - 1;
+
+            int total = Widget_tree_row_count(model);
+            if (cur >= total) cur = total - 1;
+            if (cur < 0) cur = 0;
+            ui->cursor = cur;
+
+            /* Keep the cursor inside the scroll window (extent first: the
+             * offset is clamped against it) */
+            W_Scrollable* scr = (W_Scrollable*)ecs_get_mut_id(
+                world, tree, W_Scrollable_id);
+            if (scr) {
+                scr->total_count = total;
+                scr->visible_count = page;
+                ecs_set_id(world, tree, W_Scrollable_id,
+                           sizeof(W_Scrollable), scr);
+                scroll_to_row(world, tree, cur, page);
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * FileBrowser Navigation
+ *
+ * For each W_FileBrowser that owns the keyboard (selected or focused):
+ *   - Up/Down, PgUp/PgDn/Home/End: move the cursor
+ *   - Enter: open a directory (async rescan) or call on_open for a file
+ *   - Left/Backspace: go to the parent directory
+ * Changing directory resets the cursor and scroll window.
+ * ============================================================================ */
+
+static void process_file_browser_navigation(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
+    cel_register(W_FileBrowser);
+    cel_register(W_Scrollable);
+    cel_register(W_Selectable);
+    cel_register(W_InteractState);
+
+    bool up_edge    = (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f);
+    bool down_edge  = (input->axis_left[1] > 0.5f && s_prev_input.axis_left[1] <= 0.5f);
+    bool left_edge  = (input->axis_left[0] < -0.5f && s_prev_input.axis_left[0] >= -0.5f);
+    bool back_edge  = (input->key_backspace && !s_prev_input.key_backspace);
+    bool accept_edge = (input->button_accept && !s_prev_input.button_accept);
+    bool pgup_edge  = (input->key_page_up   && !s_prev_input.key_page_up);
+    bool pgdn_edge  = (input->key_page_down && !s_prev_input.key_page_down);
+    bool home_edge  = (input->key_home      && !s_prev_input.key_home);
+    bool end_edge   = (input->key_end       && !s_prev_input.key_end);
+    if (!up_edge && !down_edge && !left_edge && !back_edge && !accept_edge &&
+        !pgup_edge && !pgdn_edge && !home_edge && !end_edge) {
+        return;
+    }
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_FileBrowser_id }}
+    });
+    if (!q) return;
+
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t fb = qit.entities[e];
+            if (!widget_owns_keys(world, fb)) continue;
+
+            const W_FileBrowser* d = (const W_FileBrowser*)ecs_get_id(
+                world, fb, W_FileBrowser_id);
+            if (!d || !d->listing) continue;
+            W_UiState* ui = Widget_ui_state(world, fb);
+            if (!ui) continue;
+
+            W_DirListing* listing = d->listing;
+            int page = d->visible_height - 1;
+            if (page < 1) page = 1;
+            int cur = ui->cursor;
+            bool changed_dir = false;
+
+            if (accept_edge) {
+                const W_DirEntry* entry = Widget_dir_entry(listing, cur);
+                if (entry && Widget_dir_enter(listing, cur)) {
+                    changed_dir = true;
+                } else if (entry && entry->type != W_DIRENT_DIR && d->on_open) {
+                    char path[W_DIR_PATH_MAX];
+                    int len = Widget_dir_entry_path(listing, cur, path, sizeof(path));
+                    if (len > 0 && len < (int)sizeof(path)) d->on_open(path);
+                }
+            } else if (left_edge || back_edge) {
+                changed_dir = Widget_dir_up(listing);
+            }
+
+            int total = Widget_dir_count(listing);
+            if (changed_dir) {
+                cur = 0;
+            } else {
+                if (up_edge) cur--;
+                if (down_edge) cur++;
+                if (pgup_edge) cur -= page;
+                if (pgdn_edge) cur += page;
+                if (home_edge) cur = 0;
+                if (end_edge) cur = total - 1;
+                if (cur >= total) cur = total - 1;
+                if (cur < 0) cur = 0;
+            }
+            ui->cursor = cur;
+
+            /* Keep the cursor inside the scroll window (extent first: the
+             * offset is clamped against it) */
+            W_Scrollable* scr = (W_Scrollable*)ecs_get_mut_id(
+                world, fb, W_Scrollable_id);
+            if (scr) {
+                if (scr->total_count != total) {
+                    scr->total_count = total;
+                    ecs_set_id(world, fb, W_Scrollable_id,
+                               sizeof(W_Scrollable), scr);
+                }
+                if (changed_dir) Widget_scroll_set(world, fb, 0);
+                scroll_to_row(world, fb, cur, page);
+            }
+        }
+    }
 }
 
 /* ============================================================================
@@ -453,6 +1082,7 @@ static void process_scrollable_navigation(ecs_world_t* world, const CELS_Input*
  * ============================================================================ */
 
 static void process_modal_overlay(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     cel_register(W_Modal);
 
     /* Edge-detect Escape */
@@ -461,7 +1091,8 @@ static void process_modal_overlay(ecs_world_t* world, const CELS_Input* input) {
     if (!escape_pressed) return;
 
     /* Find visible modal with highest z_index */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_Modal_id }}
     });
     if (!q) return;
@@ -485,7 +1116,6 @@ static void process_modal_overlay(ecs_world_t* world, const CELS_Input* input) {
             }
         }
     }
-    ecs_query_fini(q);
 
     if (top_modal != 0) {
         const W_Modal* m = (const W_Modal*)ecs_get_id(world, top_modal, W_Modal_id);
@@ -507,6 +1137,7 @@ static void process_modal_overlay(ecs_world_t* world, const CELS_Input* input) {
 static cels_entity_t s_prev_focused_window = 0;
 
 static void process_window_overlay(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     cel_register(W_Window);
     cel_register(W_OverlayState);
 
@@ -517,7 +1148,8 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
     /* Check if any modal is visible first -- modals take priority */
     bool modal_visible = false;
     {
-        ecs_query_t* mq = ecs_query(world, {
+        static W_QueryCache mq_cache;
+        ecs_query_t* mq = widgets_query_cached(&mq_cache, world, &(ecs_query_desc_t){
             .terms = {{ .id = W_Modal_id }}
         });
         if (mq) {
@@ -530,12 +1162,12 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
                 }
                 if (modal_visible) break;
             }
-            ecs_query_fini(mq);
         }
     }
 
     /* Query all window entities */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_Window_id }}
     });
     if (!q) return;
@@ -559,7 +1191,6 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
             }
         }
     }
-    ecs_query_fini(q);
 
     /* Escape: dismiss topmost visible window (only if no modal is visible) */
     if (escape_pressed && !modal_visible && top_window != 0) {
@@ -575,7 +1206,8 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
     cel_register(W_FocusState);
 
     /* Re-query windows to find which one has focus */
-    ecs_query_t* q2 = ecs_query(world, {
+    static W_QueryCache q2_cache;
+    ecs_query_t* q2 = widgets_query_cached(&q2_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_Window_id }}
     });
     if (!q2) return;
@@ -607,7 +1239,6 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
         }
         if (focused_window != 0) break;
     }
-    ecs_query_fini(q2);
 
     /* Edge-detect: only raise when focus changes to a different window */
     if (focused_window != 0 && focused_window != s_prev_focused_window) {
@@ -616,7 +1247,8 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
         /* Z-band compaction: if z_order exceeds 49, compact */
         if (new_z > 49) {
             /* Re-query and subtract minimum z_order from all windows */
-            ecs_query_t* q3 = ecs_query(world, {
+            static W_QueryCache q3_cache;
+            ecs_query_t* q3 = widgets_query_cached(&q3_cache, world, &(ecs_query_desc_t){
                 .terms = {{ .id = W_Window_id }}
             });
             if (q3) {
@@ -648,7 +1280,6 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
                         }
                     }
                 }
-                ecs_query_fini(q3);
                 new_z = max_z_order - min_z + 1;
             }
         }
@@ -675,26 +1306,28 @@ static void process_window_overlay(ecs_world_t* world, const CELS_Input* input)
  * causing focus_system_run to skip process_navigation_groups.
  * ============================================================================ */
 
-/* Drag state lives here (not in W_Draggable component) because compositions
- * re-run cel_has(W_Draggable) each frame, which zero-inits the struct.
- * The component is only a tag marking the entity as draggable; the actual
- * moving flag persists in these statics across frames. We write back to
- * the component each frame so layouts.c can read it for visual feedback. */
-static ecs_entity_t s_drag_target = 0;
-static bool s_drag_moving = false;
-
+/* Drag state lives in the window's W_UiState (not in W_Draggable) because
+ * compositions re-run cel_has(W_Draggable) each frame, which zero-inits the
+ * struct. The component is only a tag marking the entity as draggable; we
+ * write the moving flag back to it each frame so layouts.c can read it for
+ * visual feedback. */
 static bool process_window_dragging(ecs_world_t* world, const CELS_Input* input) {
+    W_PROFILE_FOCUS();
     cel_register(W_Draggable);
     cel_register(W_Window);
+    cel_register(W_Tiled);
 
     /* Query all entities that have BOTH W_Window and W_Draggable */
-    ecs_query_t* q = ecs_query(world, {
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
         .terms = {{ .id = W_Window_id }, { .id = W_Draggable_id }}
     });
     if (!q) return false;
 
-    /* Find the topmost visible draggable window */
+    /* Find the topmost visible draggable window, and the one (if any)
+     * still in move mode from a previous frame */
     ecs_entity_t target = 0;
+    ecs_entity_t was_moving = 0;
     int top_z = -1;
     ecs_iter_t qit = ecs_query_iter(world, q);
     while (ecs_query_next(&qit)) {
@@ -705,33 +1338,31 @@ static bool process_window_dragging(ecs_world_t* world, const CELS_Input* input)
                 top_z = w->z_order;
                 target = qit.entities[e];
             }
+            const W_UiState* ui = Widget_ui_state_find(world, qit.entities[e]);
+            if (ui && ui->drag_moving) was_moving = qit.entities[e];
         }
     }
-    ecs_query_fini(q);
-
-    if (!target) {
-        s_drag_moving = false;
-        s_drag_target = 0;
-        return false;
-    }
 
     /* Reset if target changed (different window became topmost) */
-    if (s_drag_target != target) {
-        s_drag_moving = false;
-        s_drag_target = target;
+    if (was_moving && was_moving != target) {
+        Widget_ui_state_find(world, was_moving)->drag_moving = false;
     }
+    if (!target) return false;
+
+    W_UiState* drag = Widget_ui_state(world, target);
+    if (!drag) return false;
 
     /* 'm' key edge-detected: toggle move mode */
     bool m_pressed = (input->has_raw_key && input->raw_key == 'm' &&
                       !(s_prev_input.has_raw_key && s_prev_input.raw_key == 'm'));
     if (m_pressed) {
-        s_drag_moving = !s_drag_moving;
-        W_Draggable upd = { .moving = s_drag_moving };
+        drag->drag_moving = !drag->drag_moving;
+        W_Draggable upd = { .moving = drag->drag_moving };
         ecs_set_id(world, target, W_Draggable_id, sizeof(W_Draggable), &upd);
-        return s_drag_moving;
+        return drag->drag_moving;
     }
 
-    if (!s_drag_moving) return false;
+    if (!drag->drag_moving) return false;
 
     /* Write moving=true for layout visual feedback (composition reset it) */
     W_Draggable upd = { .moving = true };
@@ -741,21 +1372,32 @@ static bool process_window_dragging(ecs_world_t* world, const CELS_Input* input)
     bool exit_accept = (input->button_accept && !s_prev_input.button_accept);
     bool exit_cancel = (input->button_cancel && !s_prev_input.button_cancel);
     if (exit_accept || exit_cancel) {
-        s_drag_moving = false;
+        drag->drag_moving = false;
         W_Draggable off = { .moving = false };
         ecs_set_id(world, target, W_Draggable_id, sizeof(W_Draggable), &off);
         return true;
     }
 
-    /* Arrow keys: move window 1 cell per press (edge-detected) */
+    /* Arrow keys: 1 cell per press (edge-detected) */
+    int dx = 0, dy = 0;
+    if (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f) dy--;
+    if (input->axis_left[1] >  0.5f && s_prev_input.axis_left[1] <=  0.5f) dy++;
+    if (input->axis_left[0] < -0.5f && s_prev_input.axis_left[0] >= -0.5f) dx--;
+    if (input->axis_left[0] >  0.5f && s_prev_input.axis_left[0] <=  0.5f) dx++;
+
+    /* Tiled windows resize their tile instead of moving */
+    const W_Tiled* tiled = (const W_Tiled*)ecs_get_id(world, target, W_Tiled_id);
+    if (tiled && tiled->tree) {
+        Widget_tile_focus(tiled->tree, target);
+        Widget_tile_resize(tiled->tree, target, dx, dy);
+        return true;
+    }
+
     W_Window* w = (W_Window*)ecs_get_mut_id(world, target, W_Window_id);
     if (!w) return true;
-    bool moved = false;
-
-    if (input->axis_left[1] < -0.5f && s_prev_input.axis_left[1] >= -0.5f) { w->y--; moved = true; }
-    if (input->axis_left[1] >  0.5f && s_prev_input.axis_left[1] <=  0.5f) { w->y++; moved = true; }
-    if (input->axis_left[0] < -0.5f && s_prev_input.axis_left[0] >= -0.5f) { w->x--; moved = true; }
-    if (input->axis_left[0] >  0.5f && s_prev_input.axis_left[0] <=  0.5f) { w->x++; moved = true; }
+    bool moved = (dx != 0 || dy != 0);
+    w->x += dx;
+    w->y += dy;
 
     /* Clamp to screen bounds using terminal dimensions */
     CELS_Context* dctx = cels_get_context();
@@ -793,23 +1435,26 @@ static bool s_text_input_quit_guard(void) {
     CELS_Context* ctx = cels_get_context();
     ecs_world_t* world = cels_get_world(ctx);
     if (!world) return false;
-    return text_input_is_active(world);
+    return text_input_is_active(world) || command_palette_is_visible(world);
 }
 
 /* ============================================================================
  * Focus System Callback
  * ============================================================================ */
 
-static void focus_system_run(CELS_Iter* it) {
-    int count = cels_iter_count(it);
-
-    CELS_Context* ctx = cels_get_context();
-    const CELS_Input* input = cels_input_get(ctx);
+void widgets_focus_step(ecs_world_t* world, const CELS_Input* input, int count) {
     if (!input) return;
+    Widget_profile_frame_mark();
 
     cel_register(W_FocusState);
     W_FocusState.focus_count = count;
 
+    /* Command palette owns the keyboard while visible (Tab included) */
+    if (world && process_command_palette(world, input)) {
+        memcpy((void*)&s_prev_input, input, sizeof(CELS_Input));
+        return;
+    }
+
     /* Tab navigation for focus ring (only when focusable entities exist) */
     if (count > 0) {
         if (input->key_tab) {
@@ -820,8 +1465,10 @@ static void focus_system_run(CELS_Iter* it) {
     }
 
     /* Process overlay dismiss (modals first, then windows) */
-    ecs_world_t* world = cels_get_world(ctx);
     if (world) {
+        /* Re-attach state to keyed rows before anything reads selected_index */
+        widgets_keyed_reconcile(world);
+
         /* Check if any text input is active (focused + selected) */
         bool text_input_active = text_input_is_active(world);
 
@@ -843,12 +1490,23 @@ static void focus_system_run(CELS_Iter* it) {
         }
         process_split_pane_navigation(world, input);
         process_scrollable_navigation(world, input);
+        if (!text_input_active) {
+            process_datagrid_navigation(world, input);
+            process_multi_selection(world, input);
+            process_tree_navigation(world, input);
+            process_file_browser_navigation(world, input);
+        }
     }
 
     /* Store input for edge detection on next frame */
     memcpy((void*)&s_prev_input, input, sizeof(CELS_Input));
 }
 
+static void focus_system_run(CELS_Iter* it) {
+    CELS_Context* ctx = cels_get_context();
+    widgets_focus_step(cels_get_world(ctx), cels_input_get(ctx), cels_iter_count(it));
+}
+
 /* ============================================================================
  * Registration
  * ============================================================================ */
@@ -872,6 +1530,8 @@ void widgets_focus_system_register(void) {
     cel_register(W_Modal);
     cel_register(W_OverlayState);
     cel_register(W_Draggable);
+    cel_register(W_CommandPalette);
+    cel_register(W_CommandPaletteState);
 
     /* Text input components (for active detection) */
     cel_register(W_TextInputBuffer);
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Fuzzy filtering implementation
+ *
+ * Pipeline per query:
+ *   1. Source set: the previous match set when the new query extends the
+ *      old one (a match for "abc" is always a match for "ab"), otherwise
+ *      every item
+ *   2. Prefilter: each item carries a 64-bit character-class mask built
+ *      once in Widget_fuzzy_set_items(). One AND rejects items that lack
+ *      any query character, testing all 64 classes at once
+ *   3. Score: fzf v1 style -- greedy forward scan finds the match end,
+ *      backward scan tightens the start, then the window is scored.
+ *      Runs through w_jobs_parallel_for, chunked by W_FUZZY_GRAIN
+ *   4. Rank: compact survivors and sort by score (ties by source order)
+ */
+
+#include <cels-widgets/fuzzy.h>
+#include <cels-widgets/jobs.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/* Items per parallel chunk -- below this the scan runs inline */
+#define W_FUZZY_GRAIN 8192
+
+/* Scoring weights (fzf v1) */
+#define FUZZY_SCORE_MATCH        16
+#define FUZZY_GAP_START          (-3)
+#define FUZZY_GAP_EXTENSION      (-1)
+#define FUZZY_BONUS_BOUNDARY     8
+#define FUZZY_BONUS_CAMEL        7
+#define FUZZY_BONUS_CONSECUTIVE  4
+#define FUZZY_FIRST_CHAR_MULT    2
+
+/* ============================================================================
+ * Index State
+ * ============================================================================ */
+
+typedef struct W_FuzzyHit {
+    int score;
+    int index;
+} W_FuzzyHit;
+
+struct W_FuzzyIndex {
+    const char* const* items;
+    int item_count;
+    uint64_t* masks;            /* Character-class mask per item */
+    int* candidates;            /* Current matches in source order */
+    int candidate_count;
+    int* scores;                /* Scan scratch: score per source slot */
+    W_FuzzyHit* hits;           /* Current matches with scores, best first */
+    int* ranked;                /* Current matches, best first */
+    char query[W_FUZZY_QUERY_MAX];
+    int query_len;
+};
+
+/* ============================================================================
+ * Scoring
+ * ============================================================================ */
+
+static uint64_t fuzzy_char_bit(unsigned char c) {
+    c = (unsigned char)tolower(c);
+    if (c >= 'a' && c <= 'z') return 1ull << (c - 'a');
+    if (c >= '0' && c <= '9') return 1ull << (26 + (c - '0'));
+    return 1ull << (36 + (c % 28));
+}
+
+static uint64_t fuzzy_mask(const char* s) {
+    uint64_t m = 0;
+    if (!s) return 0;
+    for (; *s; s++) m |= fuzzy_char_bit((unsigned char)*s);
+    return m;
+}
+
+static void fuzzy_prepare(W_FuzzyPattern* q, const char* query, int len) {
+    q->case_sensitive = false;
+    for (int i = 0; i < len; i++) {
+        if (isupper((unsigned char)query[i])) q->case_sensitive = true;
+    }
+    for (int i = 0; i < len; i++) {
+        q->text[i] = q->case_sensitive ? query[i] : (char)tolower((unsigned char)query[i]);
+    }
+    q->text[len] = '\0';
+    q->len = len;
+    q->mask = fuzzy_mask(q->text);
+}
+
+static bool fuzzy_eq(const W_FuzzyPattern* q, char t, char c) {
+    return (q->case_sensitive ? t : (char)tolower((unsigned char)t)) == c;
+}
+
+static int fuzzy_bonus(const char* text, int i) {
+    if (i == 0) return FUZZY_BONUS_BOUNDARY;
+    unsigned char prev = (unsigned char)text[i - 1];
+    unsigned char cur = (unsigned char)text[i];
+    if (prev == ' ' || prev == '/' || prev == '_' || prev == '-' ||
+        prev == '.' || prev == ':' || prev == '\\') {
+        return FUZZY_BONUS_BOUNDARY;
+    }
+    if ((islower(prev) && isupper(cur)) || (!isdigit(prev) && isdigit(cur))) {
+        return FUZZY_BONUS_CAMEL;
+    }
+    return 0;
+}
+
+int Widget_fuzzy_score_prepared(const char* text, const W_FuzzyPattern* q) {
+    if (!text) return -1;
+    if (q->len == 0) return 0;
+
+    /* Forward: earliest position where the whole query has matched */
+    int qi = 0;
+    int end = -1;
+    for (int ti = 0; text[ti]; ti++) {
+        if (fuzzy_eq(q, text[ti], q->text[qi]) && ++qi == q->len) {
+            end = ti;
+            break;
+        }
+    }
+    if (end < 0) return -1;
+
+    /* Backward: tightest window ending at `end` */
+    int start = end;
+    qi = q->len - 1;
+    for (int ti = end; ti >= 0; ti--) {
+        if (fuzzy_eq(q, text[ti], q->text[qi])) {
+            if (qi == 0) { start = ti; break; }
+            qi--;
+        }
+    }
+
+    /* Score the window */
+    int score = 0;
+    bool in_run = false;
+    bool in_gap = false;
+    qi = 0;
+    for (int ti = start; ti <= end; ti++) {
+        if (qi < q->len && fuzzy_eq(q, text[ti], q->text[qi])) {
+            int bonus = fuzzy_bonus(text, ti);
+            if (qi == 0) bonus *= FUZZY_FIRST_CHAR_MULT;
+            score += FUZZY_SCORE_MATCH + bonus + (in_run ? FUZZY_BONUS_CONSECUTIVE : 0);
+            in_run = true;
+            in_gap = false;
+            qi++;
+        } else {
+            score += in_gap ? FUZZY_GAP_EXTENSION : FUZZY_GAP_START;
+            in_run = false;
+            in_gap = true;
+        }
+    }
+    return score > 0 ? score : 0;
+}
+
+void Widget_fuzzy_prepare(W_FuzzyPattern* pattern, const char* query) {
+    int len = query ? (int)strlen(query) : 0;
+    if (len >= W_FUZZY_QUERY_MAX) len = W_FUZZY_QUERY_MAX - 1;
+    fuzzy_prepare(pattern, query ? query : "", len);
+}
+
+int Widget_fuzzy_score(const char* text, const char* query) {
+    W_FuzzyPattern q;
+    Widget_fuzzy_prepare(&q, query);
+    return Widget_fuzzy_score_prepared(text, &q);
+}
+
+/* ============================================================================
+ * Parallel Scan
+ * ============================================================================ */
+
+typedef struct FuzzyScan {
+    const W_FuzzyIndex* fz;
+    const int* source;          /* NULL = all items (identity) */
+    const W_FuzzyPattern* q;
+    int* scores;
+} FuzzyScan;
+
+static void fuzzy_scan_range(void* arg, int begin, int end) {
+    FuzzyScan* scan = (FuzzyScan*)arg;
+    const W_FuzzyIndex* fz = scan->fz;
+    uint64_t qmask = scan->q->mask;
+    for (int i = begin; i < end; i++) {
+        int item = scan->source ? scan->source[i] : i;
+        if ((fz->masks[item] & qmask) != qmask) {
+            scan->scores[i] = -1;
+            continue;
+        }
+        scan->scores[i] = Widget_fuzzy_score_prepared(fz->items[item], scan->q);
+    }
+}
+
+static void fuzzy_mask_range(void* arg, int begin, int end) {
+    W_FuzzyIndex* fz = (W_FuzzyIndex*)arg;
+    for (int i = begin; i < end; i++) {
+        fz->masks[i] = fuzzy_mask(fz->items[i]);
+    }
+}
+
+static int fuzzy_hit_cmp(const void* a, const void* b) {
+    const W_FuzzyHit* x = (const W_FuzzyHit*)a;
+    const W_FuzzyHit* y = (const W_FuzzyHit*)b;
+    if (x->score != y->score) return (x->score < y->score) ? 1 : -1;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+static void fuzzy_reset_identity(W_FuzzyIndex* fz) {
+    for (int i = 0; i < fz->item_count; i++) {
+        fz->candidates[i] = i;
+        fz->ranked[i] = i;
+        fz->hits[i].score = 0;
+        fz->hits[i].index = i;
+    }
+    fz->candidate_count = fz->item_count;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_FuzzyIndex* Widget_fuzzy_create(void) {
+    return (W_FuzzyIndex*)calloc(1, sizeof(W_FuzzyIndex));
+}
+
+static void fuzzy_free_buffers(W_FuzzyIndex* fz) {
+    free(fz->masks);
+    free(fz->candidates);
+    free(fz->scores);
+    free(fz->hits);
+    free(fz->ranked);
+    fz->masks = NULL;
+    fz->candidates = NULL;
+    fz->scores = NULL;
+    fz->hits = NULL;
+    fz->ranked = NULL;
+}
+
+void Widget_fuzzy_destroy(W_FuzzyIndex* fz) {
+    if (!fz) return;
+    fuzzy_free_buffers(fz);
+    free(fz);
+}
+
+void Widget_fuzzy_set_items(W_FuzzyIndex* fz, const char* const* items, int count) {
+    if (!fz) return;
+    fuzzy_free_buffers(fz);
+    fz->items = items;
+    fz->item_count = 0;
+    fz->candidate_count = 0;
+    fz->query[0] = '\0';
+    fz->query_len = 0;
+    if (!items || count <= 0) return;
+
+    size_t n = (size_t)count;
+    fz->masks = (uint64_t*)malloc(n * sizeof(uint64_t));
+    fz->candidates = (int*)malloc(n * sizeof(int));
+    fz->scores = (int*)malloc(n * sizeof(int));
+    fz->hits = (W_FuzzyHit*)malloc(n * sizeof(W_FuzzyHit));
+    fz->ranked = (int*)malloc(n * sizeof(int));
+    if (!fz->masks || !fz->candidates || !fz->scores || !fz->hits || !fz->ranked) {
+        fuzzy_free_buffers(fz);
+        return;
+    }
+    fz->item_count = count;
+
+    w_jobs_parallel_for(count, W_FUZZY_GRAIN, fuzzy_mask_range, fz);
+    fuzzy_reset_identity(fz);
+}
+
+int Widget_fuzzy_set_query(W_FuzzyIndex* fz, const char* query) {
+    if (!fz || fz->item_count == 0) return 0;
+    if (!query) query = "";
+
+    int len = (int)strlen(query);
+    if (len >= W_FUZZY_QUERY_MAX) len = W_FUZZY_QUERY_MAX - 1;
+    if (len == fz->query_len && memcmp(query, fz->query, (size_t)len) == 0) {
+        return fz->candidate_count;
+    }
+
+    /* Narrowing: an extension of the previous query can only drop matches */
+    bool narrowing = (fz->query_len > 0 && len > fz->query_len &&
+                      memcmp(query, fz->query, (size_t)fz->query_len) == 0);
+
+    memcpy(fz->query, query, (size_t)len);
+    fz->query[len] = '\0';
+    fz->query_len = len;
+
+    if (len == 0) {
+        fuzzy_reset_identity(fz);
+        return fz->candidate_count;
+    }
+
+    W_FuzzyPattern q;
+    fuzzy_prepare(&q, fz->query, len);
+
+    int source_count = narrowing ? fz->candidate_count : fz->item_count;
+    FuzzyScan scan = {
+        .fz = fz,
+        .source = narrowing ? fz->candidates : NULL,
+        .q = &q,
+        .scores = fz->scores
+    };
+    w_jobs_parallel_for(source_count, W_FUZZY_GRAIN, fuzzy_scan_range, &scan);
+
+    /* Compact in place (write index never passes read index) */
+    int hit_count = 0;
+    for (int i = 0; i < source_count; i++) {
+        if (fz->scores[i] < 0) continue;
+        int item = narrowing ? fz->candidates[i] : i;
+        fz->candidates[hit_count] = item;
+        fz->hits[hit_count].score = fz->scores[i];
+        fz->hits[hit_count].index = item;
+        hit_count++;
+    }
+    fz->candidate_count = hit_count;
+
+    qsort(fz->hits, (size_t)hit_count, sizeof(W_FuzzyHit), fuzzy_hit_cmp);
+    for (int i = 0; i < hit_count; i++) {
+        fz->ranked[i] = fz->hits[i].index;
+    }
+    return hit_count;
+}
+
+const int* Widget_fuzzy_matches(const W_FuzzyIndex* fz, int* out_count) {
+    if (!fz) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+    if (out_count) *out_count = fz->candidate_count;
+    return fz->ranked;
+}
+
+int Widget_fuzzy_match_score(const W_FuzzyIndex* fz, int rank) {
+    if (!fz || rank < 0 || rank >= fz->candidate_count) return -1;
+    return fz->hits[rank].score;
+}
+
+size_t Widget_fuzzy_bytes(const W_FuzzyIndex* fz) {
+    if (!fz) return 0;
+    size_t per_item = sizeof(uint64_t) + 3 * sizeof(int) + sizeof(W_FuzzyHit);
+    return sizeof(*fz) + (size_t)fz->item_count * per_item;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Background job pool implementation
+ *
+ * A single mutex-protected ring buffer feeds a fixed set of pthread
+ * workers. Jobs are coarse (one sort, one directory scan), so a shared
+ * queue is sufficient -- there is no per-worker stealing.
+ */
+
+#include <cels-widgets/jobs.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* ============================================================================
+ * Pool State
+ * ============================================================================ */
+
+typedef struct W_JobEntry {
+    W_JobFn fn;
+    void* arg;
+} W_JobEntry;
+
+static pthread_mutex_t s_jobs_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_jobs_cond = PTHREAD_COND_INITIALIZER;
+
+static W_JobEntry s_jobs_queue[W_JOBS_QUEUE_SIZE];
+static int s_jobs_head = 0;
+static int s_jobs_count = 0;
+
+static pthread_t s_jobs_workers[W_JOBS_MAX_WORKERS];
+static int s_jobs_worker_count = 0;
+static bool s_jobs_stopping = false;
+
+/* ============================================================================
+ * Worker Loop
+ * ============================================================================ */
+
+static void* jobs_worker_main(void* unused) {
+    (void)unused;
+    for (;;) {
+        pthread_mutex_lock(&s_jobs_lock);
+        while (s_jobs_count == 0 && !s_jobs_stopping) {
+            pthread_cond_wait(&s_jobs_cond, &s_jobs_lock);
+        }
+        if (s_jobs_count == 0 && s_jobs_stopping) {
+            pthread_mutex_unlock(&s_jobs_lock);
+            return NULL;
+        }
+        W_JobEntry job = s_jobs_queue[s_jobs_head];
+        s_jobs_head = (s_jobs_head + 1) % W_JOBS_QUEUE_SIZE;
+        s_jobs_count--;
+        pthread_mutex_unlock(&s_jobs_lock);
+
+        job.fn(job.arg);
+    }
+}
+
+/* Start workers (caller holds s_jobs_lock) */
+static void jobs_start_locked(void) {
+    if (s_jobs_worker_count > 0) return;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int n = (cpus > 1) ? (int)(cpus - 1) : 1;
+    if (n > W_JOBS_MAX_WORKERS) n = W_JOBS_MAX_WORKERS;
+
+    s_jobs_stopping = false;
+    for (int i = 0; i < n; i++) {
+        if (pthread_create(&s_jobs_workers[s_jobs_worker_count], NULL,
+                           jobs_worker_main, NULL) == 0) {
+            s_jobs_worker_count++;
+        }
+    }
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+bool w_jobs_submit(W_JobFn fn, void* arg) {
+    if (!fn) return false;
+
+    pthread_mutex_lock(&s_jobs_lock);
+    jobs_start_locked();
+    if (s_jobs_worker_count == 0 || s_jobs_count >= W_JOBS_QUEUE_SIZE) {
+        pthread_mutex_unlock(&s_jobs_lock);
+        return false;
+    }
+    int tail = (s_jobs_head + s_jobs_count) % W_JOBS_QUEUE_SIZE;
+    s_jobs_queue[tail].fn = fn;
+    s_jobs_queue[tail].arg = arg;
+    s_jobs_count++;
+    pthread_cond_signal(&s_jobs_cond);
+    pthread_mutex_unlock(&s_jobs_lock);
+    return true;
+}
+
+/* ============================================================================
+ * Parallel For
+ *
+ * Chunks are claimed from a shared atomic cursor by the caller and by
+ * helper jobs. The shared block is reference counted: helpers that start
+ * after all chunks are claimed (e.g. queued behind a long sort) just drop
+ * their reference, so the caller only waits for chunks actually running.
+ * The caller sleeps on the block's condition variable; whoever finishes
+ * the last chunk wakes it.
+ * ============================================================================ */
+
+typedef struct W_ParallelFor {
+    W_JobRangeFn fn;
+    void* arg;
+    int count;
+    int chunk_size;
+    int chunk_count;
+    atomic_int next_chunk;
+    atomic_int done_chunks;
+    atomic_int refs;
+    pthread_mutex_t done_lock;
+    pthread_cond_t done_cond;
+} W_ParallelFor;
+
+static void parallel_for_release(W_ParallelFor* pf) {
+    if (atomic_fetch_sub(&pf->refs, 1) == 1) {
+        pthread_cond_destroy(&pf->done_cond);
+        pthread_mutex_destroy(&pf->done_lock);
+        free(pf);
+    }
+}
+
+static void parallel_for_drain(W_ParallelFor* pf) {
+    for (;;) {
+        int c = atomic_fetch_add(&pf->next_chunk, 1);
+        if (c >= pf->chunk_count) return;
+        int begin = c * pf->chunk_size;
+        int end = begin + pf->chunk_size;
+        if (end > pf->count) end = pf->count;
+        pf->fn(pf->arg, begin, end);
+        if (atomic_fetch_add(&pf->done_chunks, 1) + 1 == pf->chunk_count) {
+            pthread_mutex_lock(&pf->done_lock);
+            pthread_cond_signal(&pf->done_cond);
+            pthread_mutex_unlock(&pf->done_lock);
+        }
+    }
+}
+
+static void parallel_for_helper(void* arg) {
+    W_ParallelFor* pf = (W_ParallelFor*)arg;
+    parallel_for_drain(pf);
+    parallel_for_release(pf);
+}
+
+void w_jobs_parallel_for(int count, int grain, W_JobRangeFn fn, void* arg) {
+    if (!fn || count <= 0) return;
+    if (grain < 1) grain = 1;
+
+    int workers = (count > grain) ? w_jobs_worker_count() : 0;
+    int chunks = (count + grain - 1) / grain;
+    if (chunks > (workers + 1) * 4) chunks = (workers + 1) * 4;
+    if (workers == 0 || chunks <= 1) {
+        fn(arg, 0, count);
+        return;
+    }
+
+    W_ParallelFor* pf = (W_ParallelFor*)malloc(sizeof(W_ParallelFor));
+    if (!pf) {
+        fn(arg, 0, count);
+        return;
+    }
+    pf->fn = fn;
+    pf->arg = arg;
+    pf->count = count;
+    pf->chunk_size = (count + chunks - 1) / chunks;
+    pf->chunk_count = (count + pf->chunk_size - 1) / pf->chunk_size;
+    atomic_init(&pf->next_chunk, 0);
+    atomic_init(&pf->done_chunks, 0);
+    atomic_init(&pf->refs, 1);
+    pthread_mutex_init(&pf->done_lock, NULL);
+    pthread_cond_init(&pf->done_cond, NULL);
+
+    int helpers = (workers < pf->chunk_count - 1) ? workers : pf->chunk_count - 1;
+    for (int i = 0; i < helpers; i++) {
+        atomic_fetch_add(&pf->refs, 1);
+        if (!w_jobs_submit(parallel_for_helper, pf)) {
+            atomic_fetch_sub(&pf->refs, 1);
+            break;
+        }
+    }
+
+    /* Caller works too, then waits for chunks other threads claimed */
+    parallel_for_drain(pf);
+    pthread_mutex_lock(&pf->done_lock);
+    while (atomic_load(&pf->done_chunks) < pf->chunk_count) {
+        pthread_cond_wait(&pf->done_cond, &pf->done_lock);
+    }
+    pthread_mutex_unlock(&pf->done_lock);
+    parallel_for_release(pf);
+}
+
+int w_jobs_worker_count(void) {
+    pthread_mutex_lock(&s_jobs_lock);
+    jobs_start_locked();
+    int n = s_jobs_worker_count;
+    pthread_mutex_unlock(&s_jobs_lock);
+    return n;
+}
+
+void w_jobs_shutdown(void) {
+    pthread_mutex_lock(&s_jobs_lock);
+    int n = s_jobs_worker_count;
+    s_jobs_stopping = true;
+    pthread_cond_broadcast(&s_jobs_cond);
+    pthread_mutex_unlock(&s_jobs_lock);
+
+    for (int i = 0; i < n; i++) {
+        pthread_join(s_jobs_workers[i], NULL);
+    }
+
+    pthread_mutex_lock(&s_jobs_lock);
+    s_jobs_worker_count = 0;
+    s_jobs_stopping = false;
+    pthread_mutex_unlock(&s_jobs_lock);
+}
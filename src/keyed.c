@@ -0,0 +1,337 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Keyed child reconciliation
+ *
+ * Compositions are matched to entities by position, so when a dynamic list
+ * inserts, removes or reorders rows the entity at position i starts
+ * describing a different item while keeping the old item's state. Rows
+ * that carry a W_Key are reconciled once per frame, before navigation:
+ *
+ *   1. Diff:    entities whose W_Key differs from their W_KeyBinding (the
+ *               key they had last frame) are collected. Unchanged rows are
+ *               skipped, so a steady-state list costs one query pass.
+ *   2. Save:    each changed entity's state is stashed under
+ *               (parent, old key), and every affected NavigationScope
+ *               records which key its selected_index pointed at.
+ *   3. Restore: each changed entity picks up the state stashed under
+ *               (parent, new key), or is reset if the key is new.
+ *   4. Retarget: selected_index follows the selected key to its new
+ *               position, and the enclosing scroll offset shifts by the
+ *               same amount so the selected row stays where it was.
+ *
+ * The stash only lives for one frame -- every key that moved this frame
+ * is both saved and looked up in the same pass.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/input.h>
+#include <flecs.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Frame-Local State
+ * ============================================================================ */
+
+typedef struct KeyedMove {
+    ecs_entity_t entity;
+    ecs_entity_t parent;
+    uint64_t old_key;               /* 0 = entity was unkeyed/new */
+    uint64_t new_key;
+} KeyedMove;
+
+typedef struct KeyedStash {
+    ecs_entity_t parent;            /* 0 = empty slot */
+    uint64_t key;
+    bool selected;
+    bool focused;
+} KeyedStash;
+
+typedef struct KeyedScopeFix {
+    ecs_entity_t parent;
+    int old_index;                  /* selected_index before the move */
+    uint64_t selected_key;          /* Key at old_index (0 = none) */
+} KeyedScopeFix;
+
+static KeyedMove* s_moves = NULL;
+static int s_move_count = 0;
+static int s_move_cap = 0;
+
+static KeyedStash* s_stash = NULL;
+static int s_stash_cap = 0;         /* Power of two */
+
+static KeyedScopeFix* s_fixes = NULL;
+static int s_fix_count = 0;
+static int s_fix_cap = 0;
+
+static bool keyed_grow(void** arr, int* cap, int need, size_t elem) {
+    if (need <= *cap) return true;
+    int new_cap = *cap ? *cap * 2 : 64;
+    while (new_cap < need) new_cap *= 2;
+    void* p = realloc(*arr, (size_t)new_cap * elem);
+    if (!p) return false;
+    *arr = p;
+    *cap = new_cap;
+    return true;
+}
+
+/* ============================================================================
+ * Stash (open addressing, keyed by parent + key)
+ * ============================================================================ */
+
+static uint32_t keyed_hash(ecs_entity_t parent, uint64_t key) {
+    uint64_t h = (key ^ (parent * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+    return (uint32_t)(h >> 32);
+}
+
+static bool stash_reset(int entries) {
+    int need = 16;
+    while (need < entries * 2) need *= 2;
+    if (need > s_stash_cap) {
+        KeyedStash* p = (KeyedStash*)realloc(s_stash, (size_t)need * sizeof(KeyedStash));
+        if (!p) return false;
+        s_stash = p;
+        s_stash_cap = need;
+    }
+    memset(s_stash, 0, (size_t)s_stash_cap * sizeof(KeyedStash));
+    return true;
+}
+
+static void stash_put(ecs_entity_t parent, uint64_t key, bool selected, bool focused) {
+    uint32_t mask = (uint32_t)s_stash_cap - 1;
+    uint32_t i = keyed_hash(parent, key) & mask;
+    while (s_stash[i].parent != 0 &&
+           !(s_stash[i].parent == parent && s_stash[i].key == key)) {
+        i = (i + 1) & mask;
+    }
+    s_stash[i] = (KeyedStash){ parent, key, selected, focused };
+}
+
+static const KeyedStash* stash_get(ecs_entity_t parent, uint64_t key) {
+    uint32_t mask = (uint32_t)s_stash_cap - 1;
+    uint32_t i = keyed_hash(parent, key) & mask;
+    while (s_stash[i].parent != 0) {
+        if (s_stash[i].parent == parent && s_stash[i].key == key) return &s_stash[i];
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * Scope Helpers
+ * ============================================================================ */
+
+/* Key bound to the index-th W_Selectable child of parent.
+ * use_binding selects last frame's key (W_KeyBinding) over this frame's. */
+static uint64_t keyed_child_key_at(ecs_world_t* world, ecs_entity_t parent,
+                                   int index, bool use_binding) {
+    ecs_id_t key_id = use_binding ? W_KeyBinding_id : W_Key_id;
+    int pos = 0;
+    ecs_iter_t cit = ecs_children(world, parent);
+    while (ecs_children_next(&cit)) {
+        for (int c = 0; c < cit.count; c++) {
+            ecs_entity_t child = cit.entities[c];
+            if (!ecs_has_id(world, child, W_Selectable_id)) continue;
+            if (pos++ != index) continue;
+            /* W_KeyBinding and W_Key share a layout */
+            const W_Key* k = (const W_Key*)ecs_get_id(world, child, key_id);
+            ecs_iter_fini(&cit);
+            return k ? k->key : 0;
+        }
+    }
+    return 0;
+}
+
+/* Position of the W_Selectable child now carrying key (-1 = removed) */
+static int keyed_child_index_of(ecs_world_t* world, ecs_entity_t parent, uint64_t key) {
+    int pos = 0;
+    ecs_iter_t cit = ecs_children(world, parent);
+    while (ecs_children_next(&cit)) {
+        for (int c = 0; c < cit.count; c++) {
+            ecs_entity_t child = cit.entities[c];
+            if (!ecs_has_id(world, child, W_Selectable_id)) continue;
+            const W_Key* k = (const W_Key*)ecs_get_id(world, child, W_Key_id);
+            if (k && k->key == key) {
+                ecs_iter_fini(&cit);
+                return pos;
+            }
+            pos++;
+        }
+    }
+    return -1;
+}
+
+/* Scrollable wrapping a scope: the scope itself, its parent or grandparent
+ * (W_ScrollContainer holds the NavigationScope one or two levels down). */
+static ecs_entity_t keyed_find_scrollable(ecs_world_t* world, ecs_entity_t scope) {
+    ecs_entity_t e = scope;
+    for (int depth = 0; depth < 3 && e != 0; depth++) {
+        if (ecs_has_id(world, e, W_Scrollable_id)) return e;
+        e = ecs_get_parent(world, e);
+    }
+    return 0;
+}
+
+static void keyed_note_scope(ecs_world_t* world, ecs_entity_t parent) {
+    for (int i = 0; i < s_fix_count; i++) {
+        if (s_fixes[i].parent == parent) return;
+    }
+    const W_NavigationScope* scope = (const W_NavigationScope*)ecs_get_id(
+        world, parent, W_NavigationScope_id);
+    if (!scope) return;
+    if (!keyed_grow((void**)&s_fixes, &s_fix_cap, s_fix_count + 1,
+                    sizeof(KeyedScopeFix))) return;
+    s_fixes[s_fix_count++] = (KeyedScopeFix){
+        .parent = parent,
+        .old_index = scope->selected_index,
+        .selected_key = keyed_child_key_at(world, parent, scope->selected_index, true),
+    };
+}
+
+/* ============================================================================
+ * Reconcile
+ * ============================================================================ */
+
+size_t widgets_keyed_heap_bytes(void) {
+    return (size_t)s_move_cap * sizeof(KeyedMove)
+         + (size_t)s_stash_cap * sizeof(KeyedStash)
+         + (size_t)s_fix_cap * sizeof(KeyedScopeFix);
+}
+
+void widgets_keyed_reconcile(ecs_world_t* world) {
+    cel_register(W_Key);
+    cel_register(W_KeyBinding);
+    cel_register(W_Selectable);
+    cel_register(W_InteractState);
+    cel_register(W_NavigationScope);
+    cel_register(W_Scrollable);
+
+    static W_QueryCache q_cache;
+    ecs_query_t* q = widgets_query_cached(&q_cache, world, &(ecs_query_desc_t){
+        .terms = {{ .id = W_Key_id }}
+    });
+    if (!q) return;
+
+    /* 1. Diff against last frame's binding */
+    s_move_count = 0;
+    ecs_iter_t qit = ecs_query_iter(world, q);
+    while (ecs_query_next(&qit)) {
+        for (int e = 0; e < qit.count; e++) {
+            ecs_entity_t ent = qit.entities[e];
+            const W_Key* k = (const W_Key*)ecs_get_id(world, ent, W_Key_id);
+            const W_KeyBinding* b = (const W_KeyBinding*)ecs_get_id(
+                world, ent, W_KeyBinding_id);
+            uint64_t old_key = b ? b->key : 0;
+            if (!k || (b && old_key == k->key)) continue;
+
+            if (!keyed_grow((void**)&s_moves, &s_move_cap, s_move_count + 1,
+                            sizeof(KeyedMove))) continue;
+            s_moves[s_move_count++] = (KeyedMove){
+                .entity = ent,
+                .parent = ecs_get_parent(world, ent),
+                .old_key = old_key,
+                .new_key = k->key,
+            };
+        }
+    }
+
+    if (s_move_count == 0) return;
+    if (!stash_reset(s_move_count)) return;
+
+    /* 2. Save state under the old key; note affected scopes */
+    s_fix_count = 0;
+    for (int i = 0; i < s_move_count; i++) {
+        const KeyedMove* m = &s_moves[i];
+        if (m->parent == 0) continue;
+        keyed_note_scope(world, m->parent);
+        if (m->old_key == 0) continue;
+
+        const W_Selectable* sel = (const W_Selectable*)ecs_get_id(
+            world, m->entity, W_Selectable_id);
+        const W_InteractState* ist = (const W_InteractState*)ecs_get_id(
+            world, m->entity, W_InteractState_id);
+        stash_put(m->parent, m->old_key,
+                  sel ? sel->selected : false,
+                  ist ? ist->focused : false);
+    }
+
+    /* 3. Restore state for the new key and rebind */
+    for (int i = 0; i < s_move_count; i++) {
+        const KeyedMove* m = &s_moves[i];
+        const KeyedStash* st = m->parent ? stash_get(m->parent, m->new_key) : NULL;
+
+        /* A fresh entity keeps its composed state; a reused one sheds the
+         * state of the item it used to describe */
+        if (st || m->old_key != 0) {
+            bool selected = st ? st->selected : false;
+            bool focused = st ? st->focused : false;
+
+            W_Selectable* sel = (W_Selectable*)ecs_get_mut_id(
+                world, m->entity, W_Selectable_id);
+            if (sel && sel->selected != selected) {
+                sel->selected = selected;
+                ecs_set_id(world, m->entity, W_Selectable_id, sizeof(W_Selectable), sel);
+            }
+            W_InteractState* ist = (W_InteractState*)ecs_get_mut_id(
+                world, m->entity, W_InteractState_id);
+            if (ist && (ist->selected != selected || ist->focused != focused)) {
+                ist->selected = selected;
+                ist->focused = focused;
+                ecs_set_id(world, m->entity, W_InteractState_id, sizeof(W_InteractState), ist);
+            }
+        }
+
+        W_KeyBinding binding = { .key = m->new_key };
+        ecs_set_id(world, m->entity, W_KeyBinding_id, sizeof(W_KeyBinding), &binding);
+    }
+
+    /* 4. Move selected_index (and scroll) with the selected key */
+    for (int i = 0; i < s_fix_count; i++) {
+        const KeyedScopeFix* f = &s_fixes[i];
+        if (f->selected_key == 0) continue;
+
+        int new_index = keyed_child_index_of(world, f->parent, f->selected_key);
+        if (new_index < 0 || new_index == f->old_index) continue;
+
+        W_NavigationScope* scope = (W_NavigationScope*)ecs_get_mut_id(
+            world, f->parent, W_NavigationScope_id);
+        if (!scope) continue;
+        scope->selected_index = new_index;
+        ecs_set_id(world, f->parent, W_NavigationScope_id, sizeof(W_NavigationScope), scope);
+
+        ecs_entity_t scr_entity = keyed_find_scrollable(world, f->parent);
+        if (scr_entity == 0) continue;
+        int offset = Widget_scroll_offset(world, scr_entity);
+        Widget_scroll_set(world, scr_entity, offset + new_index - f->old_index);
+    }
+}
+
+/* ============================================================================
+ * Key Helpers
+ * ============================================================================ */
+
+uint64_t Widget_key_str(const char* s) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    if (s) {
+        for (; *s; s++) {
+            h ^= (unsigned char)*s;
+            h *= 0x100000001B3ull;
+        }
+    }
+    return h ? h : 1;
+}
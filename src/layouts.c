@@ -44,6 +44,7 @@
 #include <cels-widgets/input.h>
 #include <cels-widgets/theme.h>
 #include <cels-widgets/style.h>
+#include <cels-widgets/profile.h>
 #include <cels-clay/clay_layout.h>
 #include <cels-clay/clay_render.h>
 #include <clay.h>
@@ -52,39 +53,32 @@
 #include <string.h>
 
 /* ============================================================================
- * Theme Singleton
+ * Border Decorations
  * ============================================================================ */
 
-static const Widget_Theme* s_active_theme = NULL;
-static bool s_theme_dirty = false;
-
 /* Shared ring buffer for border decoration data (Panel, Canvas, InfoBox,
  * Popup, Modal, Window). Each bordered layout call allocates one slot,
  * valid for the current frame. 128 slots handles all bordered widgets.
- * Wraps safely since render happens after all layouts. */
-#define W_BORDER_DECOR_MAX 128
+ * Wraps safely since render happens after all layouts. The index is
+ * unsigned so it wraps to 0 instead of going negative on long runs. */
 static CelClayBorderDecor g_border_decors[W_BORDER_DECOR_MAX];
-static int g_border_decor_idx = 0;
+static unsigned g_border_decor_idx = 0;
 
 static CelClayBorderDecor* _alloc_border_decor(void) {
     CelClayBorderDecor* d = &g_border_decors[g_border_decor_idx % W_BORDER_DECOR_MAX];
     g_border_decor_idx++;
+#ifdef CELS_WIDGETS_PROFILE
+    w_profile_count_decor();
+#endif
     return d;
 }
 
-const Widget_Theme* Widget_get_theme(void) {
-    return s_active_theme ? s_active_theme : &Widget_THEME_DEFAULT;
-}
-
-void Widget_set_theme(const Widget_Theme* theme) {
-    s_active_theme = theme;
-    s_theme_dirty = true;
+unsigned w_border_decor_allocs(void) {
+    return g_border_decor_idx;
 }
 
-bool Widget_theme_changed(void) {
-    bool dirty = s_theme_dirty;
-    s_theme_dirty = false;
-    return dirty;
+size_t w_border_decor_bytes(void) {
+    return sizeof(g_border_decors);
 }
 
 /* ============================================================================
@@ -100,6 +94,81 @@ static CEL_Color status_color(const Widget_Theme* t, int status) {
     }
 }
 
+/* ============================================================================
+ * Helper: display width of a UTF-8 string in terminal cells
+ *
+ * Counts code points (non-continuation bytes). Wide CJK glyphs are not
+ * special-cased -- widgets size for the common single-cell case.
+ * ============================================================================ */
+
+static int _utf8_width(const char* s) {
+    int w = 0;
+    if (!s) return 0;
+    for (; *s; s++) {
+        if (((unsigned char)*s & 0xC0) != 0x80) w++;
+    }
+    return w;
+}
+
+/* ============================================================================
+ * Helper: vertical scrollbar gutter
+ *
+ * Emits a 1-cell-wide track/thumb column for a viewport of `visible` rows
+ * over `total` rows scrolled to `offset`. Callers only emit the gutter when
+ * total > visible. Shared by ScrollContainer, Table and LogViewer.
+ * ============================================================================ */
+
+static void _emit_scrollbar(int track_h, int offset, int visible, int total,
+                            CEL_Color track_color, CEL_Color thumb_color) {
+    int thumb_h = (visible * track_h) / total;
+    if (thumb_h < 1) thumb_h = 1;
+    int max_off = total - visible;
+    int thumb_y = (max_off > 0) ? (offset * (track_h - thumb_h)) / max_off : 0;
+    int track_below = track_h - thumb_y - thumb_h;
+    if (track_below < 0) track_below = 0;
+
+    /* 1-terminal-cell wide gutter column (divide by aspect ratio) */
+    float cell_w = 1.0f / CEL_CELL_ASPECT_RATIO;
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = {
+                .width = CLAY_SIZING_FIXED(cell_w),
+                .height = CLAY_SIZING_GROW(0)
+            }
+        }
+    ) {
+        /* Track above thumb */
+        if (thumb_y > 0) {
+            CEL_Clay(
+                .layout = { .sizing = {
+                    .width = CLAY_SIZING_FIXED(cell_w),
+                    .height = CLAY_SIZING_FIXED((float)thumb_y)
+                }},
+                .backgroundColor = track_color
+            ) {}
+        }
+        /* Thumb */
+        CEL_Clay(
+            .layout = { .sizing = {
+                .width = CLAY_SIZING_FIXED(cell_w),
+                .height = CLAY_SIZING_FIXED((float)thumb_h)
+            }},
+            .backgroundColor = thumb_color
+        ) {}
+        /* Track below thumb */
+        if (track_below > 0) {
+            CEL_Clay(
+                .layout = { .sizing = {
+                    .width = CLAY_SIZING_FIXED(cell_w),
+                    .height = CLAY_SIZING_FIXED((float)track_below)
+                }},
+                .backgroundColor = track_color
+            ) {}
+        }
+    }
+}
+
 /* ============================================================================
  * Text & Display Layouts
  *
@@ -108,6 +177,7 @@ static CEL_Color status_color(const Widget_Theme* t, int status) {
  * ============================================================================ */
 
 void w_text_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Text* d = (const W_Text*)ecs_get_id(world, self, W_Text_id);
     if (!d || !d->text) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -135,6 +205,7 @@ void w_text_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_hint_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Hint* d = (const W_Hint*)ecs_get_id(world, self, W_Hint_id);
     if (!d || !d->text) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -158,6 +229,7 @@ void w_hint_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_canvas_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Canvas* d = (const W_Canvas*)ecs_get_id(world, self, W_Canvas_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -207,6 +279,7 @@ void w_canvas_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_info_box_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_InfoBox* d = (const W_InfoBox*)ecs_get_id(world, self, W_InfoBox_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -271,6 +344,7 @@ void w_info_box_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_badge_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Badge* d = (const W_Badge*)ecs_get_id(world, self, W_Badge_id);
     if (!d || !d->text) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -305,6 +379,7 @@ void w_badge_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_text_area_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_TextArea* d = (const W_TextArea*)ecs_get_id(world, self, W_TextArea_id);
     if (!d || !d->text) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -370,6 +445,7 @@ void w_text_area_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_button_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Button* d = (const W_Button*)ecs_get_id(world, self, W_Button_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -445,6 +521,7 @@ void w_button_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_slider_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Slider* d = (const W_Slider*)ecs_get_id(world, self, W_Slider_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -512,6 +589,7 @@ void w_slider_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_toggle_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Toggle* d = (const W_Toggle*)ecs_get_id(world, self, W_Toggle_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -567,6 +645,7 @@ void w_toggle_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_cycle_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Cycle* d = (const W_Cycle*)ecs_get_id(world, self, W_Cycle_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -629,6 +708,7 @@ void w_cycle_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_progress_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_ProgressBar* d = (const W_ProgressBar*)ecs_get_id(world, self, W_ProgressBar_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -688,6 +768,7 @@ void w_progress_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_metric_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Metric* d = (const W_Metric*)ecs_get_id(world, self, W_Metric_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -726,6 +807,7 @@ void w_metric_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_panel_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Panel* d = (const W_Panel*)ecs_get_id(world, self, W_Panel_id);
     (void)d; /* d may be NULL if no props were set -- still render container */
     const Widget_Theme* t = Widget_get_theme();
@@ -789,6 +871,7 @@ void w_panel_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_divider_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Divider* d = (const W_Divider*)ecs_get_id(world, self, W_Divider_id);
     const Widget_Theme* t = Widget_get_theme();
     const Widget_DividerStyle* s = (d ? d->style : NULL);
@@ -813,9 +896,78 @@ void w_divider_layout(struct ecs_world_t* world, cels_entity_t self) {
     }
 }
 
+/* Key column bounds (cells). Keys wider than the max are clipped. */
+#define W_TABLE_KEY_MIN_WIDTH 4
+#define W_TABLE_KEY_MAX_WIDTH 48
+
+/* Rows measured per frame by append catch-up and by the rolling rescan.
+ * Bounds per-frame cost for tables with tens of thousands of rows. */
+#define W_TABLE_MEASURE_BUDGET 2048
+
+/* Fetch row strings from the data source or the static arrays */
+static void _table_row(const W_Table* d, int row, const char** key, const char** val) {
+    *key = NULL;
+    *val = NULL;
+    if (d->get_row) {
+        d->get_row(d->user_data, row, key, val);
+    } else {
+        if (d->keys) *key = d->keys[row];
+        if (d->values) *val = d->values[row];
+    }
+    if (!*key) *key = "";
+    if (!*val) *val = "";
+}
+
+static int _table_clamp_key_width(int w) {
+    if (w < W_TABLE_KEY_MIN_WIDTH) return W_TABLE_KEY_MIN_WIDTH;
+    if (w > W_TABLE_KEY_MAX_WIDTH) return W_TABLE_KEY_MAX_WIDTH;
+    return w;
+}
+
+/* Incremental key column sizing: measure newly appended rows, then advance
+ * the rolling rescan. Both are bounded by W_TABLE_MEASURE_BUDGET. */
+static void _table_measure(const W_Table* d, W_TableState* st, int header_w) {
+    int n = d->row_count;
+    const char* key;
+    const char* val;
+
+    /* Rows removed: forget measurements past the end (rescan may shrink) */
+    if (st->measured_rows > n) st->measured_rows = n;
+    if (st->rescan_row > n) st->rescan_row = n;
+
+    /* Append catch-up: new rows can only widen the column */
+    int append_end = st->measured_rows + W_TABLE_MEASURE_BUDGET;
+    if (append_end > n) append_end = n;
+    for (int i = st->measured_rows; i < append_end; i++) {
+        _table_row(d, i, &key, &val);
+        int w = _utf8_width(key);
+        if (w > st->key_width) st->key_width = w;
+    }
+    st->measured_rows = append_end;
+
+    /* Rolling rescan: commits (and may shrink) only after a complete pass
+     * over fully-measured data, so a partial pass never narrows the column */
+    int rescan_end = st->rescan_row + W_TABLE_MEASURE_BUDGET;
+    if (rescan_end > n) rescan_end = n;
+    for (int i = st->rescan_row; i < rescan_end; i++) {
+        _table_row(d, i, &key, &val);
+        int w = _utf8_width(key);
+        if (w > st->rescan_width) st->rescan_width = w;
+    }
+    st->rescan_row = rescan_end;
+    if (st->rescan_row >= n && st->measured_rows == n) {
+        st->key_width = (st->rescan_width > header_w) ? st->rescan_width : header_w;
+        st->rescan_row = 0;
+        st->rescan_width = header_w;
+    }
+}
+
 void w_table_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Table* d = (const W_Table*)ecs_get_id(world, self, W_Table_id);
-    if (!d || d->row_count <= 0) return;
+    if (!d) return;
+    bool has_header = (d->key_header || d->value_header);
+    if (d->row_count <= 0 && !has_header) return;
     const Widget_Theme* t = Widget_get_theme();
     const Widget_TableStyle* s = d->style;
 
@@ -823,18 +975,76 @@ void w_table_layout(struct ecs_world_t* world, cels_entity_t self) {
     CEL_TextAttr key_attr = t->content_muted.attr;
     CEL_Color val_fg = t->content.color;
     CEL_TextAttr val_attr = t->content.attr;
+    CEL_Color header_fg = t->content_title.color;
+    CEL_TextAttr header_attr = t->content_title.attr;
+    header_attr.underline = true;
+
+    /* ---- Key column width (incremental) ---- */
+    int header_w = _utf8_width(d->key_header);
+    W_TableState* state = (W_TableState*)ecs_get_mut_id(world, self, W_TableState_id);
+    W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+    int key_w;
+    if (state) {
+        if (!state->initialized) {
+            state->initialized = true;
+            state->key_width = header_w;
+            state->measured_rows = 0;
+            state->rescan_row = 0;
+            state->rescan_width = header_w;
+        }
+        if (header_w > state->key_width) state->key_width = header_w;
+        _table_measure(d, state, header_w);
+        key_w = state->key_width;
+    } else {
+        key_w = 16; /* No state component: legacy fixed key width */
+    }
+
+    /* ---- Visible row window ---- */
+    int first = 0;
+    int rows = d->row_count;
+    if (d->visible_height > 0) {
+        rows = d->visible_height - (has_header ? 1 : 0);
+        if (rows < 1) rows = 1;
+        if (scroll) {
+            scroll->total_count = d->row_count;
+            scroll->visible_count = rows;
+            first = Widget_scroll_offset(world, self); /* Clamped to the new extent */
+        }
+    }
+    int last = first + rows;
+    if (last > d->row_count) last = d->row_count;
+    bool needs_scrollbar = d->visible_height > 0 && d->row_count > rows;
+
+    /* Rendered rows are re-measured every frame so an edited visible key
+     * widens the column immediately instead of waiting for the rescan */
+    if (state) {
+        for (int i = first; i < last; i++) {
+            const char* key;
+            const char* val;
+            _table_row(d, i, &key, &val);
+            int w = _utf8_width(key);
+            if (w > state->key_width) state->key_width = w;
+        }
+        key_w = state->key_width;
+    }
+    key_w = _table_clamp_key_width(key_w);
+    float key_cell_w = (float)key_w / CEL_CELL_ASPECT_RATIO;
+
+    Clay_SizingAxis h_axis = (d->visible_height > 0)
+        ? CLAY_SIZING_FIXED((float)d->visible_height)
+        : CLAY_SIZING_FIT(0);
 
     CEL_Clay(
         .layout = {
             .layoutDirection = CLAY_TOP_TO_BOTTOM,
-            .sizing = { .width = CLAY_SIZING_GROW(0) },
+            .sizing = { .width = CLAY_SIZING_GROW(0), .height = h_axis },
             .childGap = 0
         }
     ) {
-        for (int i = 0; i < d->row_count; i++) {
-            const char* key = (d->keys && d->keys[i]) ? d->keys[i] : "";
-            const char* val = (d->values && d->values[i]) ? d->values[i] : "";
-
+        /* Header row: frozen above the scrolled rows */
+        if (has_header) {
+            const char* kh = d->key_header ? d->key_header : "";
+            const char* vh = d->value_header ? d->value_header : "";
             CEL_Clay(
                 .layout = {
                     .layoutDirection = CLAY_LEFT_TO_RIGHT,
@@ -842,17 +1052,78 @@ void w_table_layout(struct ecs_world_t* world, cels_entity_t self) {
                     .childGap = 1
                 }
             ) {
-                char key_buf[32];
-                int key_len = snprintf(key_buf, sizeof(key_buf), "%-16s", key);
-                CLAY_TEXT(CEL_Clay_Text(key_buf, key_len),
-                    CLAY_TEXT_CONFIG({ .textColor = key_fg,
-                                      .userData = w_pack_text_attr(key_attr) }));
-                CLAY_TEXT(CEL_Clay_Text(val, (int)strlen(val)),
-                    CLAY_TEXT_CONFIG({ .textColor = val_fg,
-                                      .userData = w_pack_text_attr(val_attr) }));
+                CEL_Clay(
+                    .layout = { .sizing = { .width = CLAY_SIZING_FIXED(key_cell_w),
+                                            .height = CLAY_SIZING_FIXED(1) } },
+                    .clip = { .horizontal = true }
+                ) {
+                    CLAY_TEXT(CEL_Clay_Text(kh, (int)strlen(kh)),
+                        CLAY_TEXT_CONFIG({ .textColor = header_fg,
+                                          .userData = w_pack_text_attr(header_attr) }));
+                }
+                CLAY_TEXT(CEL_Clay_Text(vh, (int)strlen(vh)),
+                    CLAY_TEXT_CONFIG({ .textColor = header_fg,
+                                      .userData = w_pack_text_attr(header_attr) }));
+            }
+        }
+
+        /* Body: visible rows | scrollbar gutter */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0),
+                            .height = (d->visible_height > 0) ? CLAY_SIZING_GROW(0) : CLAY_SIZING_FIT(0) }
+            }
+        ) {
+            CEL_Clay(
+                .layout = {
+                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                    .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0) }
+                }
+            ) {
+                for (int i = first; i < last; i++) {
+                    const char* key;
+                    const char* val;
+                    _table_row(d, i, &key, &val);
+
+                    CEL_Clay(
+                        .layout = {
+                            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) },
+                            .childGap = 1
+                        }
+                    ) {
+                        /* Key cell: fixed column width, clipped (no padding copy) */
+                        CEL_Clay(
+                            .layout = { .sizing = { .width = CLAY_SIZING_FIXED(key_cell_w),
+                                                    .height = CLAY_SIZING_FIXED(1) } },
+                            .clip = { .horizontal = true }
+                        ) {
+                            CLAY_TEXT(CEL_Clay_Text(key, (int)strlen(key)),
+                                CLAY_TEXT_CONFIG({ .textColor = key_fg,
+                                                  .userData = w_pack_text_attr(key_attr) }));
+                        }
+                        CLAY_TEXT(CEL_Clay_Text(val, (int)strlen(val)),
+                            CLAY_TEXT_CONFIG({ .textColor = val_fg,
+                                              .userData = w_pack_text_attr(val_attr) }));
+                    }
+                }
+            }
+
+            if (needs_scrollbar) {
+                _emit_scrollbar(rows, first, rows, d->row_count,
+                                t->surface_alt.color, t->content_muted.color);
             }
         }
     }
+
+    /* Write back modified state */
+    if (state) {
+        ecs_set_id(world, self, W_TableState_id, sizeof(W_TableState), state);
+    }
+    if (scroll && d->visible_height > 0) {
+        ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+    }
 }
 
 /* ============================================================================
@@ -860,6 +1131,7 @@ void w_table_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_collapsible_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Collapsible* d = (const W_Collapsible*)ecs_get_id(world, self, W_Collapsible_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -890,8 +1162,12 @@ void w_collapsible_layout(struct ecs_world_t* world, cels_entity_t self) {
     /* Indentation: indent * 2 cells */
     int left_pad = d->indent * 2;
 
+    /* Expansion lives in W_UiState; no state yet = expanded */
+    const W_UiState* ui = Widget_ui_state_find(world, self);
+    bool collapsed = ui ? !ui->expanded : false;
+
     /* Unicode triangle indicators (UTF-8 encoded) */
-    const char* indicator = d->collapsed
+    const char* indicator = collapsed
         ? "\xe2\x96\xb6 "   /* right-pointing triangle (collapsed) */
         : "\xe2\x96\xbc ";  /* down-pointing triangle (expanded) */
 
@@ -926,7 +1202,7 @@ void w_collapsible_layout(struct ecs_world_t* world, cels_entity_t self) {
         }
 
         /* Content section: only emit children when expanded */
-        if (!d->collapsed) {
+        if (!collapsed) {
             CEL_Clay(
                 .layout = {
                     .layoutDirection = CLAY_TOP_TO_BOTTOM,
@@ -945,6 +1221,7 @@ void w_collapsible_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_radio_button_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_RadioButton* d = (const W_RadioButton*)ecs_get_id(world, self, W_RadioButton_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -987,6 +1264,7 @@ void w_radio_button_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_radio_group_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_RadioGroup* d = (const W_RadioGroup*)ecs_get_id(world, self, W_RadioGroup_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1017,9 +1295,113 @@ void w_radio_group_layout(struct ecs_world_t* world, cels_entity_t self) {
  * Navigation Layouts
  * ============================================================================ */
 
-void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
-    const W_TabBar* d = (const W_TabBar*)ecs_get_id(world, self, W_TabBar_id);
-    if (!d) return;
+/* Cells reserved for a "< n" / "n >" overflow indicator */
+#define W_TAB_INDICATOR_W 8
+
+static int _decimal_digits(int n) {
+    int d = 1;
+    while (n >= 10) { n /= 10; d++; }
+    return d;
+}
+
+static const char* _tab_name(const W_TabBar* d, int i) {
+    return (d->labels && d->labels[i]) ? d->labels[i] : "?";
+}
+
+/* Cells one tab occupies in the strip. Label widths come from the
+ * per-bar cache; only a slot whose label pointer changed is re-measured. */
+static int _tab_cells(const W_TabBar* d, W_TabBarState* st, int i, bool powerline) {
+    const char* name = _tab_name(d, i);
+    int w;
+    if (st) {
+        int slot = i % W_TAB_WIDTH_CACHE;
+        if (st->width_key[slot] != name) {
+            st->width_key[slot] = name;
+            st->width[slot] = _utf8_width(name);
+        }
+        w = st->width[slot];
+    } else {
+        w = _utf8_width(name);
+    }
+    if (powerline) return w + 3;                    /* " name " + separator */
+    return w + _decimal_digits(i + 1) + 5;          /* " n:name " + padding */
+}
+
+/* Window [lo, hi) of tabs that fits in budget cells and contains the active
+ * tab. Keeps the previous first tab when possible so the strip only scrolls
+ * when the active tab would leave it. Cost is bounded by the window size. */
+static void _tab_window(const W_TabBar* d, W_TabBarState* st, bool powerline,
+                        int budget, int* out_lo, int* out_hi) {
+    int n = d->count;
+    int active = d->active;
+    if (active < 0) active = 0;
+    if (active >= n) active = n - 1;
+
+    int used = _tab_cells(d, st, active, powerline);
+    int lo = active;
+    int hi = active + 1;
+
+    int prev_first = st ? st->first : 0;
+    int left_limit = (prev_first < active) ? prev_first : active;
+    while (lo > left_limit) {
+        int w = _tab_cells(d, st, lo - 1, powerline);
+        if (used + w + 2 * W_TAB_INDICATOR_W > budget) break;
+        used += w;
+        lo--;
+    }
+
+    /* Fill to the right, then back to the left near the end of the list */
+    while (hi < n) {
+        int w = _tab_cells(d, st, hi, powerline);
+        int ind = (lo > 0 ? W_TAB_INDICATOR_W : 0) + (hi + 1 < n ? W_TAB_INDICATOR_W : 0);
+        if (used + w + ind > budget) break;
+        used += w;
+        hi++;
+    }
+    while (lo > 0) {
+        int w = _tab_cells(d, st, lo - 1, powerline);
+        int ind = (lo - 1 > 0 ? W_TAB_INDICATOR_W : 0) + (hi < n ? W_TAB_INDICATOR_W : 0);
+        if (used + w + ind > budget) break;
+        used += w;
+        lo--;
+    }
+
+    if (st) st->first = lo;
+    *out_lo = lo;
+    *out_hi = hi;
+}
+
+/* Tab text: prefix, the full label (never truncated), trailing space */
+static void _emit_tab_label(const char* prefix, int prefix_len, const char* name,
+                            CEL_Color fg, CEL_TextAttr attr) {
+    CLAY_TEXT(CEL_Clay_Text(prefix, prefix_len),
+        CLAY_TEXT_CONFIG({ .textColor = fg, .userData = w_pack_text_attr(attr) }));
+    CLAY_TEXT(CEL_Clay_Text(name, (int)strlen(name)),
+        CLAY_TEXT_CONFIG({ .textColor = fg, .userData = w_pack_text_attr(attr) }));
+    CLAY_TEXT(CEL_Clay_Text(" ", 1),
+        CLAY_TEXT_CONFIG({ .textColor = fg, .userData = w_pack_text_attr(attr) }));
+}
+
+/* "< n" / "n >" marker for tabs scrolled out of the strip */
+static void _emit_tab_overflow(int hidden, bool left, CEL_Color fg, CEL_Color bg) {
+    char buf[24];
+    int len = left ? snprintf(buf, sizeof(buf), " < %d ", hidden)
+                   : snprintf(buf, sizeof(buf), " %d > ", hidden);
+    CEL_Clay(
+        .layout = {
+            .sizing = { .height = CLAY_SIZING_FIXED(1) }
+        },
+        .backgroundColor = bg
+    ) {
+        CLAY_TEXT(CEL_Clay_Text(buf, len),
+            CLAY_TEXT_CONFIG({ .textColor = fg,
+                              .userData = w_pack_text_attr((CEL_TextAttr){0}) }));
+    }
+}
+
+/* Tab strip shared by W_TabBar and W_TabView. Only the window of tabs
+ * around the active one is laid out (st = NULL: no cache, window from 0). */
+static void _emit_tab_strip(const W_TabBar* d, W_TabBarState* st) {
     const Widget_Theme* t = Widget_get_theme();
     const Widget_TabBarStyle* s = d->style;
 
@@ -1032,6 +1414,15 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
     CEL_Color active_tab_bg = (s && s->active_bg.a > 0) ? s->active_bg : t->interactive_active.color;
     CEL_Color inactive_tab_bg = t->surface_alt.color;
 
+    /* Tab bars span the terminal; size the window to its width */
+    const CELS_Window* win = cels_window_get(cels_get_context());
+    int budget = (win && win->width > 0) ? win->width : 80;
+
+    int lo = 0, hi = 0;
+    if (d->count > 0) {
+        _tab_window(d, st, powerline, budget, &lo, &hi);
+    }
+
     if (powerline) {
         /* ---- Powerline-styled tab rendering ---- */
         /* Select separator glyph (same set as Widget_Powerline) */
@@ -1046,17 +1437,16 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
                 .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) }
             }
         ) {
-            for (int i = 0; i < d->count; i++) {
-                const char* name = (d->labels && d->labels[i]) ? d->labels[i] : "?";
+            if (lo > 0) _emit_tab_overflow(lo, true, inactive_fg, inactive_tab_bg);
+
+            for (int i = lo; i < hi; i++) {
+                const char* name = _tab_name(d, i);
                 bool active = (i == d->active);
 
                 CEL_Color tab_bg = active ? active_tab_bg : inactive_tab_bg;
                 CEL_Color tab_fg = active ? active_fg : inactive_fg;
                 CEL_TextAttr tab_attr = active ? active_attr : (CEL_TextAttr){0};
 
-                char tab_buf[32];
-                int tab_len = snprintf(tab_buf, sizeof(tab_buf), " %s ", name);
-
                 /* Tab segment */
                 CEL_Clay(
                     .layout = {
@@ -1064,13 +1454,11 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
                     },
                     .backgroundColor = tab_bg
                 ) {
-                    CLAY_TEXT(CEL_Clay_Text(tab_buf, tab_len),
-                        CLAY_TEXT_CONFIG({ .textColor = tab_fg,
-                                          .userData = w_pack_text_attr(tab_attr) }));
+                    _emit_tab_label(" ", 1, name, tab_fg, tab_attr);
                 }
 
                 /* Separator between tabs */
-                if (i < d->count - 1) {
+                if (i < hi - 1) {
                     CEL_Color sep_fg_c = tab_bg;  /* Arrow tip = current tab color */
                     bool next_active = ((i + 1) == d->active);
                     CEL_Color sep_bg_c = next_active ? active_tab_bg : inactive_tab_bg;
@@ -1087,9 +1475,13 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
                     }
                 }
             }
+
+            if (hi < d->count) {
+                _emit_tab_overflow(d->count - hi, false, inactive_fg, inactive_tab_bg);
+            }
         }
     } else {
-        /* ---- Standard tab rendering (unchanged) ---- */
+        /* ---- Standard tab rendering ---- */
         CEL_Color active_border = t->primary.color;
         CEL_Color std_active_tab_bg = (s && s->active_bg.a > 0) ? s->active_bg : t->surface_raised.color;
 
@@ -1102,13 +1494,15 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
             },
             .backgroundColor = bar_bg
         ) {
-            for (int i = 0; i < d->count; i++) {
-                const char* name = (d->labels && d->labels[i]) ? d->labels[i] : "?";
+            if (lo > 0) _emit_tab_overflow(lo, true, inactive_fg, bar_bg);
+
+            for (int i = lo; i < hi; i++) {
+                const char* name = _tab_name(d, i);
                 bool active = (i == d->active);
                 CEL_Color tab_fg = active ? t->primary.color : inactive_fg;
 
-                char tab_buf[32];
-                int tab_len = snprintf(tab_buf, sizeof(tab_buf), " %d:%s ", i + 1, name);
+                char num_buf[16];
+                int num_len = snprintf(num_buf, sizeof(num_buf), " %d:", i + 1);
 
                 if (active) {
                     /* Active tab: 2 rows tall with rounded top corners */
@@ -1125,9 +1519,7 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
                         },
                         .cornerRadius = { .topLeft = 1, .topRight = 1 }
                     ) {
-                        CLAY_TEXT(CEL_Clay_Text(tab_buf, tab_len),
-                            CLAY_TEXT_CONFIG({ .textColor = tab_fg,
-                                              .userData = w_pack_text_attr(active_attr) }));
+                        _emit_tab_label(num_buf, num_len, name, tab_fg, active_attr);
                     }
                 } else {
                     /* Inactive tabs: 1 row, aligned to bottom */
@@ -1138,17 +1530,28 @@ void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
                         },
                         .backgroundColor = bar_bg
                     ) {
-                        CLAY_TEXT(CEL_Clay_Text(tab_buf, tab_len),
-                            CLAY_TEXT_CONFIG({ .textColor = tab_fg,
-                                              .userData = w_pack_text_attr((CEL_TextAttr){0}) }));
+                        _emit_tab_label(num_buf, num_len, name, tab_fg, (CEL_TextAttr){0});
                     }
                 }
             }
+
+            if (hi < d->count) {
+                _emit_tab_overflow(d->count - hi, false, inactive_fg, bar_bg);
+            }
         }
     }
 }
 
+void w_tab_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_TabBar* d = (const W_TabBar*)ecs_get_id(world, self, W_TabBar_id);
+    if (!d) return;
+    W_TabBarState* st = (W_TabBarState*)ecs_get_mut_id(world, self, W_TabBarState_id);
+    _emit_tab_strip(d, st);
+}
+
 void w_tab_content_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_TabContent* d = (const W_TabContent*)ecs_get_id(world, self, W_TabContent_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1182,7 +1585,68 @@ void w_tab_content_layout(struct ecs_world_t* world, cels_entity_t self) {
     }
 }
 
+void w_tab_view_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_TabView* d = (const W_TabView*)ecs_get_id(world, self, W_TabView_id);
+    if (!d) return;
+
+    W_TabBar strip = {
+        .active = d->active, .count = d->count,
+        .labels = d->labels, .style = d->style
+    };
+    W_TabBarState* strip_state = (W_TabBarState*)ecs_get_mut_id(
+        world, self, W_TabBarState_id);
+
+    /* Position of the active page among the children; kept-alive pages
+     * for other tabs are skipped */
+    int active_child = -1;
+    int pos = 0;
+    ecs_iter_t cit = ecs_children(world, self);
+    while (ecs_children_next(&cit)) {
+        for (int c = 0; c < cit.count; c++, pos++) {
+            const W_TabPage* page = (const W_TabPage*)ecs_get_id(
+                world, cit.entities[c], W_TabPage_id);
+            if (active_child < 0 && page && page->index == d->active) {
+                active_child = pos;
+            }
+        }
+    }
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+        }
+    ) {
+        _emit_tab_strip(&strip, strip_state);
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+            }
+        ) {
+            if (active_child >= 0) {
+                CEL_Clay_ChildAt(active_child);
+            }
+        }
+    }
+}
+
+void w_tab_page_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    (void)world; (void)self;
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+        }
+    ) {
+        CEL_Clay_Children();
+    }
+}
+
 void w_status_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_StatusBar* d = (const W_StatusBar*)ecs_get_id(world, self, W_StatusBar_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1225,17 +1689,96 @@ void w_status_bar_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_list_view_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_ListView* d = (const W_ListView*)ecs_get_id(world, self, W_ListView_id);
     (void)d;
     const Widget_Theme* t = Widget_get_theme();
     const Widget_ListViewStyle* s = (d ? d->style : NULL);
 
-    /* Read W_Scrollable for scroll state (behavioral component) */
-    const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(world, self, W_Scrollable_id);
-    (void)scr; /* Available for future scroll offset inspection */
-
     CEL_Color bg_color = (s && s->bg.a > 0) ? s->bg : t->surface.color;
 
+    /* Multi-select: wrap each windowed child in a row that shows the cursor
+     * and marked state. Selection indices are source item indices. */
+    if (d && d->selection) {
+        CEL_Color marked_bg = (s && s->marked_bg.a > 0) ? s->marked_bg : t->surface_raised.color;
+        CEL_Color cursor_bg = (s && s->cursor_bg.a > 0) ? s->cursor_bg : t->interactive_active.color;
+        int match_count = d->item_count;
+        const int* matches = d->fuzzy ? Widget_fuzzy_matches(d->fuzzy, &match_count) : NULL;
+        const W_SelectionState* ss = (const W_SelectionState*)ecs_get_id(
+            world, self, W_SelectionState_id);
+        W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+        int visible = (scroll && scroll->visible_count > 0) ? scroll->visible_count : match_count;
+        if (scroll) scroll->total_count = match_count;
+        int offset = scroll ? Widget_scroll_offset(world, self) : 0;
+        if (offset > match_count - visible) offset = match_count - visible;
+        if (offset < 0) offset = 0;
+        int end = offset + visible;
+        if (end > match_count) end = match_count;
+
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = {
+                    .width = CLAY_SIZING_GROW(0),
+                    .height = CLAY_SIZING_GROW(0)
+                }
+            },
+            .backgroundColor = bg_color
+        ) {
+            for (int i = offset; i < end; i++) {
+                int item = matches ? matches[i] : i;
+                bool marked = Widget_selection_contains(d->selection, item);
+                bool at_cursor = ss && ss->cursor == i;
+                CEL_Clay(
+                    .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } },
+                    .backgroundColor = at_cursor ? cursor_bg : marked ? marked_bg : (CEL_Color){0}
+                ) {
+                    CEL_Clay_ChildAt(item);
+                }
+            }
+        }
+
+        if (scroll) {
+            ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+        }
+        return;
+    }
+
+    /* Fuzzy-filtered: emit only matching children, ranked, windowed by
+     * W_Scrollable so large lists lay out just the visible matches */
+    if (d && d->fuzzy) {
+        int match_count = 0;
+        const int* matches = Widget_fuzzy_matches(d->fuzzy, &match_count);
+        W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+        int visible = (scroll && scroll->visible_count > 0) ? scroll->visible_count : match_count;
+        if (scroll) scroll->total_count = match_count;
+        int offset = scroll ? Widget_scroll_offset(world, self) : 0;
+        if (offset > match_count - visible) offset = match_count - visible;
+        if (offset < 0) offset = 0;
+        int end = offset + visible;
+        if (end > match_count) end = match_count;
+
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = {
+                    .width = CLAY_SIZING_GROW(0),
+                    .height = CLAY_SIZING_GROW(0)
+                }
+            },
+            .backgroundColor = bg_color
+        ) {
+            for (int i = offset; i < end; i++) {
+                CEL_Clay_ChildAt(matches[i]);
+            }
+        }
+
+        if (scroll) {
+            ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+        }
+        return;
+    }
+
     CEL_Clay(
         .layout = {
             .layoutDirection = CLAY_TOP_TO_BOTTOM,
@@ -1255,6 +1798,7 @@ void w_list_view_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_list_item_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_ListItem* d = (const W_ListItem*)ecs_get_id(world, self, W_ListItem_id);
     if (!d || !d->label) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1299,6 +1843,7 @@ void w_list_item_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_navigation_group_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_NavigationScope* scope = (const W_NavigationScope*)ecs_get_id(
         world, self, W_NavigationScope_id);
     int direction = scope ? scope->direction : 0;
@@ -1324,6 +1869,7 @@ void w_navigation_group_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_text_input_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_TextInput* d = (const W_TextInput*)ecs_get_id(world, self, W_TextInput_id);
     if (!d) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1509,6 +2055,7 @@ void w_text_input_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_popup_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Popup* d = (const W_Popup*)ecs_get_id(world, self, W_Popup_id);
     if (!d || !d->visible) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1585,6 +2132,7 @@ void w_popup_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_modal_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Modal* d = (const W_Modal*)ecs_get_id(world, self, W_Modal_id);
     if (!d || !d->visible) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1657,6 +2205,7 @@ void w_modal_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_window_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Window* d = (const W_Window*)ecs_get_id(world, self, W_Window_id);
     if (!d || !d->visible) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -1675,16 +2224,38 @@ void w_window_layout(struct ecs_world_t* world, cels_entity_t self) {
     CEL_TextAttr title_attr = t->content_title.attr;
 
     int w = (d->width > 0) ? d->width : 40;
+    int h = d->height;
+    int x = d->x;
+    int y = d->y;
+
+    /* Tiled: the tile rect replaces position and size. Tracking the
+     * terminal size is a no-op unless it changed. */
+    const W_Tiled* tiled = (const W_Tiled*)ecs_get_id(world, self, W_Tiled_id);
+    W_TileRect tile;
+    bool is_tiled = false;
+    if (tiled && tiled->tree) {
+        const CELS_Window* win = cels_window_get(cels_get_context());
+        int term_w = (win && win->width > 0) ? win->width : 80;
+        int term_h = (win && win->height > 0) ? win->height : 24;
+        Widget_tile_area(tiled->tree, 0, 0, term_w, term_h);
+        is_tiled = Widget_tile_rect(tiled->tree, self, &tile);
+    }
+    if (is_tiled) {
+        x = tile.x;
+        y = tile.y;
+        w = tile.w;
+        h = tile.h;
+    }
     float w_px = (float)w / CEL_CELL_ASPECT_RATIO;
 
-    Clay_SizingAxis h_axis = (d->height > 0)
-        ? CLAY_SIZING_FIXED((float)d->height)
+    Clay_SizingAxis h_axis = (h > 0)
+        ? CLAY_SIZING_FIXED((float)h)
         : CLAY_SIZING_FIT(0);
 
     /* Position: center if x==0 && y==0, otherwise offset from top-left */
     Clay_FloatingAttachPoints attach;
     Clay_Vector2 offset;
-    if (d->x == 0 && d->y == 0) {
+    if (x == 0 && y == 0 && !is_tiled) {
         attach = (Clay_FloatingAttachPoints){
             .element = CLAY_ATTACH_POINT_CENTER_CENTER,
             .parent = CLAY_ATTACH_POINT_CENTER_CENTER
@@ -1696,8 +2267,8 @@ void w_window_layout(struct ecs_world_t* world, cels_entity_t self) {
             .parent = CLAY_ATTACH_POINT_LEFT_TOP
         };
         offset = (Clay_Vector2){
-            .x = (float)d->x / CEL_CELL_ASPECT_RATIO,
-            .y = (float)d->y
+            .x = (float)x / CEL_CELL_ASPECT_RATIO,
+            .y = (float)y
         };
     }
 
@@ -1737,82 +2308,91 @@ void w_window_layout(struct ecs_world_t* world, cels_entity_t self) {
     }
 }
 
-void w_toast_layout(struct ecs_world_t* world, cels_entity_t self) {
-    const W_Toast* d = (const W_Toast*)ecs_get_id(world, self, W_Toast_id);
-    if (!d || d->dismissed) return;
-    const Widget_Theme* t = Widget_get_theme();
-    const Widget_ToastStyle* s = d->style;
-
-    /* Severity-based background color (style override > defaults) */
+/* Severity background + indicator prefix (style override > defaults) */
+static CEL_Color _toast_severity(const Widget_ToastStyle* s, const Widget_Theme* t,
+                                 int severity, const char** indicator) {
     CEL_Color bg_color;
-    const char* indicator;
-    switch (d->severity) {
+    switch (severity) {
         case 1:  /* success */
             bg_color = (s && s->success_color.a > 0) ? s->success_color
                        : (CEL_Color){60, 180, 80, 255};
-            indicator = "[+] ";
+            *indicator = "[+] ";
             break;
         case 2:  /* warning */
             bg_color = (s && s->warning_color.a > 0) ? s->warning_color
                        : (CEL_Color){220, 180, 40, 255};
-            indicator = "[!] ";
+            *indicator = "[!] ";
             break;
         case 3:  /* error */
             bg_color = (s && s->error_color.a > 0) ? s->error_color
                        : (CEL_Color){200, 60, 60, 255};
-            indicator = "[x] ";
+            *indicator = "[x] ";
             break;
         default: /* info */
             bg_color = (s && s->info_color.a > 0) ? s->info_color
                        : t->primary.color;
-            indicator = "[i] ";
+            *indicator = "[i] ";
             break;
     }
-    /* Style-level bg/fg overrides on top of severity */
+    /* Style-level bg override on top of severity */
     if (s && s->bg.a > 0) bg_color = s->bg;
-    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg
-        : (CEL_Color){255, 255, 255, 255};
-
-    /* Toast width: based on message length (indicator + message + padding), min 20, max 50 */
-    int msg_len = d->message ? (int)strlen(d->message) : 0;
-    int content_len = 4 + msg_len + 2; /* "[x] " + message + padding */
-    if (content_len < 20) content_len = 20;
-    if (content_len > 50) content_len = 50;
-    float toast_width = (float)content_len / CEL_CELL_ASPECT_RATIO;
+    return bg_color;
+}
 
-    /* Position-based attach points and offsets */
-    Clay_FloatingAttachPoints attach;
-    Clay_Vector2 offset;
-    switch (d->position) {
+/* Position-based attach points; returns the offset from the root edge */
+static Clay_Vector2 _toast_anchor(int position, Clay_FloatingAttachPoints* attach) {
+    switch (position) {
         case 1:  /* bottom-center */
-            attach = (Clay_FloatingAttachPoints){
+            *attach = (Clay_FloatingAttachPoints){
                 .element = CLAY_ATTACH_POINT_CENTER_BOTTOM,
                 .parent = CLAY_ATTACH_POINT_CENTER_BOTTOM
             };
-            offset = (Clay_Vector2){ .x = 0, .y = -1 };
-            break;
+            return (Clay_Vector2){ .x = 0, .y = -1 };
         case 2:  /* top-right */
-            attach = (Clay_FloatingAttachPoints){
+            *attach = (Clay_FloatingAttachPoints){
                 .element = CLAY_ATTACH_POINT_RIGHT_TOP,
                 .parent = CLAY_ATTACH_POINT_RIGHT_TOP
             };
-            offset = (Clay_Vector2){ .x = -2, .y = 1 };
-            break;
+            return (Clay_Vector2){ .x = -2, .y = 1 };
         case 3:  /* top-center */
-            attach = (Clay_FloatingAttachPoints){
+            *attach = (Clay_FloatingAttachPoints){
                 .element = CLAY_ATTACH_POINT_CENTER_TOP,
                 .parent = CLAY_ATTACH_POINT_CENTER_TOP
             };
-            offset = (Clay_Vector2){ .x = 0, .y = 1 };
-            break;
+            return (Clay_Vector2){ .x = 0, .y = 1 };
         default: /* 0 = bottom-right */
-            attach = (Clay_FloatingAttachPoints){
+            *attach = (Clay_FloatingAttachPoints){
                 .element = CLAY_ATTACH_POINT_RIGHT_BOTTOM,
                 .parent = CLAY_ATTACH_POINT_RIGHT_BOTTOM
             };
-            offset = (Clay_Vector2){ .x = -2, .y = -1 };
-            break;
+            return (Clay_Vector2){ .x = -2, .y = -1 };
     }
+}
+
+/* Toast width: indicator + message + padding, min 20, max 50 */
+static float _toast_width(int content_len) {
+    if (content_len < 20) content_len = 20;
+    if (content_len > 50) content_len = 50;
+    return (float)content_len / CEL_CELL_ASPECT_RATIO;
+}
+
+void w_toast_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_Toast* d = (const W_Toast*)ecs_get_id(world, self, W_Toast_id);
+    if (!d || d->dismissed) return;
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_ToastStyle* s = d->style;
+
+    const char* indicator;
+    CEL_Color bg_color = _toast_severity(s, t, d->severity, &indicator);
+    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg
+        : (CEL_Color){255, 255, 255, 255};
+
+    int msg_len = d->message ? (int)strlen(d->message) : 0;
+    float toast_width = _toast_width(4 + msg_len + 2); /* "[x] " + message + padding */
+
+    Clay_FloatingAttachPoints attach;
+    Clay_Vector2 offset = _toast_anchor(d->position, &attach);
 
     CEL_Clay(
         .layout = {
@@ -1847,15 +2427,118 @@ void w_toast_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 /* ============================================================================
- * Split Pane Layout
+ * Toast Stack Layout
+ *
+ * One floating column per position that has live toasts. Rows are the
+ * visible toasts, oldest nearest the screen edge; a trailing "+N more"
+ * line counts the queue. Deduplicated toasts show their repeat count.
  * ============================================================================ */
 
-void w_split_pane_layout(struct ecs_world_t* world, cels_entity_t self) {
-    const W_SplitPane* d = (const W_SplitPane*)ecs_get_id(world, self, W_SplitPane_id);
+void w_toast_stack_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_ToastStack* d = (const W_ToastStack*)ecs_get_id(world, self, W_ToastStack_id);
+    if (!d || !d->manager) return;
     const Widget_Theme* t = Widget_get_theme();
-    const Widget_SplitStyle* s = (d ? d->style : NULL);
+    const Widget_ToastStyle* s = d->style;
+    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg
+        : (CEL_Color){255, 255, 255, 255};
 
-    float ratio = (d && d->ratio > 0.0f) ? d->ratio : 0.5f;
+    for (int pos = 0; pos < W_TOAST_POSITIONS; pos++) {
+        const W_ToastRecord* toasts[W_TOAST_VISIBLE_MAX];
+        int n = Widget_toasts_visible(d->manager, pos, toasts, W_TOAST_VISIBLE_MAX);
+        int queued = Widget_toasts_queued(d->manager, pos);
+        if (n == 0 && queued == 0) continue;
+
+        /* Bottom positions grow upward: newest row on top */
+        bool bottom = (pos == 0 || pos == 1);
+
+        /* Column width: widest row */
+        int widest = 0;
+        for (int i = 0; i < n; i++) {
+            int len = 4 + (int)strlen(toasts[i]->message) + 2;
+            if (toasts[i]->count > 1) len += 6;
+            if (len > widest) widest = len;
+        }
+        float toast_width = _toast_width(widest);
+
+        Clay_FloatingAttachPoints attach;
+        Clay_Vector2 offset = _toast_anchor(pos, &attach);
+
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = {
+                    .width = CLAY_SIZING_FIXED(toast_width),
+                    .height = CLAY_SIZING_FIT(0)
+                }
+            },
+            .floating = {
+                .attachTo = CLAY_ATTACH_TO_ROOT,
+                .attachPoints = attach,
+                .offset = offset,
+                .zIndex = 300,
+                .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH
+            }
+        ) {
+            if (queued > 0 && !bottom) {
+                char more_buf[24];
+                int more_len = snprintf(more_buf, sizeof(more_buf), " +%d more", queued);
+                CLAY_TEXT(CEL_Clay_Text(more_buf, more_len),
+                    CLAY_TEXT_CONFIG({ .textColor = t->content_muted.color,
+                                      .userData = w_pack_text_attr(t->content_muted.attr) }));
+            }
+
+            for (int k = 0; k < n; k++) {
+                const W_ToastRecord* rec = toasts[bottom ? n - 1 - k : k];
+                const char* indicator;
+                CEL_Color bg_color = _toast_severity(s, t, rec->severity, &indicator);
+
+                CEL_Clay(
+                    .layout = {
+                        .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                        .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIT(0) },
+                        .padding = { .left = 1, .right = 1 }
+                    },
+                    .backgroundColor = bg_color
+                ) {
+                    CLAY_TEXT(CEL_Clay_Text(indicator, (int)strlen(indicator)),
+                        CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                          .userData = w_pack_text_attr((CEL_TextAttr){ .bold = true }) }));
+                    CLAY_TEXT(CEL_Clay_Text(rec->message, (int)strlen(rec->message)),
+                        CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                          .userData = w_pack_text_attr((CEL_TextAttr){0}) }));
+                    if (rec->count > 1) {
+                        char count_buf[16];
+                        int count_len = snprintf(count_buf, sizeof(count_buf), " x%d", rec->count);
+                        CLAY_TEXT(CEL_Clay_Text(count_buf, count_len),
+                            CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                              .userData = w_pack_text_attr((CEL_TextAttr){ .bold = true }) }));
+                    }
+                }
+            }
+
+            if (queued > 0 && bottom) {
+                char more_buf[24];
+                int more_len = snprintf(more_buf, sizeof(more_buf), " +%d more", queued);
+                CLAY_TEXT(CEL_Clay_Text(more_buf, more_len),
+                    CLAY_TEXT_CONFIG({ .textColor = t->content_muted.color,
+                                      .userData = w_pack_text_attr(t->content_muted.attr) }));
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * Split Pane Layout
+ * ============================================================================ */
+
+void w_split_pane_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_SplitPane* d = (const W_SplitPane*)ecs_get_id(world, self, W_SplitPane_id);
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_SplitStyle* s = (d ? d->style : NULL);
+
+    float ratio = (d && d->ratio > 0.0f) ? d->ratio : 0.5f;
     int direction = d ? d->direction : 0;
 
     /* Divider color: style override or theme */
@@ -1942,36 +2625,12 @@ void w_split_pane_layout(struct ecs_world_t* world, cels_entity_t self) {
  * Scrollable Container Layout
  * ============================================================================ */
 
-/* ============================================================================
- * Data Visualization Helpers
- * ============================================================================ */
-
-static CEL_Color w_color_lerp(CEL_Color a, CEL_Color b, float t) {
-    if (t <= 0.0f) return a;
-    if (t >= 1.0f) return b;
-    return (CEL_Color){
-        .r = (float)(a.r + (b.r - a.r) * t),
-        .g = (float)(a.g + (b.g - a.g) * t),
-        .b = (float)(a.b + (b.b - a.b) * t),
-        .a = 255
-    };
-}
-
-/* Three-stop gradient: start -> mid -> end based on normalized [0,1] value */
-static CEL_Color w_value_gradient(float normalized,
-                                   CEL_Color start, CEL_Color mid, CEL_Color end) {
-    if (normalized < 0.5f) {
-        return w_color_lerp(start, mid, normalized * 2.0f);
-    } else {
-        return w_color_lerp(mid, end, (normalized - 0.5f) * 2.0f);
-    }
-}
-
 /* ============================================================================
  * Data Visualization Layouts
  * ============================================================================ */
 
 void w_spark_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Spark* d = (const W_Spark*)ecs_get_id(world, self, W_Spark_id);
     if (!d || d->count <= 0 || !d->values) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -2041,6 +2700,7 @@ void w_spark_layout(struct ecs_world_t* world, cels_entity_t self) {
 }
 
 void w_bar_chart_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_BarChart* d = (const W_BarChart*)ecs_get_id(world, self, W_BarChart_id);
     if (!d || d->count <= 0 || !d->entries) return;
     const Widget_Theme* t = Widget_get_theme();
@@ -2150,15 +2810,16 @@ void w_bar_chart_layout(struct ecs_world_t* world, cels_entity_t self) {
  * ============================================================================ */
 
 void w_scrollable_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_ScrollContainer* d = (const W_ScrollContainer*)ecs_get_id(
         world, self, W_ScrollContainer_id);
     const Widget_Theme* t = Widget_get_theme();
     const Widget_ScrollableStyle* s = (d ? d->style : NULL);
 
-    /* Read scroll state from behavioral component */
+    /* Extent from the behavioral component, offset from W_UiState */
     const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(
         world, self, W_Scrollable_id);
-    int offset = scr ? scr->scroll_offset : 0;
+    int offset = scr ? Widget_scroll_offset(world, self) : 0;
     int total = scr ? scr->total_count : 0;
     int visible = scr ? scr->visible_count : 0;
     bool needs_scrollbar = total > visible && visible > 0;
@@ -2209,58 +2870,43 @@ void w_scrollable_layout(struct ecs_world_t* world, cels_entity_t self) {
 
         /* Scrollbar gutter (only when content overflows) */
         if (needs_scrollbar) {
-            int track_h = vp_height;
-            int thumb_h = (visible * track_h) / total;
-            if (thumb_h < 1) thumb_h = 1;
-            int max_off = total - visible;
-            int thumb_y = (max_off > 0) ? (offset * (track_h - thumb_h)) / max_off : 0;
-            int track_below = track_h - thumb_y - thumb_h;
-            if (track_below < 0) track_below = 0;
-
-            /* 1-terminal-cell wide gutter column (divide by aspect ratio) */
-            float cell_w = 1.0f / CEL_CELL_ASPECT_RATIO;
-            CEL_Clay(
-                .layout = {
-                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
-                    .sizing = {
-                        .width = CLAY_SIZING_FIXED(cell_w),
-                        .height = CLAY_SIZING_GROW(0)
-                    }
-                }
-            ) {
-                /* Track above thumb */
-                if (thumb_y > 0) {
-                    CEL_Clay(
-                        .layout = { .sizing = {
-                            .width = CLAY_SIZING_FIXED(cell_w),
-                            .height = CLAY_SIZING_FIXED((float)thumb_y)
-                        }},
-                        .backgroundColor = track_color
-                    ) {}
-                }
-                /* Thumb */
-                CEL_Clay(
-                    .layout = { .sizing = {
-                        .width = CLAY_SIZING_FIXED(cell_w),
-                        .height = CLAY_SIZING_FIXED((float)thumb_h)
-                    }},
-                    .backgroundColor = thumb_color
-                ) {}
-                /* Track below thumb */
-                if (track_below > 0) {
-                    CEL_Clay(
-                        .layout = { .sizing = {
-                            .width = CLAY_SIZING_FIXED(cell_w),
-                            .height = CLAY_SIZING_FIXED((float)track_below)
-                        }},
-                        .backgroundColor = track_color
-                    ) {}
-                }
-            }
+            _emit_scrollbar(vp_height, offset, visible, total, track_color, thumb_color);
         }
     }
 }
 
+/* ============================================================================
+ * Theme Scope Layout
+ *
+ * Transparent container: resolves the scope's effective theme (cached in
+ * W_ThemeScopeState) and makes it current while the children lay out.
+ * Relies on CEL_Clay_Children() laying out children inline.
+ * ============================================================================ */
+
+void w_theme_scope_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_ThemeScope* d = (const W_ThemeScope*)ecs_get_id(world, self, W_ThemeScope_id);
+    W_ThemeScopeState* st = (W_ThemeScopeState*)ecs_get_mut_id(
+        world, self, W_ThemeScopeState_id);
+
+    bool scoped = d && d->theme && st;
+    if (scoped) {
+        const Widget_Theme* theme = Widget_theme_resolve(&st->cache, d->theme);
+        Widget_theme_push(theme, st->cache.generation);
+    }
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+        }
+    ) {
+        CEL_Clay_Children();
+    }
+
+    if (scoped) Widget_theme_pop();
+}
+
 /* ============================================================================
  * Powerline Layout
  * ============================================================================ */
@@ -2289,6 +2935,7 @@ static const PowerlineGlyphs PL_NERD = {
  * ============================================================================ */
 
 void w_log_viewer_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_LogViewer* d = (const W_LogViewer*)ecs_get_id(
         world, self, W_LogViewer_id);
     if (!d || d->entry_count <= 0 || !d->entries) {
@@ -2368,23 +3015,21 @@ void w_log_viewer_layout(struct ecs_world_t* world, cels_entity_t self) {
     int max_offset = filtered_count - content_rows;
     if (max_offset < 0) max_offset = 0;
 
+    /* Clamped to the extent set above */
+    int offset = Widget_scroll_offset(world, self);
     if (state->auto_scroll && new_entries) {
-        scroll->scroll_offset = max_offset;
+        offset = Widget_scroll_set(world, self, max_offset);
     }
 
     /* Detect manual scroll-up: user scrolled away from bottom */
-    if (scroll->scroll_offset < max_offset) {
+    if (offset < max_offset) {
         state->auto_scroll = false;
     }
     /* Detect scroll-to-bottom: re-enable auto-scroll */
-    if (scroll->scroll_offset >= max_offset && max_offset > 0) {
+    if (offset >= max_offset && max_offset > 0) {
         state->auto_scroll = true;
     }
 
-    int offset = scroll->scroll_offset;
-    if (offset < 0) offset = 0;
-    if (offset > max_offset) offset = max_offset;
-
     bool needs_scrollbar = filtered_count > content_rows && content_rows > 0;
 
     /* ---- Colors ---- */
@@ -2534,63 +3179,635 @@ void w_log_viewer_layout(struct ecs_world_t* world, cels_entity_t self) {
 
         /* ---- Scrollbar gutter (right side) ---- */
         if (needs_scrollbar) {
-            int track_h = content_rows;
-            int thumb_h = (content_rows * track_h) / filtered_count;
-            if (thumb_h < 1) thumb_h = 1;
-            int thumb_y = (max_offset > 0) ? (offset * (track_h - thumb_h)) / max_offset : 0;
-            int track_below = track_h - thumb_y - thumb_h;
-            if (track_below < 0) track_below = 0;
-
-            float cell_w = 1.0f / CEL_CELL_ASPECT_RATIO;
+            _emit_scrollbar(content_rows, offset, content_rows, filtered_count,
+                            track_color, thumb_color);
+        }
+    }
+
+    /* Write back modified state */
+    ecs_set_id(world, self, W_LogViewerState_id,
+               sizeof(W_LogViewerState), state);
+    ecs_set_id(world, self, W_Scrollable_id,
+               sizeof(W_Scrollable), scroll);
+}
+
+/* ============================================================================
+ * Command Palette Layout
+ *
+ * Centered floating box above modals: prompt line with the query, then up
+ * to max_results ranked commands (label left, key hint right). Query and
+ * selection live in W_CommandPaletteState, edited by the focus system.
+ * ============================================================================ */
+
+void w_command_palette_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_CommandPalette* d = (const W_CommandPalette*)ecs_get_id(world, self, W_CommandPalette_id);
+    if (!d || !d->visible) return;
+    const W_CommandPaletteState* st = (const W_CommandPaletteState*)ecs_get_id(
+        world, self, W_CommandPaletteState_id);
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_CommandPaletteStyle* s = d->style;
+
+    CEL_Color bg_color = (s && s->bg.a > 0) ? s->bg : t->surface_raised.color;
+    CEL_Color bdr_color = (s && s->border_color.a > 0) ? s->border_color : t->border_focused.color;
+    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg : t->content.color;
+    CEL_TextAttr text_attr = t->content.attr;
+    CEL_Color hint_fg = (s && s->hint_color.a > 0) ? s->hint_color : t->content_muted.color;
+    CEL_TextAttr hint_attr = t->content_muted.attr;
+    CEL_Color prompt_fg = (s && s->prompt_color.a > 0) ? s->prompt_color : t->primary.color;
+    CEL_Color selected_bg = (s && s->selected_bg.a > 0) ? s->selected_bg : t->interactive_active.color;
+    CEL_Color selected_fg = t->primary_content.color;
+
+    const char* query = (st && st->query_len > 0) ? st->query : "";
+    int selected = st ? st->selected : 0;
+    int max_results = (d->max_results > 0) ? d->max_results : 12;
+    int w = (d->width > 0) ? d->width : 60;
+    float w_px = (float)w / CEL_CELL_ASPECT_RATIO;
+
+    int result_count = 0;
+    const int* results = Widget_palette_results(query, max_results, &result_count);
+
+    CelClayBorderDecor* decor = _alloc_border_decor();
+    *decor = (CelClayBorderDecor){
+        .title = "Commands",
+        .border_color = bdr_color,
+        .title_color = t->content_title.color,
+        .bg_color = bg_color,
+        .border_style = 0,
+        .title_text_attr = (uintptr_t)w_pack_text_attr(t->content_title.attr)
+    };
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_FIXED(w_px), .height = CLAY_SIZING_FIT(0) },
+            .padding = { .left = 1, .right = 1, .top = 1, .bottom = 1 }
+        },
+        .backgroundColor = bg_color,
+        .userData = decor,
+        .floating = {
+            .attachTo = CLAY_ATTACH_TO_ROOT,
+            .attachPoints = {
+                .element = CLAY_ATTACH_POINT_CENTER_TOP,
+                .parent = CLAY_ATTACH_POINT_CENTER_TOP
+            },
+            .offset = { 0, 2 },
+            .zIndex = 300,
+            .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH
+        }
+    ) {
+        /* Prompt line */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) }
+            }
+        ) {
+            CLAY_TEXT(CLAY_STRING("> "),
+                CLAY_TEXT_CONFIG({ .textColor = prompt_fg,
+                                  .userData = w_pack_text_attr(text_attr) }));
+            if (query[0]) {
+                CLAY_TEXT(CEL_Clay_Text(query, (int)strlen(query)),
+                    CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                      .userData = w_pack_text_attr(text_attr) }));
+            } else if (d->placeholder) {
+                CLAY_TEXT(CEL_Clay_Text(d->placeholder, (int)strlen(d->placeholder)),
+                    CLAY_TEXT_CONFIG({ .textColor = hint_fg,
+                                      .userData = w_pack_text_attr(hint_attr) }));
+            }
+        }
+
+        /* Ranked results */
+        for (int i = 0; i < result_count; i++) {
+            const W_Command* cmd = Widget_palette_command(results[i]);
+            if (!cmd) continue;
+            bool is_sel = (i == selected);
+            CEL_Color row_fg = is_sel ? selected_fg : text_fg;
+
+            CEL_Clay(
+                .layout = {
+                    .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                    .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) }
+                },
+                .backgroundColor = is_sel ? selected_bg : (CEL_Color){0}
+            ) {
+                CLAY_TEXT(CEL_Clay_Text(cmd->label, (int)strlen(cmd->label)),
+                    CLAY_TEXT_CONFIG({ .textColor = row_fg,
+                                      .userData = w_pack_text_attr(text_attr) }));
+                /* Spacer pushes key hint to far end */
+                CEL_Clay(
+                    .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } }
+                ) {}
+                if (cmd->key_hint) {
+                    CLAY_TEXT(CEL_Clay_Text(cmd->key_hint, (int)strlen(cmd->key_hint)),
+                        CLAY_TEXT_CONFIG({ .textColor = hint_fg,
+                                          .userData = w_pack_text_attr(hint_attr) }));
+                }
+            }
+        }
+
+        if (result_count == 0) {
+            CLAY_TEXT(CLAY_STRING("No matching commands"),
+                CLAY_TEXT_CONFIG({ .textColor = hint_fg,
+                                  .userData = w_pack_text_attr(hint_attr) }));
+        }
+    }
+}
+
+/* ============================================================================
+ * DataGrid Layout
+ *
+ * Row order comes from the W_DataGridIndex (built off-thread). Rows are
+ * virtualized through W_Scrollable; columns are virtualized by width:
+ * frozen columns always render, then scrolled columns starting at
+ * W_DataGridState.col_offset until visible_width is used up. A 500-column
+ * grid therefore lays out only the handful of columns on screen.
+ * ============================================================================ */
+
+#define W_GRID_DEFAULT_COL_WIDTH 12
+
+static int _grid_col_width(const W_DataGridColumn* c) {
+    return c->width > 0 ? c->width : W_GRID_DEFAULT_COL_WIDTH;
+}
+
+/* Format one cell into buf (numeric kinds) or return the text pointer */
+static const char* _grid_cell_text(const W_DataGridColumn* c, int row,
+                                   char* buf, int buf_size, int* out_len) {
+    const char* txt = "";
+    if (c->kind == W_GRID_TEXT) {
+        if (c->text && c->text[row]) txt = c->text[row];
+        *out_len = (int)strlen(txt);
+        return txt;
+    }
+    int len = 0;
+    if (c->kind == W_GRID_INT && c->ints) {
+        len = snprintf(buf, (size_t)buf_size, "%lld", c->ints[row]);
+    } else if (c->kind == W_GRID_FLOAT && c->floats) {
+        int prec = c->precision > 0 ? c->precision : 2;
+        len = snprintf(buf, (size_t)buf_size, "%.*f", prec, c->floats[row]);
+    }
+    if (len < 0) len = 0;
+    if (len >= buf_size) len = buf_size - 1;
+    *out_len = len;
+    return len > 0 ? buf : txt;
+}
+
+/* Fixed-width clipped cell; numbers right-aligned */
+static void _grid_emit_cell(const char* txt, int len, int width, bool numeric,
+                            CEL_Color fg, CEL_TextAttr attr) {
+    CEL_Clay(
+        .layout = {
+            .sizing = { .width = CLAY_SIZING_FIXED((float)width / CEL_CELL_ASPECT_RATIO),
+                        .height = CLAY_SIZING_FIXED(1) },
+            .childAlignment = { .x = numeric ? CLAY_ALIGN_X_RIGHT : CLAY_ALIGN_X_LEFT }
+        },
+        .clip = { .horizontal = true }
+    ) {
+        CLAY_TEXT(CEL_Clay_Text(txt, len),
+            CLAY_TEXT_CONFIG({ .textColor = fg,
+                              .userData = w_pack_text_attr(attr) }));
+    }
+}
+
+static void _grid_emit_header_cell(const W_DataGrid* d, int col,
+                                   CEL_Color fg, CEL_TextAttr attr) {
+    const W_DataGridColumn* c = &d->columns[col];
+    const char* title = c->title ? c->title : "";
+    int dir = Widget_datagrid_index_sort_dir(d->index, col);
+    char buf[128];
+    int len = snprintf(buf, sizeof(buf), "%s%s", title,
+                       dir > 0 ? " \xe2\x96\xb2" : dir < 0 ? " \xe2\x96\xbc" : "");
+    if (len < 0) len = 0;
+    if (len >= (int)sizeof(buf)) len = (int)sizeof(buf) - 1;
+    _grid_emit_cell(buf, len, _grid_col_width(c), false, fg, attr);
+}
+
+void w_datagrid_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_DataGrid* d = (const W_DataGrid*)ecs_get_id(world, self, W_DataGrid_id);
+    if (!d || !d->columns || d->column_count <= 0) return;
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_DataGridStyle* s = d->style;
+
+    CEL_Color cell_fg = (s && s->fg.a > 0) ? s->fg : t->content.color;
+    CEL_TextAttr cell_attr = t->content.attr;
+    CEL_Color frozen_fg = (s && s->frozen_color.a > 0) ? s->frozen_color : t->content_muted.color;
+    CEL_Color header_fg = (s && s->header_color.a > 0) ? s->header_color : t->content_title.color;
+    CEL_TextAttr header_attr = t->content_title.attr;
+    header_attr.bold = true;
+    CEL_Color selected_bg = (s && s->selected_bg.a > 0) ? s->selected_bg : t->interactive_active.color;
+    CEL_Color marked_bg = (s && s->marked_bg.a > 0) ? s->marked_bg : t->surface_raised.color;
+    CEL_Color track_color = (s && s->track_color.a > 0) ? s->track_color : t->surface_alt.color;
+    CEL_Color thumb_color = (s && s->thumb_color.a > 0) ? s->thumb_color : t->content_muted.color;
+
+    /* Multi-select cursor (display row) */
+    const W_SelectionState* ss = d->selection
+        ? (const W_SelectionState*)ecs_get_id(world, self, W_SelectionState_id) : NULL;
+    int cursor_row = ss ? ss->cursor : -1;
+
+    W_DataGridState* state = (W_DataGridState*)ecs_get_mut_id(world, self, W_DataGridState_id);
+    W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+
+    /* ---- Row order (previous permutation until a new one is published) ---- */
+    int perm_count = 0;
+    const int* perm = Widget_datagrid_index_rows(d->index, &perm_count);
+    int display_count = perm ? perm_count : d->row_count;
+
+    /* ---- Row window ---- */
+    int content_rows = d->visible_height - 1; /* minus header */
+    if (content_rows < 1) content_rows = 1;
+    if (scroll) {
+        scroll->total_count = display_count;
+        scroll->visible_count = content_rows;
+    }
+    int offset = scroll ? Widget_scroll_offset(world, self) : 0;
+    int max_offset = display_count - content_rows;
+    if (max_offset < 0) max_offset = 0;
+    if (offset > max_offset) offset = max_offset;
+    if (offset < 0) offset = 0;
+    bool needs_scrollbar = display_count > content_rows;
+
+    /* ---- Column window ---- */
+    int frozen = d->frozen_columns;
+    if (frozen > d->column_count) frozen = d->column_count;
+    if (frozen < 0) frozen = 0;
+    int scrollable = d->column_count - frozen;
+
+    int avail = d->visible_width - (needs_scrollbar ? 1 : 0);
+    for (int c = 0; c < frozen; c++) avail -= _grid_col_width(&d->columns[c]) + 1;
+
+    int col_first = frozen + (state ? state->col_offset : 0);
+    if (col_first > d->column_count - 1) col_first = d->column_count - 1;
+    if (col_first < frozen) col_first = frozen;
+    int col_last = col_first;
+    for (int used = 0; col_last < d->column_count; col_last++) {
+        int w = _grid_col_width(&d->columns[col_last]) + 1;
+        /* Always show at least one scrolled column */
+        if (used + w > avail && col_last > col_first) break;
+        used += w;
+    }
+    if (scrollable == 0) col_last = col_first = frozen;
+
+    if (state) {
+        state->col_offset = col_first - frozen;
+        state->scroll_columns = col_last - col_first;
+    }
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0),
+                        .height = CLAY_SIZING_FIXED((float)(content_rows + 1)) }
+        }
+    ) {
+        /* ---- Frozen header row ---- */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) },
+                .childGap = 1
+            }
+        ) {
+            for (int c = 0; c < frozen; c++) {
+                _grid_emit_header_cell(d, c, header_fg, header_attr);
+            }
+            for (int c = col_first; c < col_last; c++) {
+                _grid_emit_header_cell(d, c, header_fg, header_attr);
+            }
+        }
+
+        /* ---- Body: rows | scrollbar gutter ---- */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+            }
+        ) {
             CEL_Clay(
                 .layout = {
                     .layoutDirection = CLAY_TOP_TO_BOTTOM,
-                    .sizing = {
-                        .width = CLAY_SIZING_FIXED(cell_w),
-                        .height = CLAY_SIZING_GROW(0)
-                    }
+                    .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
                 }
             ) {
-                /* Track above thumb */
-                if (thumb_y > 0) {
+                int end = offset + content_rows;
+                if (end > display_count) end = display_count;
+                for (int r = offset; r < end; r++) {
+                    int row = perm ? perm[r] : r;
+                    /* Stale permutation after the data shrank */
+                    if (row < 0 || row >= d->row_count) continue;
+
+                    bool selected = (r == d->selected_row) || (r == cursor_row);
+                    bool marked = d->selection && Widget_selection_contains(d->selection, row);
                     CEL_Clay(
-                        .layout = { .sizing = {
-                            .width = CLAY_SIZING_FIXED(cell_w),
-                            .height = CLAY_SIZING_FIXED((float)thumb_y)
-                        }},
-                        .backgroundColor = track_color
-                    ) {}
+                        .layout = {
+                            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) },
+                            .childGap = 1
+                        },
+                        .backgroundColor = selected ? selected_bg : marked ? marked_bg : (CEL_Color){0}
+                    ) {
+                        char buf[64];
+                        int len;
+                        for (int c = 0; c < frozen; c++) {
+                            const W_DataGridColumn* col = &d->columns[c];
+                            const char* txt = _grid_cell_text(col, row, buf, sizeof(buf), &len);
+                            _grid_emit_cell(txt, len, _grid_col_width(col),
+                                            col->kind != W_GRID_TEXT, frozen_fg, cell_attr);
+                        }
+                        for (int c = col_first; c < col_last; c++) {
+                            const W_DataGridColumn* col = &d->columns[c];
+                            const char* txt = _grid_cell_text(col, row, buf, sizeof(buf), &len);
+                            _grid_emit_cell(txt, len, _grid_col_width(col),
+                                            col->kind != W_GRID_TEXT, cell_fg, cell_attr);
+                        }
+                    }
                 }
-                /* Thumb */
+            }
+
+            if (needs_scrollbar) {
+                _emit_scrollbar(content_rows, offset, content_rows, display_count,
+                                track_color, thumb_color);
+            }
+        }
+    }
+
+    /* Write back modified state */
+    if (state) {
+        ecs_set_id(world, self, W_DataGridState_id, sizeof(W_DataGridState), state);
+    }
+    if (scroll) {
+        ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+    }
+}
+
+/* ============================================================================
+ * TreeView Layout
+ *
+ * Rows come straight from the W_TreeModel's flattened visible array, so
+ * only the W_Scrollable window is laid out regardless of tree size.
+ * Indentation is a slice of a static space run (2 cells per level).
+ * ============================================================================ */
+
+#define W_TREE_INDENT_MAX 64
+
+void w_tree_view_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_TreeView* d = (const W_TreeView*)ecs_get_id(world, self, W_TreeView_id);
+    if (!d || !d->model) return;
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_TreeViewStyle* s = d->style;
+
+    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg : t->content.color;
+    CEL_TextAttr text_attr = t->content.attr;
+    CEL_Color expander_fg = (s && s->expander_color.a > 0) ? s->expander_color : t->content_muted.color;
+    CEL_Color selected_bg = (s && s->selected_bg.a > 0) ? s->selected_bg : t->interactive_active.color;
+    CEL_Color track_color = (s && s->track_color.a > 0) ? s->track_color : t->surface_alt.color;
+    CEL_Color thumb_color = (s && s->thumb_color.a > 0) ? s->thumb_color : t->content_muted.color;
+
+    const W_UiState* ui = Widget_ui_state_find(world, self);
+    W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+
+    static const char indent[W_TREE_INDENT_MAX + 1] =
+        "                                                                ";
+
+    int total = Widget_tree_row_count(d->model);
+    int content_rows = d->visible_height > 0 ? d->visible_height : 1;
+    if (scroll) {
+        scroll->total_count = total;
+        scroll->visible_count = content_rows;
+    }
+    int offset = scroll ? Widget_scroll_offset(world, self) : 0;
+    int max_offset = total - content_rows;
+    if (max_offset < 0) max_offset = 0;
+    if (offset > max_offset) offset = max_offset;
+    if (offset < 0) offset = 0;
+    bool needs_scrollbar = total > content_rows;
+    int cursor = ui ? ui->cursor : 0;
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+            .sizing = { .width = CLAY_SIZING_GROW(0),
+                        .height = CLAY_SIZING_FIXED((float)content_rows) }
+        }
+    ) {
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+            }
+        ) {
+            int end = offset + content_rows;
+            if (end > total) end = total;
+            for (int r = offset; r < end; r++) {
+                const W_TreeRow* row = Widget_tree_row(d->model, r);
+                if (!row) continue;
+                int pad = row->depth * 2;
+                if (pad > W_TREE_INDENT_MAX) pad = W_TREE_INDENT_MAX;
+                const char* arrow = !row->has_children ? "  "
+                                  : row->expanded ? "\xe2\x96\xbe " : "\xe2\x96\xb8 ";
+                const char* label = row->label ? row->label : "";
+
                 CEL_Clay(
-                    .layout = { .sizing = {
-                        .width = CLAY_SIZING_FIXED(cell_w),
-                        .height = CLAY_SIZING_FIXED((float)thumb_h)
-                    }},
-                    .backgroundColor = thumb_color
-                ) {}
-                /* Track below thumb */
-                if (track_below > 0) {
+                    .layout = {
+                        .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                        .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) }
+                    },
+                    .backgroundColor = (r == cursor) ? selected_bg : (CEL_Color){0},
+                    .clip = { .horizontal = true }
+                ) {
+                    if (pad > 0) {
+                        CLAY_TEXT(CEL_Clay_Text(indent, pad),
+                            CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                              .userData = w_pack_text_attr(text_attr) }));
+                    }
+                    CLAY_TEXT(CEL_Clay_Text(arrow, (int)strlen(arrow)),
+                        CLAY_TEXT_CONFIG({ .textColor = expander_fg,
+                                          .userData = w_pack_text_attr(text_attr) }));
+                    CLAY_TEXT(CEL_Clay_Text(label, (int)strlen(label)),
+                        CLAY_TEXT_CONFIG({ .textColor = text_fg,
+                                          .userData = w_pack_text_attr(text_attr) }));
+                }
+            }
+        }
+
+        if (needs_scrollbar) {
+            _emit_scrollbar(content_rows, offset, content_rows, total,
+                            track_color, thumb_color);
+        }
+    }
+
+    if (scroll) {
+        ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+    }
+}
+
+/* ============================================================================
+ * FileBrowser Layout
+ *
+ * Header line (path + entry count / scan status) over a virtualized entry
+ * list. Entries come from the W_DirListing, which fills in the background;
+ * only the W_Scrollable window is laid out.
+ * ============================================================================ */
+
+/* Human-readable size: 512, 1.2K, 34M, 5.0G */
+static int _fb_format_size(long long size, char* buf, int buf_size) {
+    static const char units[] = "KMGTP";
+    if (size < 1024) return snprintf(buf, (size_t)buf_size, "%lld", size);
+    double v = (double)size;
+    int u = -1;
+    while (v >= 1024.0 && u < 4) { v /= 1024.0; u++; }
+    return snprintf(buf, (size_t)buf_size, v < 10.0 ? "%.1f%c" : "%.0f%c", v, units[u]);
+}
+
+void w_file_browser_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_FileBrowser* d = (const W_FileBrowser*)ecs_get_id(world, self, W_FileBrowser_id);
+    if (!d || !d->listing) return;
+    const Widget_Theme* t = Widget_get_theme();
+    const Widget_FileBrowserStyle* s = d->style;
+
+    CEL_Color text_fg = (s && s->fg.a > 0) ? s->fg : t->content.color;
+    CEL_TextAttr text_attr = t->content.attr;
+    CEL_Color dir_fg = (s && s->dir_color.a > 0) ? s->dir_color : t->primary.color;
+    CEL_TextAttr dir_attr = text_attr;
+    dir_attr.bold = true;
+    CEL_Color meta_fg = (s && s->meta_color.a > 0) ? s->meta_color : t->content_muted.color;
+    CEL_TextAttr meta_attr = t->content_muted.attr;
+    CEL_Color header_fg = (s && s->header_color.a > 0) ? s->header_color : t->content_title.color;
+    CEL_TextAttr header_attr = t->content_title.attr;
+    CEL_Color selected_bg = (s && s->selected_bg.a > 0) ? s->selected_bg : t->interactive_active.color;
+    CEL_Color track_color = (s && s->track_color.a > 0) ? s->track_color : t->surface_alt.color;
+    CEL_Color thumb_color = (s && s->thumb_color.a > 0) ? s->thumb_color : t->content_muted.color;
+
+    const W_UiState* ui = Widget_ui_state_find(world, self);
+    W_Scrollable* scroll = (W_Scrollable*)ecs_get_mut_id(world, self, W_Scrollable_id);
+
+    int total = Widget_dir_count(d->listing);
+    int content_rows = d->visible_height - 1; /* minus header */
+    if (content_rows < 1) content_rows = 1;
+    if (scroll) {
+        scroll->total_count = total;
+        scroll->visible_count = content_rows;
+    }
+    int offset = scroll ? Widget_scroll_offset(world, self) : 0;
+    int max_offset = total - content_rows;
+    if (max_offset < 0) max_offset = 0;
+    if (offset > max_offset) offset = max_offset;
+    if (offset < 0) offset = 0;
+    bool needs_scrollbar = total > content_rows;
+    int cursor = ui ? ui->cursor : 0;
+
+    /* Header status: entry count, scan progress or open error */
+    static char status_buf[64];
+    int status_len;
+    int err = Widget_dir_error(d->listing);
+    if (err) {
+        status_len = snprintf(status_buf, sizeof(status_buf), "%s", strerror(err));
+    } else {
+        status_len = snprintf(status_buf, sizeof(status_buf), "%d entries%s", total,
+                              Widget_dir_scanning(d->listing) ? " (scanning)" : "");
+    }
+    if (status_len < 0) status_len = 0;
+    if (status_len >= (int)sizeof(status_buf)) status_len = (int)sizeof(status_buf) - 1;
+    const char* path = Widget_dir_path(d->listing);
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = { .width = CLAY_SIZING_GROW(0),
+                        .height = CLAY_SIZING_FIXED((float)(content_rows + 1)) }
+        }
+    ) {
+        /* ---- Path header ---- */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) },
+                .childGap = 1
+            },
+            .clip = { .horizontal = true }
+        ) {
+            CLAY_TEXT(CEL_Clay_Text(path, (int)strlen(path)),
+                CLAY_TEXT_CONFIG({ .textColor = header_fg,
+                                  .userData = w_pack_text_attr(header_attr) }));
+            /* Spacer pushes status to far end */
+            CEL_Clay(
+                .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } }
+            ) {}
+            CLAY_TEXT(CEL_Clay_Text(status_buf, status_len),
+                CLAY_TEXT_CONFIG({ .textColor = err ? t->status_error.color : meta_fg,
+                                  .userData = w_pack_text_attr(meta_attr) }));
+        }
+
+        /* ---- Body: entries | scrollbar gutter ---- */
+        CEL_Clay(
+            .layout = {
+                .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+            }
+        ) {
+            CEL_Clay(
+                .layout = {
+                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                    .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) }
+                }
+            ) {
+                int end = offset + content_rows;
+                if (end > total) end = total;
+                for (int r = offset; r < end; r++) {
+                    const W_DirEntry* e = Widget_dir_entry(d->listing, r);
+                    if (!e) continue;
+                    bool is_dir = (e->type == W_DIRENT_DIR);
+
                     CEL_Clay(
-                        .layout = { .sizing = {
-                            .width = CLAY_SIZING_FIXED(cell_w),
-                            .height = CLAY_SIZING_FIXED((float)track_below)
-                        }},
-                        .backgroundColor = track_color
-                    ) {}
+                        .layout = {
+                            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+                            .sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_FIXED(1) },
+                            .childGap = 1
+                        },
+                        .backgroundColor = (r == cursor) ? selected_bg : (CEL_Color){0},
+                        .clip = { .horizontal = true }
+                    ) {
+                        CLAY_TEXT(CEL_Clay_Text(e->name, (int)strlen(e->name)),
+                            CLAY_TEXT_CONFIG({ .textColor = is_dir ? dir_fg : text_fg,
+                                              .userData = w_pack_text_attr(is_dir ? dir_attr : text_attr) }));
+                        if (is_dir) {
+                            CLAY_TEXT(CLAY_STRING("/"),
+                                CLAY_TEXT_CONFIG({ .textColor = dir_fg,
+                                                  .userData = w_pack_text_attr(dir_attr) }));
+                        }
+                        /* Spacer pushes size to far end */
+                        CEL_Clay(
+                            .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } }
+                        ) {}
+                        if (e->type == W_DIRENT_FILE) {
+                            char size_buf[16];
+                            int size_len = _fb_format_size(e->size, size_buf, sizeof(size_buf));
+                            if (size_len < 0) size_len = 0;
+                            if (size_len >= (int)sizeof(size_buf)) size_len = (int)sizeof(size_buf) - 1;
+                            CLAY_TEXT(CEL_Clay_Text(size_buf, size_len),
+                                CLAY_TEXT_CONFIG({ .textColor = meta_fg,
+                                                  .userData = w_pack_text_attr(meta_attr) }));
+                        }
+                    }
                 }
             }
+
+            if (needs_scrollbar) {
+                _emit_scrollbar(content_rows, offset, content_rows, total,
+                                track_color, thumb_color);
+            }
         }
     }
 
-    /* Write back modified state */
-    ecs_set_id(world, self, W_LogViewerState_id,
-               sizeof(W_LogViewerState), state);
-    ecs_set_id(world, self, W_Scrollable_id,
-               sizeof(W_Scrollable), scroll);
+    if (scroll) {
+        ecs_set_id(world, self, W_Scrollable_id, sizeof(W_Scrollable), scroll);
+    }
 }
 
 void w_powerline_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
     const W_Powerline* d = (const W_Powerline*)ecs_get_id(world, self, W_Powerline_id);
     if (!d || d->segment_count <= 0 || !d->segments) return;
 
@@ -2652,3 +3869,116 @@ void w_powerline_layout(struct ecs_world_t* world, cels_entity_t self) {
         }
     }
 }
+
+/* ============================================================================
+ * Performance Overlay Layout
+ *
+ * Floating HUD at a toast position. Rows: FPS + frame time, frame-time
+ * sparkline (oldest left, scaled to max(33 ms, worst sample)), phase
+ * split, Clay counts, ECS writes, Clay arena and border-decoration ring.
+ * Unmeasured counters print "-".
+ * ============================================================================ */
+
+#define W_PERF_WIDTH 36
+
+static void _perf_row(const char* text, CEL_Color fg, CEL_TextAttr attr) {
+    CLAY_TEXT(CEL_Clay_Text(text, (int)strlen(text)),
+        CLAY_TEXT_CONFIG({ .textColor = fg, .userData = w_pack_text_attr(attr) }));
+}
+
+static void _perf_count(char* buf, size_t size, long long v) {
+    if (v < 0) snprintf(buf, size, "-");
+    else snprintf(buf, size, "%lld", v);
+}
+
+void w_perf_overlay_layout(struct ecs_world_t* world, cels_entity_t self) {
+    W_PROFILE_LAYOUT();
+    const W_PerfOverlay* d = (const W_PerfOverlay*)ecs_get_id(world, self, W_PerfOverlay_id);
+    const W_PerfOverlayState* st = (const W_PerfOverlayState*)ecs_get_id(
+        world, self, W_PerfOverlayState_id);
+    if (!d || !st || !st->visible) return;
+    const Widget_Theme* t = Widget_get_theme();
+
+    int last = (st->head - 1 + W_PERF_HISTORY) % W_PERF_HISTORY;
+    float frame_ms = st->count > 0 ? st->frame_ms[last] : 0.0f;
+    CEL_Color fps_fg = st->fps >= 55.0f ? t->status_success.color
+                     : st->fps >= 30.0f ? t->status_warning.color
+                     : t->status_error.color;
+
+    /* Sparkline, oldest sample first */
+    static const char* blocks[] = {
+        "\xe2\x96\x81", "\xe2\x96\x82", "\xe2\x96\x83", "\xe2\x96\x84",
+        "\xe2\x96\x85", "\xe2\x96\x86", "\xe2\x96\x87", "\xe2\x96\x88"
+    };
+    float scale = 33.3f;
+    for (int i = 0; i < st->count; i++) {
+        if (st->frame_ms[i] > scale) scale = st->frame_ms[i];
+    }
+    char spark[W_PERF_HISTORY * 3 + 1];
+    int spark_len = 0;
+    int first = st->count < W_PERF_HISTORY ? 0 : st->head;
+    for (int i = 0; i < st->count; i++) {
+        float v = st->frame_ms[(first + i) % W_PERF_HISTORY] / scale;
+        int idx = (int)(v * 7.0f + 0.5f);
+        if (idx < 0) idx = 0;
+        if (idx > 7) idx = 7;
+        memcpy(spark + spark_len, blocks[idx], 3);
+        spark_len += 3;
+    }
+    spark[spark_len] = '\0';
+
+    char fps_buf[48], phase_buf[64], clay_buf[64], ecs_buf[48], arena_buf[64], decor_buf[48];
+    snprintf(fps_buf, sizeof(fps_buf), "%5.1f fps  %6.2f ms", st->fps, frame_ms);
+
+    if (st->layout_ms >= 0.0f) {
+        float other = frame_ms - st->focus_ms - st->layout_ms;
+        if (other < 0.0f) other = 0.0f;
+        snprintf(phase_buf, sizeof(phase_buf), "focus %.2f layout %.2f other %.2f",
+                 st->focus_ms, st->layout_ms, other);
+    } else {
+        snprintf(phase_buf, sizeof(phase_buf), "phases -  (CELS_WIDGETS_PROFILE)");
+    }
+
+    char el[24], cmds[24], writes[24];
+    _perf_count(el, sizeof(el), st->clay_elements);
+    _perf_count(cmds, sizeof(cmds), st->render_commands);
+    _perf_count(writes, sizeof(writes), st->ecs_writes);
+    snprintf(clay_buf, sizeof(clay_buf), "clay %s elements  %s cmds", el, cmds);
+    snprintf(ecs_buf, sizeof(ecs_buf), "ecs %s writes/frame", writes);
+    snprintf(arena_buf, sizeof(arena_buf), "arena %.1f KiB  max %d elements",
+             (double)Clay_MinMemorySize() / 1024.0, (int)Clay_GetMaxElementCount());
+    snprintf(decor_buf, sizeof(decor_buf), "decor %d/%d", st->decor_used, W_BORDER_DECOR_MAX);
+
+    Clay_FloatingAttachPoints attach;
+    Clay_Vector2 offset = _toast_anchor(d->position, &attach);
+
+    CEL_Clay(
+        .layout = {
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .sizing = {
+                .width = CLAY_SIZING_FIXED((float)W_PERF_WIDTH / CEL_CELL_ASPECT_RATIO),
+                .height = CLAY_SIZING_FIT(0)
+            },
+            .padding = { .left = 1, .right = 1 }
+        },
+        .backgroundColor = t->surface_raised.color,
+        .floating = {
+            .attachTo = CLAY_ATTACH_TO_ROOT,
+            .attachPoints = attach,
+            .offset = offset,
+            .zIndex = 400,
+            .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH
+        }
+    ) {
+        _perf_row(fps_buf, fps_fg, (CEL_TextAttr){ .bold = true });
+        _perf_row(spark, t->primary.color, (CEL_TextAttr){0});
+        _perf_row(phase_buf, t->content.color, t->content.attr);
+        _perf_row(clay_buf, t->content.color, t->content.attr);
+        _perf_row(ecs_buf, t->content.color, t->content.attr);
+        _perf_row(arena_buf, t->content_muted.color, t->content_muted.attr);
+        _perf_row(decor_buf,
+                  st->decor_used > W_BORDER_DECOR_MAX ? t->status_error.color
+                                                      : t->content_muted.color,
+                  t->content_muted.attr);
+    }
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Memory footprint report implementation
+ *
+ * Component bytes are summed per table rather than per entity: every
+ * entity in a table has the same components, so a table contributes
+ * count * sum(sizeof) once. Tags and pairs have no type info and add 0.
+ *
+ * The per-frame columns are read back from the cost counters by layout
+ * function name, which is how profile.c names its sites.
+ *
+ * Heap bytes come from per-type hooks that read the models a widget's
+ * props point at. Models are often shared between widgets, so each one is
+ * counted once, for the first type that reaches it.
+ */
+
+#include <cels-widgets/memory.h>
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/input.h>
+#include <cels-widgets/layouts.h>
+#include <cels-widgets/profile.h>
+#include <clay.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct MemoryType {
+    const char* name;
+    const char* layout;         /* Profile site name */
+    ecs_entity_t id;
+} MemoryType;
+
+/* ============================================================================
+ * Owned Heap
+ * ============================================================================ */
+
+/* Models already counted (open addressing over pointers) */
+typedef struct MemoryHeap {
+    const void** seen;
+    size_t cap;                 /* Power of two */
+    size_t count;
+    size_t bytes;               /* Running total for the current table */
+} MemoryHeap;
+
+static size_t heap_hash(const void* p) {
+    uint64_t h = (uint64_t)(uintptr_t)p * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32);
+}
+
+/* True the first time p is seen. If the set cannot grow, p is counted
+ * again rather than dropped. */
+static bool heap_claim(MemoryHeap* h, const void* p) {
+    if (!p) return false;
+    if ((h->count + 1) * 2 > h->cap) {
+        size_t cap = h->cap ? h->cap * 2 : 64;
+        const void** fresh = (const void**)calloc(cap, sizeof(void*));
+        if (!fresh) return true;
+        for (size_t i = 0; i < h->cap; i++) {
+            if (!h->seen[i]) continue;
+            size_t j = heap_hash(h->seen[i]) & (cap - 1);
+            while (fresh[j]) j = (j + 1) & (cap - 1);
+            fresh[j] = h->seen[i];
+        }
+        free(h->seen);
+        h->seen = fresh;
+        h->cap = cap;
+    }
+    size_t i = heap_hash(p) & (h->cap - 1);
+    while (h->seen[i]) {
+        if (h->seen[i] == p) return false;
+        i = (i + 1) & (h->cap - 1);
+    }
+    h->seen[i] = p;
+    h->count++;
+    return true;
+}
+
+static void heap_datagrid(const void* props, MemoryHeap* h) {
+    const W_DataGrid* d = (const W_DataGrid*)props;
+    if (heap_claim(h, d->index)) h->bytes += Widget_datagrid_index_bytes(d->index);
+    if (heap_claim(h, d->selection)) h->bytes += Widget_selection_bytes(d->selection);
+}
+
+static void heap_list_view(const void* props, MemoryHeap* h) {
+    const W_ListView* d = (const W_ListView*)props;
+    if (heap_claim(h, d->fuzzy)) h->bytes += Widget_fuzzy_bytes(d->fuzzy);
+    if (heap_claim(h, d->selection)) h->bytes += Widget_selection_bytes(d->selection);
+}
+
+static void heap_tab_view(const void* props, MemoryHeap* h) {
+    const W_TabView* d = (const W_TabView*)props;
+    if (heap_claim(h, d->cache)) h->bytes += Widget_tab_cache_bytes(d->cache);
+}
+
+static void heap_toast_stack(const void* props, MemoryHeap* h) {
+    const W_ToastStack* d = (const W_ToastStack*)props;
+    if (heap_claim(h, d->manager)) h->bytes += Widget_toasts_bytes(d->manager);
+}
+
+static void heap_tree_view(const void* props, MemoryHeap* h) {
+    const W_TreeView* d = (const W_TreeView*)props;
+    if (heap_claim(h, d->model)) h->bytes += Widget_tree_bytes(d->model);
+}
+
+static void heap_file_browser(const void* props, MemoryHeap* h) {
+    const W_FileBrowser* d = (const W_FileBrowser*)props;
+    if (heap_claim(h, d->listing)) h->bytes += Widget_dir_bytes(d->listing);
+}
+
+typedef void (*MemoryHeapFn)(const void* props, MemoryHeap* h);
+
+/* Hook for a props component that points at owned models (NULL = none) */
+static MemoryHeapFn memory_heap_fn(ecs_entity_t id) {
+    if (id == W_DataGrid_id) return heap_datagrid;
+    if (id == W_ListView_id) return heap_list_view;
+    if (id == W_TabView_id) return heap_tab_view;
+    if (id == W_ToastStack_id) return heap_toast_stack;
+    if (id == W_TreeView_id) return heap_tree_view;
+    if (id == W_FileBrowser_id) return heap_file_browser;
+    return NULL;
+}
+
+/* Props component and layout per widget type. Containers whose
+ * components also appear on other widgets (W_NavigationScope) go last so
+ * the first-match rule gives those entities to the specific widget. */
+static int memory_types(MemoryType* out) {
+    int n = 0;
+    out[n++] = (MemoryType){ "W_Text",             "w_text_layout",             W_Text_id };
+    out[n++] = (MemoryType){ "W_Hint",             "w_hint_layout",             W_Hint_id };
+    out[n++] = (MemoryType){ "W_Canvas",           "w_canvas_layout",           W_Canvas_id };
+    out[n++] = (MemoryType){ "W_InfoBox",          "w_info_box_layout",         W_InfoBox_id };
+    out[n++] = (MemoryType){ "W_Badge",            "w_badge_layout",            W_Badge_id };
+    out[n++] = (MemoryType){ "W_TextArea",         "w_text_area_layout",        W_TextArea_id };
+    out[n++] = (MemoryType){ "W_Button",           "w_button_layout",           W_Button_id };
+    out[n++] = (MemoryType){ "W_Slider",           "w_slider_layout",           W_Slider_id };
+    out[n++] = (MemoryType){ "W_Toggle",           "w_toggle_layout",           W_Toggle_id };
+    out[n++] = (MemoryType){ "W_Cycle",            "w_cycle_layout",            W_Cycle_id };
+    out[n++] = (MemoryType){ "W_ProgressBar",      "w_progress_bar_layout",     W_ProgressBar_id };
+    out[n++] = (MemoryType){ "W_Metric",           "w_metric_layout",           W_Metric_id };
+    out[n++] = (MemoryType){ "W_Panel",            "w_panel_layout",            W_Panel_id };
+    out[n++] = (MemoryType){ "W_Divider",          "w_divider_layout",          W_Divider_id };
+    out[n++] = (MemoryType){ "W_Table",            "w_table_layout",            W_Table_id };
+    out[n++] = (MemoryType){ "W_Collapsible",      "w_collapsible_layout",      W_Collapsible_id };
+    out[n++] = (MemoryType){ "W_SplitPane",        "w_split_pane_layout",       W_SplitPane_id };
+    out[n++] = (MemoryType){ "W_ScrollContainer",  "w_scrollable_layout",       W_ScrollContainer_id };
+    out[n++] = (MemoryType){ "W_ThemeScope",       "w_theme_scope_layout",      W_ThemeScope_id };
+    out[n++] = (MemoryType){ "W_RadioGroup",       "w_radio_group_layout",      W_RadioGroup_id };
+    out[n++] = (MemoryType){ "W_RadioButton",      "w_radio_button_layout",     W_RadioButton_id };
+    out[n++] = (MemoryType){ "W_TabBar",           "w_tab_bar_layout",          W_TabBar_id };
+    out[n++] = (MemoryType){ "W_TabContent",       "w_tab_content_layout",      W_TabContent_id };
+    out[n++] = (MemoryType){ "W_TabView",          "w_tab_view_layout",         W_TabView_id };
+    out[n++] = (MemoryType){ "W_TabPage",          "w_tab_page_layout",         W_TabPage_id };
+    out[n++] = (MemoryType){ "W_StatusBar",        "w_status_bar_layout",       W_StatusBar_id };
+    out[n++] = (MemoryType){ "W_ListView",         "w_list_view_layout",        W_ListView_id };
+    out[n++] = (MemoryType){ "W_ListItem",         "w_list_item_layout",        W_ListItem_id };
+    out[n++] = (MemoryType){ "W_TextInput",        "w_text_input_layout",       W_TextInput_id };
+    out[n++] = (MemoryType){ "W_Popup",            "w_popup_layout",            W_Popup_id };
+    out[n++] = (MemoryType){ "W_Modal",            "w_modal_layout",            W_Modal_id };
+    out[n++] = (MemoryType){ "W_Window",           "w_window_layout",           W_Window_id };
+    out[n++] = (MemoryType){ "W_Toast",            "w_toast_layout",            W_Toast_id };
+    out[n++] = (MemoryType){ "W_ToastStack",       "w_toast_stack_layout",      W_ToastStack_id };
+    out[n++] = (MemoryType){ "W_PerfOverlay",      "w_perf_overlay_layout",     W_PerfOverlay_id };
+    out[n++] = (MemoryType){ "W_Spark",            "w_spark_layout",            W_Spark_id };
+    out[n++] = (MemoryType){ "W_BarChart",         "w_bar_chart_layout",        W_BarChart_id };
+    out[n++] = (MemoryType){ "W_Powerline",        "w_powerline_layout",        W_Powerline_id };
+    out[n++] = (MemoryType){ "W_LogViewer",        "w_log_viewer_layout",       W_LogViewer_id };
+    out[n++] = (MemoryType){ "W_CommandPalette",   "w_command_palette_layout",  W_CommandPalette_id };
+    out[n++] = (MemoryType){ "W_DataGrid",         "w_datagrid_layout",         W_DataGrid_id };
+    out[n++] = (MemoryType){ "W_TreeView",         "w_tree_view_layout",        W_TreeView_id };
+    out[n++] = (MemoryType){ "W_FileBrowser",      "w_file_browser_layout",     W_FileBrowser_id };
+    out[n++] = (MemoryType){ "W_NavigationScope",  "w_navigation_group_layout", W_NavigationScope_id };
+    return n;
+}
+
+/* ============================================================================
+ * Components
+ * ============================================================================ */
+
+static size_t table_row_bytes(ecs_world_t* world, const ecs_table_t* table) {
+    const ecs_type_t* type = ecs_table_get_type(table);
+    size_t bytes = 0;
+    for (int32_t i = 0; type && i < type->count; i++) {
+        const ecs_type_info_t* ti = ecs_get_type_info(world, type->array[i]);
+        if (ti) bytes += (size_t)ti->size;
+    }
+    return bytes;
+}
+
+static void memory_components(ecs_world_t* world, const MemoryType* types, int index,
+                              W_MemoryTypeStat* st, MemoryHeap* heap) {
+    if (!types[index].id) return;
+    ecs_query_t* q = ecs_query(world, {
+        .terms = {{ .id = types[index].id }}
+    });
+    if (!q) return;
+
+    MemoryHeapFn heap_fn = memory_heap_fn(types[index].id);
+    ecs_iter_t it = ecs_query_iter(world, q);
+    while (ecs_query_next(&it)) {
+        /* Claimed by an earlier type */
+        bool claimed = false;
+        for (int t = 0; t < index && !claimed; t++) {
+            claimed = types[t].id && ecs_table_has_id(world, it.table, types[t].id);
+        }
+        if (claimed) continue;
+        st->instances += it.count;
+        st->component_bytes += (size_t)it.count * table_row_bytes(world, it.table);
+        if (!heap_fn) continue;
+
+        heap->bytes = 0;
+        for (int i = 0; i < it.count; i++) {
+            const void* props = ecs_get_id(world, it.entities[i], types[index].id);
+            if (props) heap_fn(props, heap);
+        }
+        st->heap_bytes += heap->bytes;
+    }
+    ecs_query_fini(q);
+}
+
+/* ============================================================================
+ * Report
+ * ============================================================================ */
+
+void Widget_memory_report(ecs_world_t* world, W_MemoryReport* out) {
+    memset(out, 0, sizeof(*out));
+
+    MemoryType types[W_MEMORY_TYPES];
+    out->type_count = memory_types(types);
+
+    out->clay_arena_bytes = (size_t)Clay_MinMemorySize();
+    out->clay_max_elements = (int)Clay_GetMaxElementCount();
+    size_t per_element = out->clay_max_elements > 0
+        ? out->clay_arena_bytes / (size_t)out->clay_max_elements : 0;
+
+    int site_count = 0;
+    const W_ProfileStat* sites = Widget_profile_last_frame(&site_count);
+    out->frame_counted = Widget_profile_enabled() && Widget_profile_frame_count() > 0;
+#ifdef CELS_WIDGETS_PROFILE_CLAY
+    out->clay_counted = out->frame_counted;
+#endif
+
+    MemoryHeap heap = {0};
+    for (int i = 0; i < out->type_count; i++) {
+        W_MemoryTypeStat* st = &out->types[i];
+        st->name = types[i].name;
+        memory_components(world, types, i, st, &heap);
+
+        for (int s = 0; s < site_count && out->frame_counted; s++) {
+            if (strcmp(sites[s].name, types[i].layout) != 0) continue;
+            st->clay_elements = sites[s].clay_elements;
+            st->clay_bytes = (size_t)sites[s].clay_elements * per_element;
+            st->text_bytes = sites[s].text_bytes;
+            st->border_decors = sites[s].border_decors;
+            break;
+        }
+
+        out->instances += st->instances;
+        out->component_bytes += st->component_bytes;
+        out->heap_bytes += st->heap_bytes;
+    }
+    free(heap.seen);
+
+    out->ui_state_bytes = Widget_ui_state_bytes();
+    out->keyed_bytes = widgets_keyed_heap_bytes();
+
+    if (out->frame_counted) {
+        W_ProfileFrame frame = Widget_profile_last_frame_summary();
+        out->clay_elements = frame.clay_elements;
+        out->text_bytes = frame.text_bytes;
+        out->border_decors = frame.border_decors;
+    }
+    out->border_decor_bytes = w_border_decor_bytes();
+}
+
+static void print_bytes(FILE* out, size_t bytes) {
+    if (bytes >= 1024 * 1024) {
+        fprintf(out, "%9.1f MiB", (double)bytes / (1024.0 * 1024.0));
+    } else if (bytes >= 1024) {
+        fprintf(out, "%9.1f KiB", (double)bytes / 1024.0);
+    } else {
+        fprintf(out, "%9zu B  ", bytes);
+    }
+}
+
+void Widget_memory_report_print(const W_MemoryReport* r, FILE* out) {
+    fprintf(out, "%-20s %9s %13s %13s %13s %9s %8s\n",
+            "type", "count", "components", "heap", "clay", "text", "decors");
+    for (int i = 0; i < r->type_count; i++) {
+        const W_MemoryTypeStat* st = &r->types[i];
+        if (st->instances == 0) continue;
+        fprintf(out, "%-20s %9d ", st->name, st->instances);
+        print_bytes(out, st->component_bytes);
+        fputc(' ', out);
+        print_bytes(out, st->heap_bytes);
+        fputc(' ', out);
+        print_bytes(out, st->clay_bytes);
+        fprintf(out, " %9llu %8llu\n",
+                (unsigned long long)st->text_bytes, (unsigned long long)st->border_decors);
+    }
+
+    fprintf(out, "%-20s %9d ", "total", r->instances);
+    print_bytes(out, r->component_bytes);
+    fputc(' ', out);
+    print_bytes(out, r->heap_bytes);
+    fputc('\n', out);
+
+    fprintf(out, "ui state slab ");
+    print_bytes(out, r->ui_state_bytes);
+    fprintf(out, ", keyed stash ");
+    print_bytes(out, r->keyed_bytes);
+    fputc('\n', out);
+
+    fprintf(out, "clay arena ");
+    print_bytes(out, r->clay_arena_bytes);
+    fprintf(out, " for %d elements", r->clay_max_elements);
+    if (r->clay_counted) {
+        fprintf(out, ", %llu used last frame, %llu string bytes",
+                (unsigned long long)r->clay_elements, (unsigned long long)r->text_bytes);
+    }
+    fputc('\n', out);
+
+    fprintf(out, "border decor ring ");
+    print_bytes(out, r->border_decor_bytes);
+    fprintf(out, " for %d slots", W_BORDER_DECOR_MAX);
+    if (r->frame_counted) {
+        fprintf(out, ", %llu taken last frame%s", (unsigned long long)r->border_decors,
+                r->border_decors > W_BORDER_DECOR_MAX ? " (wrapped)" : "");
+    }
+    fputc('\n', out);
+
+    if (!r->frame_counted) {
+        fprintf(out, "per-frame columns need a CELS_WIDGETS_PROFILE build\n");
+    }
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Command palette registry
+ *
+ * Fixed-capacity command table with per-command frecency (use count
+ * weighted by how recently it was last used). Use counts age: once their
+ * total passes PALETTE_AGING_TOTAL every count is halved, so commands
+ * that stopped being used fade out. Queries go through a
+ * W_FuzzyIndex over the command labels, so each keystroke only rescans
+ * the previous match set. The final ranking keeps the best
+ * W_PALETTE_MAX_RESULTS in a bounded min-heap -- O(n log k) per query
+ * instead of sorting every match.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <string.h>
+#include <time.h>
+
+/* Total use count that triggers halving every count */
+#define PALETTE_AGING_TOTAL 1000
+
+/* Recency bucket bounds, in seconds since last use */
+#define PALETTE_HOUR  3600
+#define PALETTE_DAY   86400
+#define PALETTE_WEEK  604800
+
+/* ============================================================================
+ * Registry State
+ * ============================================================================ */
+
+static W_Command s_commands[W_PALETTE_MAX_COMMANDS];
+static const char* s_labels[W_PALETTE_MAX_COMMANDS];
+static int s_use_count[W_PALETTE_MAX_COMMANDS];
+static time_t s_last_used[W_PALETTE_MAX_COMMANDS];
+static int s_use_total = 0;
+static int s_command_count = 0;
+
+static W_FuzzyIndex* s_fuzzy = NULL;
+static bool s_fuzzy_dirty = true;
+
+/* Result cache (query + k + frecency generation), valid until a ranked
+ * command's last use crosses into an older recency bucket */
+static char s_cache_query[W_FUZZY_QUERY_MAX];
+static int s_cache_k = -1;
+static unsigned s_rank_gen = 0;
+static unsigned s_cache_gen = (unsigned)-1;
+static time_t s_cache_expires = 0;
+static int s_results[W_PALETTE_MAX_RESULTS];
+static int s_result_count = 0;
+
+/* ============================================================================
+ * Frecency
+ * ============================================================================ */
+
+/* Recency weight: recent uses count for more (Firefox-style buckets).
+ * Lowers *expires to when this weight next drops. */
+static int palette_frecency(int index, time_t now, time_t* expires) {
+    int uses = s_use_count[index];
+    if (uses == 0) return 0;
+    if (uses > 20) uses = 20;
+    time_t last = s_last_used[index];
+    double age = difftime(now, last);
+    int weight = 1;
+    time_t drop = 0;
+    if (age < PALETTE_HOUR) { weight = 8; drop = last + PALETTE_HOUR; }
+    else if (age < PALETTE_DAY) { weight = 4; drop = last + PALETTE_DAY; }
+    else if (age < PALETTE_WEEK) { weight = 2; drop = last + PALETTE_WEEK; }
+    if (drop != 0 && (*expires == 0 || drop < *expires)) *expires = drop;
+    return uses * weight;
+}
+
+/* Halve every use count; commands down to zero uses lose their frecency */
+static void palette_age(void) {
+    s_use_total = 0;
+    for (int i = 0; i < s_command_count; i++) {
+        s_use_count[i] /= 2;
+        s_use_total += s_use_count[i];
+    }
+}
+
+/* ============================================================================
+ * Top-k Min-Heap
+ * ============================================================================ */
+
+typedef struct PaletteHit {
+    int score;
+    int index;
+} PaletteHit;
+
+/* a ranks below b: lower score, or equal score and later registration */
+static bool palette_hit_less(PaletteHit a, PaletteHit b) {
+    if (a.score != b.score) return a.score < b.score;
+    return a.index > b.index;
+}
+
+static void palette_sift_down(PaletteHit* heap, int n, int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < n && palette_hit_less(heap[l], heap[m])) m = l;
+        if (r < n && palette_hit_less(heap[r], heap[m])) m = r;
+        if (m == i) return;
+        PaletteHit t = heap[i]; heap[i] = heap[m]; heap[m] = t;
+        i = m;
+    }
+}
+
+static void palette_sift_up(PaletteHit* heap, int i) {
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (!palette_hit_less(heap[i], heap[p])) return;
+        PaletteHit t = heap[i]; heap[i] = heap[p]; heap[p] = t;
+        i = p;
+    }
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+int Widget_palette_register(const W_Command* cmd) {
+    if (!cmd || !cmd->label) return -1;
+
+    int index = -1;
+    if (cmd->id) {
+        for (int i = 0; i < s_command_count; i++) {
+            if (s_commands[i].id && strcmp(s_commands[i].id, cmd->id) == 0) {
+                index = i;
+                break;
+            }
+        }
+    }
+    if (index < 0) {
+        if (s_command_count >= W_PALETTE_MAX_COMMANDS) return -1;
+        index = s_command_count++;
+        s_use_count[index] = 0;
+        s_last_used[index] = 0;
+    }
+
+    s_commands[index] = *cmd;
+    s_labels[index] = cmd->label;
+    s_fuzzy_dirty = true;
+    s_rank_gen++;
+    return index;
+}
+
+void Widget_palette_clear(void) {
+    s_command_count = 0;
+    s_use_total = 0;
+    s_fuzzy_dirty = true;
+    s_rank_gen++;
+}
+
+int Widget_palette_command_count(void) {
+    return s_command_count;
+}
+
+const W_Command* Widget_palette_command(int index) {
+    if (index < 0 || index >= s_command_count) return NULL;
+    return &s_commands[index];
+}
+
+const int* Widget_palette_results(const char* query, int max_results, int* out_count) {
+    if (!query) query = "";
+    if (max_results <= 0 || max_results > W_PALETTE_MAX_RESULTS) {
+        max_results = W_PALETTE_MAX_RESULTS;
+    }
+
+    time_t now = time(NULL);
+    if (s_cache_gen == s_rank_gen && s_cache_k == max_results &&
+        (s_cache_expires == 0 || now < s_cache_expires) &&
+        strncmp(s_cache_query, query, sizeof(s_cache_query)) == 0) {
+        if (out_count) *out_count = s_result_count;
+        return s_results;
+    }
+
+    /* Rebuild the label index after registry changes */
+    if (s_fuzzy_dirty) {
+        if (!s_fuzzy) s_fuzzy = Widget_fuzzy_create();
+        Widget_fuzzy_set_items(s_fuzzy, s_labels, s_command_count);
+        s_fuzzy_dirty = false;
+    }
+
+    int match_count = Widget_fuzzy_set_query(s_fuzzy, query);
+    const int* matches = Widget_fuzzy_matches(s_fuzzy, NULL);
+
+    /* Keep the best max_results by match score + frecency */
+    PaletteHit heap[W_PALETTE_MAX_RESULTS];
+    int heap_n = 0;
+    time_t expires = 0;
+    for (int r = 0; r < match_count; r++) {
+        PaletteHit h = {
+            .score = Widget_fuzzy_match_score(s_fuzzy, r) +
+                     palette_frecency(matches[r], now, &expires),
+            .index = matches[r]
+        };
+        if (heap_n < max_results) {
+            heap[heap_n] = h;
+            palette_sift_up(heap, heap_n++);
+        } else if (palette_hit_less(heap[0], h)) {
+            heap[0] = h;
+            palette_sift_down(heap, heap_n, 0);
+        }
+    }
+
+    /* Drain the heap worst-first into the tail: best ends up at [0] */
+    s_result_count = heap_n;
+    while (heap_n > 0) {
+        s_results[heap_n - 1] = heap[0].index;
+        heap[0] = heap[--heap_n];
+        palette_sift_down(heap, heap_n, 0);
+    }
+
+    strncpy(s_cache_query, query, sizeof(s_cache_query) - 1);
+    s_cache_query[sizeof(s_cache_query) - 1] = '\0';
+    s_cache_k = max_results;
+    s_cache_gen = s_rank_gen;
+    s_cache_expires = expires;
+
+    if (out_count) *out_count = s_result_count;
+    return s_results;
+}
+
+void Widget_palette_run(int index) {
+    if (index < 0 || index >= s_command_count) return;
+    s_use_count[index]++;
+    s_last_used[index] = time(NULL);
+    if (++s_use_total > PALETTE_AGING_TOTAL) palette_age();
+    s_rank_gen++;
+    if (s_commands[index].run) {
+        s_commands[index].run(s_commands[index].user_data);
+    }
+}
@@ -0,0 +1,362 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Cost counters implementation
+ *
+ * Sites register lazily: the first call through a W_PROFILE_SCOPE stores
+ * the slot index in the call site's static int. Open scopes form a stack;
+ * each frame keeps the counters the scope saw on entry so its own share
+ * can be taken by subtracting the nested scopes' inclusive totals:
+ *
+ *   exclusive = inclusive - sum(children inclusive)
+ *
+ * Three stat arrays are kept per site: the frame in progress, the last
+ * completed frame (copied at the frame mark) and running totals.
+ *
+ * All of this is UI-thread only, like the rest of the widget systems.
+ */
+
+#include <cels-widgets/profile.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PROFILE_DEPTH 128
+
+/* Running counters that sites account exclusively, like time */
+typedef enum ProfileCounter {
+    COUNTER_CLAY,               /* Elements + text elements opened */
+    COUNTER_WRITES,
+    COUNTER_TEXT,               /* String bytes passed to Clay */
+    COUNTER_DECOR,              /* Border decorations taken from the ring */
+    COUNTER_COUNT
+} ProfileCounter;
+
+typedef struct ProfileOpen {
+    int site;
+    uint64_t start_ns;
+    uint64_t child_ns;
+    uint64_t start[COUNTER_COUNT];
+    uint64_t child[COUNTER_COUNT];
+} ProfileOpen;
+
+#ifdef CELS_WIDGETS_PROFILE
+static bool s_enabled = true;
+#else
+static bool s_enabled = false;
+#endif
+
+static W_ProfileStat s_frame[W_PROFILE_SITES];
+static W_ProfileStat s_last[W_PROFILE_SITES];
+static W_ProfileStat s_total[W_PROFILE_SITES];
+static int s_site_count = 0;
+
+static ProfileOpen s_stack[PROFILE_DEPTH];
+static int s_depth = 0;
+
+static uint64_t s_writes = 0;               /* Running, all frames */
+static uint64_t s_text_bytes = 0;
+static uint64_t s_decors = 0;
+static long long s_clay_elements = 0;
+static long long s_clay_text_elements = 0;
+static long long s_render_commands = -1;   /* Last Clay_EndLayout */
+
+static W_ProfileFrame s_cur_frame;
+static W_ProfileFrame s_last_frame;
+static uint64_t s_frame_start_ns = 0;
+static uint64_t s_frame_start[COUNTER_COUNT];
+static uint64_t s_frames = 0;
+
+static FILE* s_trace = NULL;
+static bool s_trace_first = true;
+static uint64_t s_trace_origin_ns = 0;
+
+static uint64_t profile_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void counters_now(uint64_t out[COUNTER_COUNT]) {
+    out[COUNTER_CLAY] = (uint64_t)(s_clay_elements + s_clay_text_elements);
+    out[COUNTER_WRITES] = s_writes;
+    out[COUNTER_TEXT] = s_text_bytes;
+    out[COUNTER_DECOR] = s_decors;
+}
+
+/* ============================================================================
+ * Clay Element Counting
+ *
+ * CMake links consumers with -Wl,--wrap for Clay__OpenElement,
+ * Clay__OpenTextElement and Clay_EndLayout when CELS_WIDGETS_PROFILE_CLAY
+ * is set, so every element a layout opens, and every finished layout
+ * pass, passes through here first.
+ * ============================================================================ */
+
+#ifdef CELS_WIDGETS_PROFILE_CLAY
+#include <clay.h>
+
+extern void __real_Clay__OpenElement(void);
+void __wrap_Clay__OpenElement(void) {
+    s_clay_elements++;
+    __real_Clay__OpenElement();
+}
+
+extern void __real_Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig* config);
+void __wrap_Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig* config) {
+    s_clay_text_elements++;
+    s_text_bytes += (uint64_t)text.length;
+    __real_Clay__OpenTextElement(text, config);
+}
+
+extern Clay_RenderCommandArray __real_Clay_EndLayout(void);
+Clay_RenderCommandArray __wrap_Clay_EndLayout(void) {
+    Clay_RenderCommandArray commands = __real_Clay_EndLayout();
+    s_render_commands = commands.length;
+    return commands;
+}
+#endif
+
+void Widget_profile_clay_counts(long long* elements, long long* text_elements) {
+    if (elements) *elements = s_clay_elements;
+    if (text_elements) *text_elements = s_clay_text_elements;
+}
+
+/* ============================================================================
+ * Trace Output
+ * ============================================================================ */
+
+static void trace_name(const char* name) {
+    fputc('"', s_trace);
+    for (const char* p = name; p && *p; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', s_trace);
+        fputc(*p, s_trace);
+    }
+    fputc('"', s_trace);
+}
+
+static void trace_sep(void) {
+    fputs(s_trace_first ? "\n" : ",\n", s_trace);
+    s_trace_first = false;
+}
+
+static void trace_complete(const W_ProfileStat* st, uint64_t start_ns, uint64_t dur_ns,
+                           uint64_t clay, uint64_t writes) {
+    trace_sep();
+    fputs("{\"name\":", s_trace);
+    trace_name(st->name);
+    fprintf(s_trace,
+            ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+            "\"args\":{\"clay_elements\":%llu,\"ecs_writes\":%llu}}",
+            st->kind == W_PROFILE_KIND_LAYOUT ? "layout" : "focus",
+            (double)(start_ns - s_trace_origin_ns) / 1000.0, (double)dur_ns / 1000.0,
+            (unsigned long long)clay, (unsigned long long)writes);
+}
+
+static void trace_frame(uint64_t now_ns) {
+    trace_sep();
+    fprintf(s_trace,
+            "{\"name\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+            "\"args\":{\"index\":%llu,\"clay_elements\":%llu,\"ecs_writes\":%llu}}",
+            (double)(now_ns - s_trace_origin_ns) / 1000.0,
+            (unsigned long long)s_last_frame.index,
+            (unsigned long long)s_last_frame.clay_elements,
+            (unsigned long long)s_last_frame.ecs_writes);
+}
+
+bool Widget_profile_trace_begin(const char* path) {
+    Widget_profile_trace_end();
+    s_trace = fopen(path, "w");
+    if (!s_trace) return false;
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", s_trace);
+    s_trace_first = true;
+    s_trace_origin_ns = profile_now_ns();
+    return true;
+}
+
+void Widget_profile_trace_end(void) {
+    if (!s_trace) return;
+    fputs("\n]}\n", s_trace);
+    fclose(s_trace);
+    s_trace = NULL;
+}
+
+/* ============================================================================
+ * Scopes
+ * ============================================================================ */
+
+static int site_register(W_ProfileKind kind, const char* name) {
+    /* Same function seen through another call site (e.g. inlined copy) */
+    for (int i = 0; i < s_site_count; i++) {
+        if (s_total[i].name == name || strcmp(s_total[i].name, name) == 0) return i;
+    }
+    if (s_site_count >= W_PROFILE_SITES) return -1;
+    int i = s_site_count++;
+    W_ProfileStat init = { .name = name, .kind = kind };
+    s_frame[i] = init;
+    s_last[i] = init;
+    s_total[i] = init;
+    return i;
+}
+
+W_ProfileScope w_profile_scope_begin(int* site, W_ProfileKind kind, const char* name) {
+    W_ProfileScope scope = { .site = -1, .depth = s_depth };
+    if (!s_enabled || s_depth >= PROFILE_DEPTH) return scope;
+    if (*site < 0) {
+        *site = site_register(kind, name);
+        if (*site < 0) return scope;
+    }
+
+    ProfileOpen* o = &s_stack[s_depth++];
+    o->site = *site;
+    o->child_ns = 0;
+    memset(o->child, 0, sizeof(o->child));
+    counters_now(o->start);
+    o->start_ns = profile_now_ns();
+    scope.site = *site;
+    return scope;
+}
+
+static void stat_add(W_ProfileStat* st, uint64_t ns, uint64_t inclusive,
+                     const uint64_t own[COUNTER_COUNT]) {
+    st->calls++;
+    st->ns += ns;
+    st->ns_inclusive += inclusive;
+    st->clay_elements += own[COUNTER_CLAY];
+    st->ecs_writes += own[COUNTER_WRITES];
+    st->text_bytes += own[COUNTER_TEXT];
+    st->border_decors += own[COUNTER_DECOR];
+}
+
+void w_profile_scope_end(W_ProfileScope* scope) {
+    if (scope->site < 0 || s_depth != scope->depth + 1) return;
+    uint64_t end_ns = profile_now_ns();
+    ProfileOpen* o = &s_stack[--s_depth];
+
+    uint64_t inclusive = end_ns - o->start_ns;
+    uint64_t ns = inclusive > o->child_ns ? inclusive - o->child_ns : 0;
+
+    uint64_t now[COUNTER_COUNT], incl[COUNTER_COUNT], own[COUNTER_COUNT];
+    counters_now(now);
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        incl[c] = now[c] - o->start[c];
+        own[c] = incl[c] > o->child[c] ? incl[c] - o->child[c] : 0;
+    }
+
+    if (s_depth > 0) {
+        ProfileOpen* parent = &s_stack[s_depth - 1];
+        parent->child_ns += inclusive;
+        for (int c = 0; c < COUNTER_COUNT; c++) parent->child[c] += incl[c];
+    } else if (s_frame[o->site].kind == W_PROFILE_KIND_LAYOUT) {
+        s_cur_frame.layout_ns += inclusive;
+    } else {
+        s_cur_frame.focus_ns += inclusive;
+    }
+
+    stat_add(&s_frame[o->site], ns, inclusive, own);
+    stat_add(&s_total[o->site], ns, inclusive, own);
+    if (s_trace) {
+        trace_complete(&s_total[o->site], o->start_ns, inclusive,
+                       own[COUNTER_CLAY], own[COUNTER_WRITES]);
+    }
+}
+
+void w_profile_count_write(void) {
+    s_writes++;
+}
+
+void w_profile_count_decor(void) {
+    s_decors++;
+}
+
+/* ============================================================================
+ * Frames
+ * ============================================================================ */
+
+void Widget_profile_frame_mark(void) {
+    uint64_t now = profile_now_ns();
+    uint64_t counters[COUNTER_COUNT];
+    counters_now(counters);
+    if (s_frame_start_ns != 0) {
+        s_cur_frame.index = s_frames++;
+        s_cur_frame.ns = now - s_frame_start_ns;
+        s_cur_frame.clay_elements = counters[COUNTER_CLAY] - s_frame_start[COUNTER_CLAY];
+        s_cur_frame.ecs_writes = counters[COUNTER_WRITES] - s_frame_start[COUNTER_WRITES];
+        s_cur_frame.text_bytes = counters[COUNTER_TEXT] - s_frame_start[COUNTER_TEXT];
+        s_cur_frame.border_decors = counters[COUNTER_DECOR] - s_frame_start[COUNTER_DECOR];
+        s_cur_frame.render_commands = s_render_commands;
+        s_last_frame = s_cur_frame;
+
+        for (int i = 0; i < s_site_count; i++) {
+            s_last[i] = s_frame[i];
+            s_frame[i].calls = 0;
+            s_frame[i].ns = 0;
+            s_frame[i].ns_inclusive = 0;
+            s_frame[i].clay_elements = 0;
+            s_frame[i].ecs_writes = 0;
+            s_frame[i].text_bytes = 0;
+            s_frame[i].border_decors = 0;
+        }
+        if (s_trace && s_enabled) trace_frame(now);
+    }
+    memset(&s_cur_frame, 0, sizeof(s_cur_frame));
+    s_frame_start_ns = now;
+    memcpy(s_frame_start, counters, sizeof(s_frame_start));
+}
+
+/* ============================================================================
+ * Queries
+ * ============================================================================ */
+
+void Widget_profile_enable(bool enabled) {
+    s_enabled = enabled;
+}
+
+bool Widget_profile_enabled(void) {
+    return s_enabled;
+}
+
+void Widget_profile_reset(void) {
+    for (int i = 0; i < s_site_count; i++) {
+        W_ProfileStat init = { .name = s_total[i].name, .kind = s_total[i].kind };
+        s_frame[i] = init;
+        s_last[i] = init;
+        s_total[i] = init;
+    }
+    memset(&s_cur_frame, 0, sizeof(s_cur_frame));
+    memset(&s_last_frame, 0, sizeof(s_last_frame));
+    s_frames = 0;
+    s_frame_start_ns = 0;
+}
+
+const W_ProfileStat* Widget_profile_last_frame(int* count) {
+    if (count) *count = s_site_count;
+    return s_last;
+}
+
+const W_ProfileStat* Widget_profile_totals(int* count) {
+    if (count) *count = s_site_count;
+    return s_total;
+}
+
+W_ProfileFrame Widget_profile_last_frame_summary(void) {
+    return s_last_frame;
+}
+
+uint64_t Widget_profile_frame_count(void) {
+    return s_frames;
+}
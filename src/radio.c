@@ -0,0 +1,472 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Radio group registry
+ *
+ * Links W_RadioButton.group_id to W_RadioGroup through two hash indexes
+ * kept up to date by observers:
+ *
+ *   group_id -> group   (members in arrival order, selected member,
+ *                        the W_RadioGroup entity for that id)
+ *   entity   -> member  (group + position, for O(1) lookups on change)
+ *
+ * Observers:
+ *   OnSet W_RadioButton     join / move between groups
+ *   OnRemove W_RadioButton  leave the group
+ *   OnSet W_Selectable      selecting a member deselects the previous one
+ *   OnSet W_RadioGroup      bind the group entity; apply selected_index
+ *                           when it differs from the last one applied
+ *   OnRemove W_RadioGroup   unbind the group entity
+ *
+ * The registry is the source of truth for which member is chosen. A
+ * selected = false write on the chosen member (a recomposition, or a
+ * navigation group moving its cursor away) does not clear the choice:
+ * the member is written back as selected. Only choosing another member
+ * or Widget_radio_select(-1) clears it. selected_index is applied only
+ * when its value changes, so a recomposition that rewrites the other
+ * group props does not undo a Widget_radio_select(). An index past the
+ * current members waits for that member to join.
+ *
+ * A selection change touches the old member, the new member and the
+ * group component -- O(1) regardless of group size. W_RadioGroup's
+ * selected_index and count are written back whenever they change.
+ *
+ * The registry belongs to one world; registering with another world
+ * clears it.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/input.h>
+#include <flecs.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Registry State
+ * ============================================================================ */
+
+typedef struct RadioGroupEntry {
+    int group_id;
+    bool used;
+    ecs_entity_t group_entity;      /* W_RadioGroup with this id (0 = none) */
+    ecs_entity_t* members;          /* Arrival order = option index */
+    int count;
+    int cap;
+    int selected;                   /* Index into members (-1 = none) */
+    int prop_index;                 /* Last selected_index applied from the component */
+    bool prop_seen;
+    int want;                       /* Applied index whose member has not joined (-1 = none) */
+} RadioGroupEntry;
+
+typedef struct RadioMemberEntry {
+    ecs_entity_t entity;            /* 0 = empty slot */
+    int group;                      /* Index into s_groups */
+    int index;                      /* Position in the group's members */
+} RadioMemberEntry;
+
+static RadioGroupEntry* s_groups = NULL;
+static int s_group_cap = 0;         /* Power of two */
+static int s_group_used = 0;
+
+static RadioMemberEntry* s_members = NULL;
+static int s_member_cap = 0;        /* Power of two */
+static int s_member_used = 0;
+
+/* Set while the registry writes components, so its own OnSet events
+ * are not treated as user changes */
+static bool s_radio_syncing = false;
+
+static uint32_t radio_hash(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDull;
+    k ^= k >> 33;
+    return (uint32_t)k;
+}
+
+/* ============================================================================
+ * Group Index (group_id -> entry; entries are never removed)
+ * ============================================================================ */
+
+static int radio_group_slot(int group_id, bool create);
+
+static bool radio_groups_grow(void) {
+    int new_cap = s_group_cap ? s_group_cap * 2 : 16;
+    RadioGroupEntry* old = s_groups;
+    int old_cap = s_group_cap;
+    RadioGroupEntry* fresh = (RadioGroupEntry*)calloc((size_t)new_cap, sizeof(RadioGroupEntry));
+    if (!fresh) return false;
+
+    s_groups = fresh;
+    s_group_cap = new_cap;
+    s_group_used = 0;
+    for (int i = 0; i < old_cap; i++) {
+        if (!old[i].used) continue;
+        uint32_t mask = (uint32_t)new_cap - 1;
+        uint32_t j = radio_hash((uint64_t)(uint32_t)old[i].group_id) & mask;
+        while (fresh[j].used) j = (j + 1) & mask;
+        fresh[j] = old[i];
+        s_group_used++;
+    }
+
+    /* Member entries point at group slots -- re-point them */
+    for (int i = 0; i < s_member_cap; i++) {
+        if (s_members[i].entity == 0) continue;
+        int gid = old[s_members[i].group].group_id;
+        s_members[i].group = radio_group_slot(gid, false);
+    }
+    free(old);
+    return true;
+}
+
+static int radio_group_slot(int group_id, bool create) {
+    if (s_group_cap > 0) {
+        uint32_t mask = (uint32_t)s_group_cap - 1;
+        uint32_t i = radio_hash((uint64_t)(uint32_t)group_id) & mask;
+        while (s_groups[i].used) {
+            if (s_groups[i].group_id == group_id) return (int)i;
+            i = (i + 1) & mask;
+        }
+    }
+    if (!create) return -1;
+
+    if ((s_group_used + 1) * 2 > s_group_cap && !radio_groups_grow()) return -1;
+    uint32_t mask = (uint32_t)s_group_cap - 1;
+    uint32_t i = radio_hash((uint64_t)(uint32_t)group_id) & mask;
+    while (s_groups[i].used) i = (i + 1) & mask;
+    s_groups[i] = (RadioGroupEntry){ .group_id = group_id, .used = true,
+                                     .selected = -1, .want = -1 };
+    s_group_used++;
+    return (int)i;
+}
+
+/* ============================================================================
+ * Member Index (entity -> entry; linear probing, backward-shift delete)
+ * ============================================================================ */
+
+static RadioMemberEntry* radio_member_find(ecs_entity_t e) {
+    if (s_member_cap == 0) return NULL;
+    uint32_t mask = (uint32_t)s_member_cap - 1;
+    uint32_t i = radio_hash(e) & mask;
+    while (s_members[i].entity != 0) {
+        if (s_members[i].entity == e) return &s_members[i];
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+static RadioMemberEntry* radio_member_insert(ecs_entity_t e) {
+    if ((s_member_used + 1) * 2 > s_member_cap) {
+        int new_cap = s_member_cap ? s_member_cap * 2 : 64;
+        RadioMemberEntry* fresh = (RadioMemberEntry*)calloc((size_t)new_cap, sizeof(RadioMemberEntry));
+        if (!fresh) return NULL;
+        uint32_t mask = (uint32_t)new_cap - 1;
+        for (int i = 0; i < s_member_cap; i++) {
+            if (s_members[i].entity == 0) continue;
+            uint32_t j = radio_hash(s_members[i].entity) & mask;
+            while (fresh[j].entity != 0) j = (j + 1) & mask;
+            fresh[j] = s_members[i];
+        }
+        free(s_members);
+        s_members = fresh;
+        s_member_cap = new_cap;
+    }
+    uint32_t mask = (uint32_t)s_member_cap - 1;
+    uint32_t i = radio_hash(e) & mask;
+    while (s_members[i].entity != 0) i = (i + 1) & mask;
+    s_members[i].entity = e;
+    s_member_used++;
+    return &s_members[i];
+}
+
+static void radio_member_erase(RadioMemberEntry* m) {
+    uint32_t mask = (uint32_t)s_member_cap - 1;
+    uint32_t hole = (uint32_t)(m - s_members);
+    uint32_t i = (hole + 1) & mask;
+    while (s_members[i].entity != 0) {
+        uint32_t home = radio_hash(s_members[i].entity) & mask;
+        /* Move i into the hole if its home is not in (hole, i] */
+        bool in_range = (hole <= i) ? (home > hole && home <= i)
+                                    : (home > hole || home <= i);
+        if (!in_range) {
+            s_members[hole] = s_members[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    s_members[hole].entity = 0;
+    s_member_used--;
+}
+
+/* ============================================================================
+ * Component Sync
+ * ============================================================================ */
+
+static void radio_write_selected(ecs_world_t* world, ecs_entity_t e, bool selected) {
+    s_radio_syncing = true;
+    const W_Selectable* sel = (const W_Selectable*)ecs_get_id(world, e, W_Selectable_id);
+    if (sel && sel->selected != selected) {
+        W_Selectable upd = { .selected = selected };
+        ecs_set_id(world, e, W_Selectable_id, sizeof(W_Selectable), &upd);
+    }
+    const W_InteractState* ist = (const W_InteractState*)ecs_get_id(world, e, W_InteractState_id);
+    if (ist && ist->selected != selected) {
+        W_InteractState upd = *ist;
+        upd.selected = selected;
+        ecs_set_id(world, e, W_InteractState_id, sizeof(W_InteractState), &upd);
+    }
+    s_radio_syncing = false;
+}
+
+static void radio_write_group(ecs_world_t* world, const RadioGroupEntry* g) {
+    if (g->group_entity == 0) return;
+    const W_RadioGroup* rg = (const W_RadioGroup*)ecs_get_id(
+        world, g->group_entity, W_RadioGroup_id);
+    if (!rg || (rg->selected_index == g->selected && rg->count == g->count)) return;
+
+    W_RadioGroup upd = *rg;
+    upd.selected_index = g->selected;
+    upd.count = g->count;
+    s_radio_syncing = true;
+    ecs_set_id(world, g->group_entity, W_RadioGroup_id, sizeof(W_RadioGroup), &upd);
+    s_radio_syncing = false;
+}
+
+/* Make members[index] the only selected member (-1 = none) */
+static void radio_select(ecs_world_t* world, RadioGroupEntry* g, int index) {
+    if (g->selected == index) return;
+    int prev = g->selected;
+    g->selected = index;
+    if (prev >= 0) radio_write_selected(world, g->members[prev], false);
+    if (index >= 0) radio_write_selected(world, g->members[index], true);
+    radio_write_group(world, g);
+}
+
+/* ============================================================================
+ * Membership
+ * ============================================================================ */
+
+static void radio_leave(ecs_world_t* world, RadioMemberEntry* m) {
+    RadioGroupEntry* g = &s_groups[m->group];
+    int at = m->index;
+    radio_member_erase(m);
+
+    /* Keep arrival order: later members shift down one option index */
+    memmove(&g->members[at], &g->members[at + 1],
+            (size_t)(g->count - at - 1) * sizeof(ecs_entity_t));
+    g->count--;
+    for (int i = at; i < g->count; i++) {
+        RadioMemberEntry* moved = radio_member_find(g->members[i]);
+        if (moved) moved->index = i;
+    }
+    if (g->selected == at) g->selected = -1;
+    else if (g->selected > at) g->selected--;
+    radio_write_group(world, g);
+}
+
+static void radio_join(ecs_world_t* world, ecs_entity_t e, int group_id) {
+    RadioMemberEntry* m = radio_member_find(e);
+    if (m && s_groups[m->group].group_id == group_id) return;
+    if (m) radio_leave(world, m);
+
+    int gs = radio_group_slot(group_id, true);
+    if (gs < 0) return;
+    RadioGroupEntry* g = &s_groups[gs];
+    if (g->count == g->cap) {
+        int cap = g->cap ? g->cap * 2 : 8;
+        ecs_entity_t* p = (ecs_entity_t*)realloc(g->members, (size_t)cap * sizeof(ecs_entity_t));
+        if (!p) return;
+        g->members = p;
+        g->cap = cap;
+    }
+    m = radio_member_insert(e);
+    if (!m) return;
+    /* Insert may have grown the member table but never the group table */
+    m->group = gs;
+    m->index = g->count;
+    g->members[g->count++] = e;
+
+    const W_Selectable* sel = (const W_Selectable*)ecs_get_id(world, e, W_Selectable_id);
+    if (sel && sel->selected) {
+        radio_select(world, g, m->index);
+    } else if (g->want == m->index) {
+        g->want = -1;
+        radio_select(world, g, m->index);
+    } else {
+        radio_write_group(world, g);
+    }
+}
+
+/* ============================================================================
+ * Observers
+ * ============================================================================ */
+
+static void radio_button_on_set(ecs_iter_t* it) {
+    const W_RadioButton* rb = (const W_RadioButton*)ecs_field_w_size(
+        it, sizeof(W_RadioButton), 0);
+    if (!rb) return;
+    for (int i = 0; i < it->count; i++) {
+        radio_join(it->world, it->entities[i], rb[i].group_id);
+    }
+}
+
+static void radio_button_on_remove(ecs_iter_t* it) {
+    for (int i = 0; i < it->count; i++) {
+        RadioMemberEntry* m = radio_member_find(it->entities[i]);
+        if (m) radio_leave(it->world, m);
+    }
+}
+
+static void radio_selectable_on_set(ecs_iter_t* it) {
+    if (s_radio_syncing) return;
+    const W_Selectable* sel = (const W_Selectable*)ecs_field_w_size(
+        it, sizeof(W_Selectable), 0);
+    if (!sel) return;
+    for (int i = 0; i < it->count; i++) {
+        RadioMemberEntry* m = radio_member_find(it->entities[i]);
+        if (!m) continue;
+        RadioGroupEntry* g = &s_groups[m->group];
+        if (sel[i].selected) {
+            radio_select(it->world, g, m->index);
+        } else if (g->selected == m->index) {
+            /* Still the choice: undo the stray deselect */
+            radio_write_selected(it->world, it->entities[i], true);
+        }
+    }
+}
+
+static void radio_group_on_set(ecs_iter_t* it) {
+    if (s_radio_syncing) return;
+    const W_RadioGroup* rg = (const W_RadioGroup*)ecs_field_w_size(
+        it, sizeof(W_RadioGroup), 0);
+    if (!rg) return;
+    for (int i = 0; i < it->count; i++) {
+        int gs = radio_group_slot(rg[i].group_id, true);
+        if (gs < 0) continue;
+        RadioGroupEntry* g = &s_groups[gs];
+        g->group_entity = it->entities[i];
+
+        /* Apply selected_index only when it changed: the same value
+         * written again with other props is not a new choice */
+        int want = rg[i].selected_index;
+        if (!g->prop_seen || want != g->prop_index) {
+            g->prop_seen = true;
+            g->prop_index = want;
+            g->want = want >= g->count ? want : -1;
+            if (want < g->count) {
+                radio_select(it->world, g, want < 0 ? -1 : want);
+                radio_write_group(it->world, g);
+                continue;
+            }
+        }
+        radio_write_group(it->world, g);
+    }
+}
+
+static void radio_group_on_remove(ecs_iter_t* it) {
+    const W_RadioGroup* rg = (const W_RadioGroup*)ecs_field_w_size(
+        it, sizeof(W_RadioGroup), 0);
+    if (!rg) return;
+    for (int i = 0; i < it->count; i++) {
+        int gs = radio_group_slot(rg[i].group_id, false);
+        if (gs >= 0 && s_groups[gs].group_entity == it->entities[i]) {
+            s_groups[gs].group_entity = 0;
+        }
+    }
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+cels_entity_t Widget_radio_selected(int group_id) {
+    int gs = radio_group_slot(group_id, false);
+    if (gs < 0 || s_groups[gs].selected < 0) return 0;
+    return s_groups[gs].members[s_groups[gs].selected];
+}
+
+bool Widget_radio_select(struct ecs_world_t* world, int group_id, int index) {
+    int gs = radio_group_slot(group_id, false);
+    if (gs < 0 || index < -1 || index >= s_groups[gs].count) return false;
+    radio_select(world, &s_groups[gs], index);
+    return true;
+}
+
+/* ============================================================================
+ * Registration
+ * ============================================================================ */
+
+static ecs_world_t* s_radio_world = NULL;
+
+/* Entity ids from another world mean nothing here */
+static void radio_registry_reset(void) {
+    for (int i = 0; i < s_group_cap; i++) free(s_groups[i].members);
+    free(s_groups);
+    free(s_members);
+    s_groups = NULL;
+    s_group_cap = 0;
+    s_group_used = 0;
+    s_members = NULL;
+    s_member_cap = 0;
+    s_member_used = 0;
+}
+
+/* A new world may reuse this one's address; it needs fresh observers */
+static void radio_world_fini(ecs_world_t* world, void* ctx) {
+    (void)world;
+    (void)ctx;
+    radio_registry_reset();
+    s_radio_world = NULL;
+}
+
+void widgets_radio_register(void) {
+    ecs_world_t* world = cels_get_world(cels_get_context());
+    if (!world || s_radio_world == world) return;
+    if (s_radio_world) radio_registry_reset();
+    s_radio_world = world;
+    ecs_atfini(world, radio_world_fini, NULL);
+
+    cel_register(W_RadioButton);
+    cel_register(W_RadioGroup);
+    cel_register(W_Selectable);
+    cel_register(W_InteractState);
+
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_RadioButton_id }},
+        .events = { EcsOnSet },
+        .callback = radio_button_on_set
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_RadioButton_id }},
+        .events = { EcsOnRemove },
+        .callback = radio_button_on_remove
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_Selectable_id }},
+        .events = { EcsOnSet },
+        .callback = radio_selectable_on_set
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_RadioGroup_id }},
+        .events = { EcsOnSet },
+        .callback = radio_group_on_set
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_RadioGroup_id }},
+        .events = { EcsOnRemove },
+        .callback = radio_group_on_remove
+    });
+}
@@ -0,0 +1,451 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Multi-selection set (roaring-style compressed bitset)
+ *
+ * The index space is cut into 65536-wide chunks, kept in a sorted array
+ * keyed by index >> 16. Absent chunks are empty. A present chunk holds
+ * one of two containers:
+ *
+ *   - Runs:   sorted, non-adjacent [begin, end) pairs. Ranges, select-all
+ *             and invert stay tiny -- a fully selected chunk is one run.
+ *   - Bitmap: 1024 x 64-bit words, used once a chunk fragments past
+ *             SEL_MAX_RUNS runs (the point where runs stop being smaller).
+ *
+ * Range operations rebuild a run list in one O(runs) pass, or mask whole
+ * words in a bitmap. Chunks convert back to runs when they defragment.
+ */
+
+#include <cels-widgets/selection.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEL_CHUNK_SHIFT 16
+#define SEL_CHUNK_SIZE (1u << SEL_CHUNK_SHIFT)
+#define SEL_BITMAP_WORDS (SEL_CHUNK_SIZE / 64)
+
+/* Runs are 8 bytes: past 1024 runs a bitmap (8 KiB) is smaller.
+ * Bitmaps convert back at half that to avoid flapping. */
+#define SEL_MAX_RUNS 1024
+
+/* ============================================================================
+ * Set State
+ * ============================================================================ */
+
+typedef struct SelRun {
+    uint32_t begin;
+    uint32_t end;                   /* Exclusive, <= SEL_CHUNK_SIZE */
+} SelRun;
+
+typedef struct SelChunk {
+    uint32_t key;                   /* index >> SEL_CHUNK_SHIFT */
+    int card;                       /* Selected indices in this chunk */
+    SelRun* runs;                   /* Run container (when bits == NULL) */
+    int run_count;
+    int run_cap;
+    uint64_t* bits;                 /* Bitmap container */
+} SelChunk;
+
+struct W_Selection {
+    SelChunk* chunks;               /* Sorted by key */
+    int chunk_count;
+    int chunk_cap;
+    long long card;
+};
+
+enum { SEL_ADD, SEL_REMOVE, SEL_FLIP };
+
+static void sel_chunk_free(SelChunk* c) {
+    free(c->runs);
+    free(c->bits);
+    c->runs = NULL;
+    c->bits = NULL;
+    c->run_count = c->run_cap = 0;
+}
+
+/* Index of the chunk with key, or -(insert position) - 1 */
+static int sel_find_chunk(const W_Selection* sel, uint32_t key) {
+    int lo = 0, hi = sel->chunk_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (sel->chunks[mid].key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < sel->chunk_count && sel->chunks[lo].key == key) return lo;
+    return -lo - 1;
+}
+
+static SelChunk* sel_insert_chunk(W_Selection* sel, int pos, uint32_t key) {
+    if (sel->chunk_count == sel->chunk_cap) {
+        int cap = sel->chunk_cap ? sel->chunk_cap * 2 : 16;
+        SelChunk* p = (SelChunk*)realloc(sel->chunks, sizeof(SelChunk) * (size_t)cap);
+        if (!p) return NULL;
+        sel->chunks = p;
+        sel->chunk_cap = cap;
+    }
+    memmove(&sel->chunks[pos + 1], &sel->chunks[pos],
+            sizeof(SelChunk) * (size_t)(sel->chunk_count - pos));
+    sel->chunk_count++;
+    SelChunk* c = &sel->chunks[pos];
+    memset(c, 0, sizeof(*c));
+    c->key = key;
+    return c;
+}
+
+static void sel_remove_chunk(W_Selection* sel, int pos) {
+    sel_chunk_free(&sel->chunks[pos]);
+    memmove(&sel->chunks[pos], &sel->chunks[pos + 1],
+            sizeof(SelChunk) * (size_t)(sel->chunk_count - pos - 1));
+    sel->chunk_count--;
+}
+
+/* ============================================================================
+ * Run Container
+ * ============================================================================ */
+
+static bool sel_runs_reserve(SelRun** runs, int* cap, int need) {
+    if (need <= *cap) return true;
+    int n = *cap ? *cap : 4;
+    while (n < need) n *= 2;
+    SelRun* p = (SelRun*)realloc(*runs, sizeof(SelRun) * (size_t)n);
+    if (!p) return false;
+    *runs = p;
+    *cap = n;
+    return true;
+}
+
+/* Append [b, e) to out, merging with the previous run when touching */
+static void sel_emit(SelRun* out, int* n, uint32_t b, uint32_t e) {
+    if (b >= e) return;
+    if (*n > 0 && out[*n - 1].end >= b) {
+        if (e > out[*n - 1].end) out[*n - 1].end = e;
+        return;
+    }
+    out[*n].begin = b;
+    out[*n].end = e;
+    (*n)++;
+}
+
+/* Rebuild the run list with op applied to [lo, hi): keep everything
+ * outside the range, replace the inside with the op's result. */
+static bool sel_runs_apply(SelChunk* c, int op, uint32_t lo, uint32_t hi) {
+    int out_cap = c->run_count + 2; /* Splitting adds at most two runs */
+    SelRun* out = (SelRun*)malloc(sizeof(SelRun) * (size_t)out_cap);
+    if (!out) return false;
+    int n = 0;
+
+    int i = 0;
+    for (; i < c->run_count && c->runs[i].begin < lo; i++) {
+        sel_emit(out, &n, c->runs[i].begin, c->runs[i].end < lo ? c->runs[i].end : lo);
+    }
+    /* First run that may overlap [lo, hi) (the one straddling lo, if any) */
+    int first = (i > 0 && c->runs[i - 1].end > lo) ? i - 1 : i;
+
+    if (op == SEL_ADD) {
+        sel_emit(out, &n, lo, hi);
+    } else if (op == SEL_FLIP) {
+        uint32_t cursor = lo;
+        for (int j = first; j < c->run_count && c->runs[j].begin < hi; j++) {
+            uint32_t b = c->runs[j].begin > lo ? c->runs[j].begin : lo;
+            uint32_t e = c->runs[j].end < hi ? c->runs[j].end : hi;
+            sel_emit(out, &n, cursor, b);
+            cursor = e;
+        }
+        sel_emit(out, &n, cursor, hi);
+    }
+
+    for (int j = first; j < c->run_count; j++) {
+        if (c->runs[j].end > hi) {
+            sel_emit(out, &n, c->runs[j].begin > hi ? c->runs[j].begin : hi, c->runs[j].end);
+        }
+    }
+
+    free(c->runs);
+    c->runs = out;
+    c->run_count = n;
+    c->run_cap = out_cap;
+    c->card = 0;
+    for (int j = 0; j < n; j++) c->card += (int)(out[j].end - out[j].begin);
+    return true;
+}
+
+/* ============================================================================
+ * Bitmap Container
+ * ============================================================================ */
+
+static void sel_bits_apply(SelChunk* c, int op, uint32_t lo, uint32_t hi) {
+    uint32_t w0 = lo >> 6, w1 = (hi - 1) >> 6;
+    for (uint32_t w = w0; w <= w1; w++) {
+        uint64_t mask = ~0ull;
+        if (w == w0) mask &= ~0ull << (lo & 63);
+        if (w == w1 && (hi & 63)) mask &= ~0ull >> (64 - (hi & 63));
+        uint64_t before = c->bits[w];
+        uint64_t after = op == SEL_ADD ? (before | mask)
+                       : op == SEL_REMOVE ? (before & ~mask)
+                       : (before ^ mask);
+        c->bits[w] = after;
+        c->card += __builtin_popcountll(after) - __builtin_popcountll(before);
+    }
+}
+
+static int sel_bits_run_count(const uint64_t* bits) {
+    int runs = 0;
+    uint64_t carry = 0;
+    for (int w = 0; w < (int)SEL_BITMAP_WORDS; w++) {
+        /* A run starts at every set bit whose predecessor is clear */
+        runs += __builtin_popcountll(bits[w] & ~((bits[w] << 1) | carry));
+        carry = bits[w] >> 63;
+    }
+    return runs;
+}
+
+static bool sel_to_bitmap(SelChunk* c) {
+    uint64_t* bits = (uint64_t*)calloc(SEL_BITMAP_WORDS, sizeof(uint64_t));
+    if (!bits) return false;
+    c->bits = bits;
+    c->card = 0;
+    for (int i = 0; i < c->run_count; i++) {
+        sel_bits_apply(c, SEL_ADD, c->runs[i].begin, c->runs[i].end);
+    }
+    free(c->runs);
+    c->runs = NULL;
+    c->run_count = c->run_cap = 0;
+    return true;
+}
+
+static int sel_chunk_next(const SelChunk* c, uint32_t from);
+static uint32_t sel_chunk_run_end(const SelChunk* c, uint32_t x);
+
+static bool sel_to_runs(SelChunk* c, int run_count) {
+    SelRun* runs = (SelRun*)malloc(sizeof(SelRun) * (size_t)(run_count > 0 ? run_count : 1));
+    if (!runs) return false;
+    int n = 0;
+    int x;
+    uint32_t from = 0;
+    while (from < SEL_CHUNK_SIZE && n < run_count && (x = sel_chunk_next(c, from)) >= 0) {
+        runs[n].begin = (uint32_t)x;
+        runs[n].end = sel_chunk_run_end(c, (uint32_t)x);
+        from = runs[n].end;
+        n++;
+    }
+    free(c->bits);
+    c->bits = NULL;
+    c->runs = runs;
+    c->run_count = n;
+    c->run_cap = run_count > 0 ? run_count : 1;
+    return true;
+}
+
+/* ============================================================================
+ * Chunk Dispatch
+ * ============================================================================ */
+
+/* Apply op to [lo, hi) within the chunk with key. Keeps set->card current. */
+static void sel_apply_chunk(W_Selection* sel, uint32_t key, int op, uint32_t lo, uint32_t hi) {
+    int pos = sel_find_chunk(sel, key);
+    SelChunk* c;
+    if (pos < 0) {
+        if (op == SEL_REMOVE) return;
+        pos = -pos - 1;
+        c = sel_insert_chunk(sel, pos, key);
+        if (!c) return;
+    } else {
+        c = &sel->chunks[pos];
+    }
+    int before = c->card;
+
+    /* Whole-chunk fast paths */
+    if (lo == 0 && hi == SEL_CHUNK_SIZE && (op != SEL_FLIP || c->card == 0)) {
+        sel_chunk_free(c);
+        c->card = 0;
+        if (op != SEL_REMOVE && sel_runs_reserve(&c->runs, &c->run_cap, 1)) {
+            c->runs[0] = (SelRun){ 0, SEL_CHUNK_SIZE };
+            c->run_count = 1;
+            c->card = (int)SEL_CHUNK_SIZE;
+        }
+    } else if (c->bits) {
+        sel_bits_apply(c, op, lo, hi);
+        if (c->card > 0 && c->card < (int)SEL_CHUNK_SIZE) {
+            int runs = sel_bits_run_count(c->bits);
+            if (runs <= SEL_MAX_RUNS / 2) sel_to_runs(c, runs);
+        } else if (c->card == (int)SEL_CHUNK_SIZE) {
+            sel_to_runs(c, 1);
+        }
+    } else {
+        sel_runs_apply(c, op, lo, hi);
+        if (c->run_count > SEL_MAX_RUNS) sel_to_bitmap(c);
+    }
+
+    sel->card += c->card - before;
+    if (c->card == 0) sel_remove_chunk(sel, pos);
+}
+
+static void sel_apply_range(W_Selection* sel, int op, int begin, int end) {
+    if (!sel) return;
+    if (begin < 0) begin = 0;
+    if (end <= begin) return;
+    uint32_t b = (uint32_t)begin, e = (uint32_t)end;
+    uint32_t k0 = b >> SEL_CHUNK_SHIFT, k1 = (e - 1) >> SEL_CHUNK_SHIFT;
+    for (uint32_t k = k0; k <= k1; k++) {
+        uint32_t lo = (k == k0) ? (b & (SEL_CHUNK_SIZE - 1)) : 0;
+        uint32_t hi = (k == k1) ? ((e - 1) & (SEL_CHUNK_SIZE - 1)) + 1 : SEL_CHUNK_SIZE;
+        sel_apply_chunk(sel, k, op, lo, hi);
+    }
+}
+
+/* First selected local index >= from in chunk, or -1 */
+static int sel_chunk_next(const SelChunk* c, uint32_t from) {
+    if (c->bits) {
+        for (uint32_t w = from >> 6; w < SEL_BITMAP_WORDS; w++) {
+            uint64_t word = c->bits[w];
+            if (w == from >> 6) word &= ~0ull << (from & 63);
+            if (word) return (int)((w << 6) + (uint32_t)__builtin_ctzll(word));
+        }
+        return -1;
+    }
+    for (int i = 0; i < c->run_count; i++) {
+        if (c->runs[i].end > from) return (int)(c->runs[i].begin > from ? c->runs[i].begin : from);
+    }
+    return -1;
+}
+
+/* Exclusive end of the selected run containing local index x */
+static uint32_t sel_chunk_run_end(const SelChunk* c, uint32_t x) {
+    if (c->bits) {
+        for (uint32_t w = x >> 6; w < SEL_BITMAP_WORDS; w++) {
+            uint64_t inv = ~c->bits[w];
+            if (w == x >> 6) inv &= ~0ull << (x & 63);
+            if (inv) return (w << 6) + (uint32_t)__builtin_ctzll(inv);
+        }
+        return SEL_CHUNK_SIZE;
+    }
+    for (int i = 0; i < c->run_count; i++) {
+        if (c->runs[i].end > x) return c->runs[i].end;
+    }
+    return x;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_Selection* Widget_selection_create(void) {
+    return (W_Selection*)calloc(1, sizeof(W_Selection));
+}
+
+void Widget_selection_destroy(W_Selection* sel) {
+    if (!sel) return;
+    Widget_selection_clear(sel);
+    free(sel->chunks);
+    free(sel);
+}
+
+void Widget_selection_clear(W_Selection* sel) {
+    if (!sel) return;
+    for (int i = 0; i < sel->chunk_count; i++) sel_chunk_free(&sel->chunks[i]);
+    sel->chunk_count = 0;
+    sel->card = 0;
+}
+
+void Widget_selection_add_range(W_Selection* sel, int begin, int end) {
+    sel_apply_range(sel, SEL_ADD, begin, end);
+}
+
+void Widget_selection_remove_range(W_Selection* sel, int begin, int end) {
+    sel_apply_range(sel, SEL_REMOVE, begin, end);
+}
+
+void Widget_selection_flip_range(W_Selection* sel, int begin, int end) {
+    sel_apply_range(sel, SEL_FLIP, begin, end);
+}
+
+void Widget_selection_set(W_Selection* sel, int index, bool selected) {
+    sel_apply_range(sel, selected ? SEL_ADD : SEL_REMOVE, index, index + 1);
+}
+
+void Widget_selection_toggle(W_Selection* sel, int index) {
+    sel_apply_range(sel, SEL_FLIP, index, index + 1);
+}
+
+bool Widget_selection_contains(const W_Selection* sel, int index) {
+    if (!sel || index < 0) return false;
+    int pos = sel_find_chunk(sel, (uint32_t)index >> SEL_CHUNK_SHIFT);
+    if (pos < 0) return false;
+    const SelChunk* c = &sel->chunks[pos];
+    uint32_t x = (uint32_t)index & (SEL_CHUNK_SIZE - 1);
+    if (c->bits) return (c->bits[x >> 6] >> (x & 63)) & 1;
+
+    /* Last run starting at or before x */
+    int lo = 0, hi = c->run_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (c->runs[mid].begin <= x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo > 0 && c->runs[lo - 1].end > x;
+}
+
+long long Widget_selection_count(const W_Selection* sel) {
+    return sel ? sel->card : 0;
+}
+
+size_t Widget_selection_bytes(const W_Selection* sel) {
+    if (!sel) return 0;
+    size_t bytes = sizeof(*sel) + (size_t)sel->chunk_cap * sizeof(SelChunk);
+    for (int i = 0; i < sel->chunk_count; i++) {
+        const SelChunk* c = &sel->chunks[i];
+        bytes += (size_t)c->run_cap * sizeof(SelRun);
+        if (c->bits) bytes += SEL_BITMAP_WORDS * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+int Widget_selection_next(const W_Selection* sel, int from) {
+    return Widget_selection_next_run(sel, from, NULL);
+}
+
+int Widget_selection_next_run(const W_Selection* sel, int from, int* out_end) {
+    if (!sel) return -1;
+    if (from < 0) from = 0;
+    uint32_t key = (uint32_t)from >> SEL_CHUNK_SHIFT;
+    int pos = sel_find_chunk(sel, key);
+    if (pos < 0) pos = -pos - 1;
+
+    for (; pos < sel->chunk_count; pos++) {
+        const SelChunk* c = &sel->chunks[pos];
+        uint32_t local = (c->key == key) ? ((uint32_t)from & (SEL_CHUNK_SIZE - 1)) : 0;
+        int x = sel_chunk_next(c, local);
+        if (x < 0) continue;
+
+        int start = (int)((c->key << SEL_CHUNK_SHIFT) | (uint32_t)x);
+        if (out_end) {
+            /* Runs may continue into the following (adjacent) chunks */
+            uint32_t end = sel_chunk_run_end(c, (uint32_t)x);
+            int p = pos;
+            while (end == SEL_CHUNK_SIZE && p + 1 < sel->chunk_count &&
+                   sel->chunks[p + 1].key == sel->chunks[p].key + 1 &&
+                   sel_chunk_next(&sel->chunks[p + 1], 0) == 0) {
+                p++;
+                end = sel_chunk_run_end(&sel->chunks[p], 0);
+            }
+            *out_end = (int)((sel->chunks[p].key << SEL_CHUNK_SHIFT) + end);
+        }
+        return start;
+    }
+    return -1;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Tab keep-alive cache
+ *
+ * Tracks which tabs of a W_TabView stay composed: the active tab plus the
+ * keep_alive most recently active ones. The set is a small MRU array
+ * (most recent first); touching a tab moves it to the front and drops
+ * whatever falls off the end. keep_alive is expected to be a handful, so
+ * linear scans beat any indexed structure here.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct W_TabCache {
+    int capacity;                   /* keep_alive + 1 (the active tab) */
+    int count;
+    int* mru;                       /* Tab indices, most recent first */
+};
+
+W_TabCache* Widget_tab_cache_create(int keep_alive) {
+    if (keep_alive < 0) keep_alive = 0;
+    W_TabCache* cache = (W_TabCache*)calloc(1, sizeof(W_TabCache));
+    if (!cache) return NULL;
+    cache->capacity = keep_alive + 1;
+    cache->mru = (int*)malloc((size_t)cache->capacity * sizeof(int));
+    if (!cache->mru) {
+        free(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void Widget_tab_cache_destroy(W_TabCache* cache) {
+    if (!cache) return;
+    free(cache->mru);
+    free(cache);
+}
+
+void Widget_tab_cache_touch(W_TabCache* cache, int index) {
+    if (!cache || index < 0) return;
+    if (cache->count > 0 && cache->mru[0] == index) return;
+
+    /* Shift everything before the old slot (or the whole list, dropping
+     * the least recent when full) down by one */
+    int at = 0;
+    while (at < cache->count && cache->mru[at] != index) at++;
+    if (at == cache->count) {
+        if (cache->count < cache->capacity) cache->count++;
+        at = cache->count - 1;
+    }
+    memmove(&cache->mru[1], &cache->mru[0], (size_t)at * sizeof(int));
+    cache->mru[0] = index;
+}
+
+bool Widget_tab_cache_live(const W_TabCache* cache, int index) {
+    if (!cache) return true;
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->mru[i] == index) return true;
+    }
+    return false;
+}
+
+size_t Widget_tab_cache_bytes(const W_TabCache* cache) {
+    if (!cache) return 0;
+    return sizeof(*cache) + (size_t)cache->capacity * sizeof(int);
+}
+
+void Widget_tab_cache_evict(W_TabCache* cache, int index) {
+    if (!cache) return;
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->mru[i] != index) continue;
+        memmove(&cache->mru[i], &cache->mru[i + 1],
+                (size_t)(cache->count - i - 1) * sizeof(int));
+        cache->count--;
+        return;
+    }
+}
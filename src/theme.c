@@ -0,0 +1,271 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Theme singleton and scoped overrides
+ *
+ * The global theme is what Widget_set_theme() installed. W_ThemeScope
+ * layouts push an effective theme for the duration of their children's
+ * layout, so Widget_get_theme() inside the subtree returns the scoped
+ * theme with no per-widget lookup.
+ *
+ * Effective themes are cached in Widget_ThemeCache. A cache is valid for
+ * one (parent theme, parent generation, overrides) triple; the merge runs
+ * only when one of those changes, so nested scopes re-merge once per
+ * theme change, not once per frame. Every merge takes a fresh generation,
+ * which invalidates the caches of scopes nested below it.
+ *
+ * Color depth: on terminals without truecolor, themes are compiled once
+ * (at Widget_set_theme / Widget_set_color_depth time) into a copy whose
+ * colors are already palette colors, so layouts emit quantized colors and
+ * the renderer's RGB -> palette mapping is an exact match. Quantizing goes
+ * through a 32x32x32 cube (5 bits per channel) of nearest palette
+ * indices, built lazily per palette.
+ */
+
+#include <cels-widgets/theme.h>
+#include <string.h>
+
+#define W_THEME_SCOPE_DEPTH 32
+
+typedef struct ThemeFrame {
+    const Widget_Theme* theme;
+    uint32_t generation;
+} ThemeFrame;
+
+static const Widget_Theme* s_active_theme = NULL;
+static bool s_theme_dirty = false;
+static uint32_t s_theme_generation = 1;    /* Bumped by Widget_set_theme */
+static uint32_t s_merge_generation = 0;    /* Bumped by every scope merge */
+
+static Widget_ColorDepth s_color_depth = WIDGET_COLOR_TRUECOLOR;
+static Widget_Theme s_compiled_theme;      /* Active theme quantized to s_color_depth */
+
+static ThemeFrame s_scope_stack[W_THEME_SCOPE_DEPTH];
+static int s_scope_depth = 0;              /* May exceed the stack; extra pushes are ignored */
+
+/* ============================================================================
+ * Palettes + Nearest-Color Cube
+ * ============================================================================ */
+
+#define LUT_BITS 5
+#define LUT_SIDE (1 << LUT_BITS)
+
+/* xterm defaults for the 16 system colors */
+static const uint8_t s_ansi16[16][3] = {
+    {  0,   0,   0}, {205,   0,   0}, {  0, 205,   0}, {205, 205,   0},
+    {  0,   0, 238}, {205,   0, 205}, {  0, 205, 205}, {229, 229, 229},
+    {127, 127, 127}, {255,   0,   0}, {  0, 255,   0}, {255, 255,   0},
+    { 92,  92, 255}, {255,   0, 255}, {  0, 255, 255}, {255, 255, 255},
+};
+
+static const uint8_t s_cube_levels[6] = { 0, 95, 135, 175, 215, 255 };
+
+static uint8_t s_lut_256[LUT_SIDE * LUT_SIDE * LUT_SIDE];
+static uint8_t s_lut_16[LUT_SIDE * LUT_SIDE * LUT_SIDE];
+static bool s_lut_256_built = false;
+static bool s_lut_16_built = false;
+
+static void palette_rgb(int index, uint8_t rgb[3]) {
+    if (index < 16) {
+        memcpy(rgb, s_ansi16[index], 3);
+    } else if (index < 232) {
+        int i = index - 16;
+        rgb[0] = s_cube_levels[i / 36];
+        rgb[1] = s_cube_levels[(i / 6) % 6];
+        rgb[2] = s_cube_levels[i % 6];
+    } else {
+        uint8_t v = (uint8_t)(8 + (index - 232) * 10);
+        rgb[0] = rgb[1] = rgb[2] = v;
+    }
+}
+
+/* Weighted RGB distance (green counts most, blue least) */
+static int color_distance(int r, int g, int b, const uint8_t rgb[3]) {
+    int dr = r - rgb[0], dg = g - rgb[1], db = b - rgb[2];
+    return 3 * dr * dr + 4 * dg * dg + 2 * db * db;
+}
+
+/* 256-color mode matches only the cube and gray ramp (16..255): the 16
+ * system colors are whatever the terminal's own scheme makes them */
+static void lut_build(uint8_t* lut, int first, int last) {
+    uint8_t pal[256][3];
+    for (int p = first; p <= last; p++) palette_rgb(p, pal[p]);
+
+    for (int r = 0; r < LUT_SIDE; r++) {
+        for (int g = 0; g < LUT_SIDE; g++) {
+            for (int b = 0; b < LUT_SIDE; b++) {
+                /* Bucket center */
+                int half = 1 << (7 - LUT_BITS);
+                int cr = (r << (8 - LUT_BITS)) | half;
+                int cg = (g << (8 - LUT_BITS)) | half;
+                int cb = (b << (8 - LUT_BITS)) | half;
+                int best = first;
+                int best_d = color_distance(cr, cg, cb, pal[first]);
+                for (int p = first + 1; p <= last; p++) {
+                    int d = color_distance(cr, cg, cb, pal[p]);
+                    if (d < best_d) { best_d = d; best = p; }
+                }
+                lut[(r << (2 * LUT_BITS)) | (g << LUT_BITS) | b] = (uint8_t)best;
+            }
+        }
+    }
+}
+
+/* Channel (0-255 float) -> cube coordinate */
+static int lut_coord(float v) {
+    if (!(v > 0.0f)) return 0;
+    if (v >= 255.0f) return LUT_SIDE - 1;
+    return (int)v >> (8 - LUT_BITS);
+}
+
+int Widget_color_index(CEL_Color color) {
+    const uint8_t* lut;
+    if (s_color_depth == WIDGET_COLOR_256) {
+        if (!s_lut_256_built) { lut_build(s_lut_256, 16, 255); s_lut_256_built = true; }
+        lut = s_lut_256;
+    } else if (s_color_depth == WIDGET_COLOR_16) {
+        if (!s_lut_16_built) { lut_build(s_lut_16, 0, 15); s_lut_16_built = true; }
+        lut = s_lut_16;
+    } else {
+        return -1;
+    }
+    return lut[(lut_coord(color.r) << (2 * LUT_BITS)) |
+               (lut_coord(color.g) << LUT_BITS) | lut_coord(color.b)];
+}
+
+CEL_Color Widget_quantize_color(CEL_Color color) {
+    int index = Widget_color_index(color);
+    if (index < 0) return color;
+    uint8_t rgb[3];
+    palette_rgb(index, rgb);
+    return (CEL_Color){ (float)rgb[0], (float)rgb[1], (float)rgb[2], color.a };
+}
+
+/* Quantize every set token; unset ones (alpha 0) stay unset */
+static void theme_quantize(Widget_Theme* theme) {
+    enum { TOKENS = sizeof(Widget_Theme) / sizeof(CEL_Visual) };
+    CEL_Visual* v = (CEL_Visual*)theme;
+    for (int i = 0; i < TOKENS; i++) {
+        if (v[i].color.a > 0) v[i].color = Widget_quantize_color(v[i].color);
+    }
+}
+
+static void theme_compile(void) {
+    if (s_color_depth == WIDGET_COLOR_TRUECOLOR) return;
+    s_compiled_theme = s_active_theme ? *s_active_theme : Widget_THEME_DEFAULT;
+    theme_quantize(&s_compiled_theme);
+}
+
+void Widget_set_color_depth(Widget_ColorDepth depth) {
+    if (depth == s_color_depth) return;
+    s_color_depth = depth;
+    theme_compile();
+    s_theme_dirty = true;
+    s_theme_generation++;
+}
+
+Widget_ColorDepth Widget_get_color_depth(void) {
+    return s_color_depth;
+}
+
+/* ============================================================================
+ * Global Theme
+ * ============================================================================ */
+
+const Widget_Theme* Widget_get_theme(void) {
+    if (s_scope_depth > 0) {
+        int top = s_scope_depth < W_THEME_SCOPE_DEPTH ? s_scope_depth : W_THEME_SCOPE_DEPTH;
+        return s_scope_stack[top - 1].theme;
+    }
+    if (s_color_depth != WIDGET_COLOR_TRUECOLOR) return &s_compiled_theme;
+    return s_active_theme ? s_active_theme : &Widget_THEME_DEFAULT;
+}
+
+void Widget_set_theme(const Widget_Theme* theme) {
+    s_active_theme = theme;
+    theme_compile();
+    s_theme_dirty = true;
+    s_theme_generation++;
+}
+
+bool Widget_theme_changed(void) {
+    bool dirty = s_theme_dirty;
+    s_theme_dirty = false;
+    return dirty;
+}
+
+uint32_t Widget_theme_generation(void) {
+    if (s_scope_depth > 0) {
+        int top = s_scope_depth < W_THEME_SCOPE_DEPTH ? s_scope_depth : W_THEME_SCOPE_DEPTH;
+        return s_scope_stack[top - 1].generation;
+    }
+    return s_theme_generation;
+}
+
+/* ============================================================================
+ * Scopes
+ * ============================================================================ */
+
+void Widget_theme_push(const Widget_Theme* theme, uint32_t generation) {
+    if (s_scope_depth < W_THEME_SCOPE_DEPTH) {
+        s_scope_stack[s_scope_depth] = (ThemeFrame){ theme, generation };
+    }
+    s_scope_depth++;
+}
+
+void Widget_theme_pop(void) {
+    if (s_scope_depth > 0) s_scope_depth--;
+}
+
+/* Color and text attributes inherit independently per token */
+static void theme_merge(Widget_Theme* out, const Widget_Theme* parent,
+                        const Widget_Theme* overrides) {
+    enum { TOKENS = sizeof(Widget_Theme) / sizeof(CEL_Visual) };
+    _Static_assert(sizeof(Widget_Theme) % sizeof(CEL_Visual) == 0,
+                   "Widget_Theme must contain only CEL_Visual tokens");
+    static const CEL_TextAttr no_attr = {0};
+
+    const CEL_Visual* p = (const CEL_Visual*)parent;
+    const CEL_Visual* o = (const CEL_Visual*)overrides;
+    CEL_Visual* r = (CEL_Visual*)out;
+    for (int i = 0; i < TOKENS; i++) {
+        r[i].color = (o[i].color.a > 0) ? o[i].color : p[i].color;
+        r[i].attr = memcmp(&o[i].attr, &no_attr, sizeof(no_attr)) != 0
+            ? o[i].attr : p[i].attr;
+    }
+}
+
+const Widget_Theme* Widget_theme_resolve(Widget_ThemeCache* cache,
+                                         const Widget_Theme* overrides) {
+    const Widget_Theme* parent = Widget_get_theme();
+    if (!cache || !overrides) return parent;
+
+    uint32_t parent_gen = Widget_theme_generation();
+    if (cache->generation != 0 && cache->parent == parent &&
+        cache->parent_generation == parent_gen && cache->overrides == overrides) {
+        return &cache->resolved;
+    }
+
+    theme_merge(&cache->resolved, parent, overrides);
+    if (s_color_depth != WIDGET_COLOR_TRUECOLOR) theme_quantize(&cache->resolved);
+    cache->parent = parent;
+    cache->parent_generation = parent_gen;
+    cache->overrides = overrides;
+    cache->generation = ++s_merge_generation;
+    if (cache->generation == 0) cache->generation = ++s_merge_generation;
+    return &cache->resolved;
+}
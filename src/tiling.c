@@ -0,0 +1,428 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - BSP window tiling
+ *
+ * A W_TileTree is a binary space partition of a screen area. Leaves are
+ * windows; internal nodes are splits with a direction and a ratio. Every
+ * node caches its rectangle, so each edit re-tiles only what it changes:
+ *
+ *   insert   the active leaf becomes a split of (old window, new window);
+ *            only that new split is re-tiled
+ *   remove   the sibling takes the parent's place and rectangle; only the
+ *            sibling's subtree is re-tiled
+ *   resize   the nearest ancestor split on the requested axis moves its
+ *            boundary; only that split's subtree is re-tiled
+ *   area     a changed screen size re-tiles the whole tree (the only full
+ *            relayout)
+ *
+ * Entities map to leaves through an open-addressing table, so rect
+ * lookups from w_window_layout are O(1).
+ *
+ * Observers keep trees in sync with W_Tiled windows: a visible window
+ * with W_Tiled is inserted, hiding it or removing W_Tiled (including
+ * deleting the entity) takes it out.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <cels-widgets/input.h>
+#include <flecs.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILE_NONE (-1)
+
+typedef struct TileNode {
+    int parent;
+    int child[2];               /* TILE_NONE on leaves */
+    cels_entity_t entity;       /* Leaf window (0 on splits / free nodes) */
+    bool side_by_side;          /* Split: child[0] left of child[1] (else above) */
+    float ratio;                /* Split: child[0] share of the extent */
+    W_TileRect rect;
+} TileNode;
+
+typedef struct TileSlot {
+    cels_entity_t entity;       /* 0 = empty */
+    int node;
+} TileSlot;
+
+struct W_TileTree {
+    TileNode* nodes;
+    int node_cap;
+    int free_head;              /* Free nodes chained through parent */
+    int root;
+    int active;                 /* Leaf split by the next insert */
+    int leaves;
+    W_TileRect area;
+
+    TileSlot* slots;            /* entity -> leaf */
+    int slot_cap;               /* Power of two */
+    int slot_used;
+};
+
+/* ============================================================================
+ * Entity Index
+ * ============================================================================ */
+
+static uint32_t tile_hash(cels_entity_t e) {
+    uint64_t k = (uint64_t)e;
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDull;
+    k ^= k >> 33;
+    return (uint32_t)k;
+}
+
+static int tile_slot_find(const W_TileTree* t, cels_entity_t e) {
+    if (t->slot_cap == 0) return TILE_NONE;
+    uint32_t mask = (uint32_t)t->slot_cap - 1;
+    uint32_t i = tile_hash(e) & mask;
+    while (t->slots[i].entity != 0) {
+        if (t->slots[i].entity == e) return (int)i;
+        i = (i + 1) & mask;
+    }
+    return TILE_NONE;
+}
+
+static void tile_slot_place(TileSlot* slots, int cap, cels_entity_t e, int node) {
+    uint32_t mask = (uint32_t)cap - 1;
+    uint32_t i = tile_hash(e) & mask;
+    while (slots[i].entity != 0) i = (i + 1) & mask;
+    slots[i] = (TileSlot){ .entity = e, .node = node };
+}
+
+static bool tile_slot_insert(W_TileTree* t, cels_entity_t e, int node) {
+    if ((t->slot_used + 1) * 2 > t->slot_cap) {
+        int cap = t->slot_cap ? t->slot_cap * 2 : 16;
+        TileSlot* fresh = (TileSlot*)calloc((size_t)cap, sizeof(TileSlot));
+        if (!fresh) return false;
+        for (int i = 0; i < t->slot_cap; i++) {
+            if (t->slots[i].entity != 0) {
+                tile_slot_place(fresh, cap, t->slots[i].entity, t->slots[i].node);
+            }
+        }
+        free(t->slots);
+        t->slots = fresh;
+        t->slot_cap = cap;
+    }
+    tile_slot_place(t->slots, t->slot_cap, e, node);
+    t->slot_used++;
+    return true;
+}
+
+static void tile_slot_erase(W_TileTree* t, int hole) {
+    /* Backward-shift deletion keeps probe chains intact */
+    uint32_t mask = (uint32_t)t->slot_cap - 1;
+    uint32_t h = (uint32_t)hole;
+    uint32_t i = (h + 1) & mask;
+    while (t->slots[i].entity != 0) {
+        uint32_t home = tile_hash(t->slots[i].entity) & mask;
+        bool in_range = (h <= i) ? (home > h && home <= i)
+                                 : (home > h || home <= i);
+        if (!in_range) {
+            t->slots[h] = t->slots[i];
+            h = i;
+        }
+        i = (i + 1) & mask;
+    }
+    t->slots[h].entity = 0;
+    t->slot_used--;
+}
+
+/* ============================================================================
+ * Nodes
+ * ============================================================================ */
+
+static int tile_node_alloc(W_TileTree* t) {
+    if (t->free_head == TILE_NONE) {
+        int cap = t->node_cap ? t->node_cap * 2 : 16;
+        TileNode* nodes = (TileNode*)realloc(t->nodes, (size_t)cap * sizeof(TileNode));
+        if (!nodes) return TILE_NONE;
+        for (int i = t->node_cap; i < cap; i++) {
+            nodes[i].parent = (i + 1 < cap) ? i + 1 : TILE_NONE;
+        }
+        t->nodes = nodes;
+        t->free_head = t->node_cap;
+        t->node_cap = cap;
+    }
+    int n = t->free_head;
+    t->free_head = t->nodes[n].parent;
+    t->nodes[n] = (TileNode){
+        .parent = TILE_NONE,
+        .child = { TILE_NONE, TILE_NONE },
+        .ratio = 0.5f
+    };
+    return n;
+}
+
+static void tile_node_free(W_TileTree* t, int n) {
+    t->nodes[n].entity = 0;
+    t->nodes[n].parent = t->free_head;
+    t->free_head = n;
+}
+
+/* Split extent into two parts, both at least one cell when possible */
+static int tile_split_at(int extent, float ratio) {
+    if (extent < 2) return extent;
+    int first = (int)((float)extent * ratio + 0.5f);
+    if (first < 1) first = 1;
+    if (first > extent - 1) first = extent - 1;
+    return first;
+}
+
+/* Recompute child rectangles below n from n's rect */
+static void tile_retile(W_TileTree* t, int n) {
+    TileNode* node = &t->nodes[n];
+    if (node->child[0] == TILE_NONE) return;
+    W_TileRect r = node->rect;
+    W_TileRect a = r, b = r;
+    if (node->side_by_side) {
+        a.w = tile_split_at(r.w, node->ratio);
+        b.x = r.x + a.w;
+        b.w = r.w - a.w;
+    } else {
+        a.h = tile_split_at(r.h, node->ratio);
+        b.y = r.y + a.h;
+        b.h = r.h - a.h;
+    }
+    t->nodes[node->child[0]].rect = a;
+    t->nodes[node->child[1]].rect = b;
+    tile_retile(t, node->child[0]);
+    tile_retile(t, node->child[1]);
+}
+
+static void tile_replace_child(W_TileTree* t, int parent, int old_child, int new_child) {
+    t->nodes[new_child].parent = parent;
+    if (parent == TILE_NONE) {
+        t->root = new_child;
+        return;
+    }
+    TileNode* p = &t->nodes[parent];
+    p->child[p->child[0] == old_child ? 0 : 1] = new_child;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_TileTree* Widget_tile_tree_create(void) {
+    W_TileTree* t = (W_TileTree*)calloc(1, sizeof(W_TileTree));
+    if (!t) return NULL;
+    t->free_head = TILE_NONE;
+    t->root = TILE_NONE;
+    t->active = TILE_NONE;
+    t->area = (W_TileRect){ 0, 0, 80, 24 };
+    return t;
+}
+
+void Widget_tile_tree_destroy(W_TileTree* t) {
+    if (!t) return;
+    free(t->nodes);
+    free(t->slots);
+    free(t);
+}
+
+void Widget_tile_area(W_TileTree* t, int x, int y, int w, int h) {
+    if (!t) return;
+    W_TileRect area = { x, y, w, h };
+    if (memcmp(&area, &t->area, sizeof(area)) == 0) return;
+    t->area = area;
+    if (t->root == TILE_NONE) return;
+    t->nodes[t->root].rect = area;
+    tile_retile(t, t->root);
+}
+
+bool Widget_tile_insert(W_TileTree* t, cels_entity_t entity) {
+    if (!t || entity == 0) return false;
+    if (tile_slot_find(t, entity) != TILE_NONE) return true;
+
+    int leaf = tile_node_alloc(t);
+    if (leaf == TILE_NONE) return false;
+    t->nodes[leaf].entity = entity;
+
+    if (t->root == TILE_NONE) {
+        if (!tile_slot_insert(t, entity, leaf)) {
+            tile_node_free(t, leaf);
+            return false;
+        }
+        t->nodes[leaf].rect = t->area;
+        t->root = leaf;
+    } else {
+        int split = tile_node_alloc(t);
+        if (split == TILE_NONE || !tile_slot_insert(t, entity, leaf)) {
+            if (split != TILE_NONE) tile_node_free(t, split);
+            tile_node_free(t, leaf);
+            return false;
+        }
+        /* Split the active leaf along its longer axis (cells are ~2:1) */
+        int target = (t->active != TILE_NONE) ? t->active : t->root;
+        while (t->nodes[target].child[0] != TILE_NONE) {
+            target = t->nodes[target].child[1];
+        }
+        TileNode* s = &t->nodes[split];
+        s->rect = t->nodes[target].rect;
+        s->side_by_side = (s->rect.w >= s->rect.h * 2);
+        tile_replace_child(t, t->nodes[target].parent, target, split);
+        s->child[0] = target;
+        s->child[1] = leaf;
+        t->nodes[target].parent = split;
+        t->nodes[leaf].parent = split;
+        tile_retile(t, split);
+    }
+    t->active = leaf;
+    t->leaves++;
+    return true;
+}
+
+void Widget_tile_remove(W_TileTree* t, cels_entity_t entity) {
+    if (!t) return;
+    int slot = tile_slot_find(t, entity);
+    if (slot == TILE_NONE) return;
+    int leaf = t->slots[slot].node;
+    tile_slot_erase(t, slot);
+
+    int parent = t->nodes[leaf].parent;
+    if (parent == TILE_NONE) {
+        t->root = TILE_NONE;
+        t->active = TILE_NONE;
+    } else {
+        /* Sibling inherits the parent's place and rectangle */
+        TileNode* p = &t->nodes[parent];
+        int sibling = p->child[p->child[0] == leaf ? 1 : 0];
+        tile_replace_child(t, p->parent, parent, sibling);
+        t->nodes[sibling].rect = p->rect;
+        tile_retile(t, sibling);
+        tile_node_free(t, parent);
+        if (t->active == leaf) t->active = sibling;
+    }
+    tile_node_free(t, leaf);
+    t->leaves--;
+}
+
+void Widget_tile_focus(W_TileTree* t, cels_entity_t entity) {
+    if (!t) return;
+    int slot = tile_slot_find(t, entity);
+    if (slot != TILE_NONE) t->active = t->slots[slot].node;
+}
+
+void Widget_tile_resize(W_TileTree* t, cels_entity_t entity, int dx, int dy) {
+    if (!t || (dx == 0 && dy == 0)) return;
+    int slot = tile_slot_find(t, entity);
+    if (slot == TILE_NONE) return;
+
+    /* Move the boundary of the nearest split on each requested axis */
+    for (int axis = 0; axis < 2; axis++) {
+        int delta = axis == 0 ? dx : dy;
+        if (delta == 0) continue;
+        int n = t->slots[slot].node;
+        int split = t->nodes[n].parent;
+        while (split != TILE_NONE && t->nodes[split].side_by_side != (axis == 0)) {
+            split = t->nodes[split].parent;
+        }
+        if (split == TILE_NONE) continue;
+
+        TileNode* s = &t->nodes[split];
+        int extent = s->side_by_side ? s->rect.w : s->rect.h;
+        if (extent < 2) continue;
+        int first = tile_split_at(extent, s->ratio) + delta;
+        if (first < 1) first = 1;
+        if (first > extent - 1) first = extent - 1;
+        s->ratio = (float)first / (float)extent;
+        tile_retile(t, split);
+    }
+}
+
+bool Widget_tile_rect(const W_TileTree* t, cels_entity_t entity, W_TileRect* out) {
+    if (!t) return false;
+    int slot = tile_slot_find(t, entity);
+    if (slot == TILE_NONE) return false;
+    if (out) *out = t->nodes[t->slots[slot].node].rect;
+    return true;
+}
+
+int Widget_tile_count(const W_TileTree* t) {
+    return t ? t->leaves : 0;
+}
+
+/* ============================================================================
+ * Observers
+ * ============================================================================ */
+
+static void tiling_sync(ecs_world_t* world, ecs_entity_t e, W_TileTree* tree) {
+    const W_Window* w = (const W_Window*)ecs_get_id(world, e, W_Window_id);
+    if (w && w->visible) Widget_tile_insert(tree, e);
+    else Widget_tile_remove(tree, e);
+}
+
+static void tiling_tiled_on_set(ecs_iter_t* it) {
+    const W_Tiled* tiled = (const W_Tiled*)ecs_field_w_size(it, sizeof(W_Tiled), 0);
+    if (!tiled) return;
+    for (int i = 0; i < it->count; i++) {
+        tiling_sync(it->world, it->entities[i], tiled[i].tree);
+    }
+}
+
+static void tiling_tiled_on_remove(ecs_iter_t* it) {
+    const W_Tiled* tiled = (const W_Tiled*)ecs_field_w_size(it, sizeof(W_Tiled), 0);
+    if (!tiled) return;
+    for (int i = 0; i < it->count; i++) {
+        Widget_tile_remove(tiled[i].tree, it->entities[i]);
+    }
+}
+
+/* Showing / hiding a tiled window opens / closes its tile */
+static void tiling_window_on_set(ecs_iter_t* it) {
+    for (int i = 0; i < it->count; i++) {
+        const W_Tiled* tiled = (const W_Tiled*)ecs_get_id(
+            it->world, it->entities[i], W_Tiled_id);
+        if (tiled) tiling_sync(it->world, it->entities[i], tiled->tree);
+    }
+}
+
+static ecs_world_t* s_tiling_world = NULL;
+
+/* A new world may reuse this one's address; it needs fresh observers */
+static void tiling_world_fini(ecs_world_t* world, void* ctx) {
+    (void)world;
+    (void)ctx;
+    s_tiling_world = NULL;
+}
+
+void widgets_tiling_register(void) {
+    ecs_world_t* world = cels_get_world(cels_get_context());
+    if (!world || s_tiling_world == world) return;
+    s_tiling_world = world;
+    ecs_atfini(world, tiling_world_fini, NULL);
+
+    cel_register(W_Window);
+    cel_register(W_Tiled);
+
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_Tiled_id }},
+        .events = { EcsOnSet },
+        .callback = tiling_tiled_on_set
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_Tiled_id }},
+        .events = { EcsOnRemove },
+        .callback = tiling_tiled_on_remove
+    });
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_Window_id }},
+        .events = { EcsOnSet },
+        .callback = tiling_window_on_set
+    });
+}
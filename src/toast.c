@@ -0,0 +1,261 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Toast manager
+ *
+ * Toasts are records in a fixed pool, not entities: one W_ToastStack
+ * entity lays out every live toast. Per position:
+ *
+ *   - visible: up to visible_limit toasts, oldest first
+ *   - queue:   FIFO of toasts waiting for a visible slot
+ *
+ * Pushing a message that is already live (same text, severity and
+ * position) bumps that toast's count and restarts its timer instead of
+ * adding a record, so an error storm collapses to one "x1000" toast.
+ * Live messages are found through a small open-addressing table keyed by
+ * message hash. Expired records go back on the free list.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOAST_NONE (-1)
+#define TOAST_INDEX_CAP (W_TOAST_POOL * 2)  /* Power of two, load <= 0.5 */
+
+typedef struct ToastLane {
+    int visible[W_TOAST_VISIBLE_MAX];   /* Record indices, oldest first */
+    int visible_count;
+    int queue_head;                     /* FIFO of waiting records */
+    int queue_tail;
+    int queued;
+} ToastLane;
+
+struct W_ToastManager {
+    W_ToastRecord records[W_TOAST_POOL];
+    int next[W_TOAST_POOL];             /* Free-list / queue link */
+    uint64_t hash[W_TOAST_POOL];
+    int free_head;
+    int visible_limit;
+    ToastLane lanes[W_TOAST_POSITIONS];
+    short index[TOAST_INDEX_CAP];       /* Record index, TOAST_NONE = empty */
+    long long dropped;                  /* Pushes lost to a full pool */
+};
+
+/* ============================================================================
+ * Live-message index
+ * ============================================================================ */
+
+static uint64_t toast_hash(const char* msg, int severity, int position) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const char* p = msg; *p; p++) {
+        h ^= (unsigned char)*p;
+        h *= 0x100000001B3ull;
+    }
+    h ^= (uint64_t)(severity * W_TOAST_POSITIONS + position) + 1;
+    h *= 0x100000001B3ull;
+    return h;
+}
+
+static int toast_index_find(const W_ToastManager* m, uint64_t h, const char* msg,
+                            int severity, int position) {
+    uint32_t mask = TOAST_INDEX_CAP - 1;
+    uint32_t i = (uint32_t)h & mask;
+    while (m->index[i] != TOAST_NONE) {
+        int r = m->index[i];
+        const W_ToastRecord* rec = &m->records[r];
+        if (m->hash[r] == h && rec->severity == severity &&
+            rec->position == position && strcmp(rec->message, msg) == 0) {
+            return r;
+        }
+        i = (i + 1) & mask;
+    }
+    return TOAST_NONE;
+}
+
+static void toast_index_insert(W_ToastManager* m, int r) {
+    uint32_t mask = TOAST_INDEX_CAP - 1;
+    uint32_t i = (uint32_t)m->hash[r] & mask;
+    while (m->index[i] != TOAST_NONE) i = (i + 1) & mask;
+    m->index[i] = (short)r;
+}
+
+static void toast_index_erase(W_ToastManager* m, int r) {
+    uint32_t mask = TOAST_INDEX_CAP - 1;
+    uint32_t hole = (uint32_t)m->hash[r] & mask;
+    while (m->index[hole] != r) hole = (hole + 1) & mask;
+
+    /* Backward-shift deletion keeps probe chains intact */
+    uint32_t i = (hole + 1) & mask;
+    while (m->index[i] != TOAST_NONE) {
+        uint32_t home = (uint32_t)m->hash[m->index[i]] & mask;
+        bool in_range = (hole <= i) ? (home > hole && home <= i)
+                                    : (home > hole || home <= i);
+        if (!in_range) {
+            m->index[hole] = m->index[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    m->index[hole] = TOAST_NONE;
+}
+
+/* ============================================================================
+ * Pool + Lanes
+ * ============================================================================ */
+
+static void toast_release(W_ToastManager* m, int r) {
+    toast_index_erase(m, r);
+    m->next[r] = m->free_head;
+    m->free_head = r;
+}
+
+/* Move queued toasts into free visible slots */
+static void toast_promote(W_ToastManager* m, ToastLane* lane) {
+    while (lane->visible_count < m->visible_limit && lane->queue_head != TOAST_NONE) {
+        int r = lane->queue_head;
+        lane->queue_head = m->next[r];
+        if (lane->queue_head == TOAST_NONE) lane->queue_tail = TOAST_NONE;
+        lane->queued--;
+        m->records[r].elapsed = 0.0f;
+        lane->visible[lane->visible_count++] = r;
+    }
+}
+
+static void toast_init(W_ToastManager* m, int visible_limit) {
+    memset(m, 0, sizeof(*m));
+    if (visible_limit <= 0) visible_limit = 3;
+    if (visible_limit > W_TOAST_VISIBLE_MAX) visible_limit = W_TOAST_VISIBLE_MAX;
+    m->visible_limit = visible_limit;
+
+    for (int i = 0; i < W_TOAST_POOL; i++) {
+        m->next[i] = (i + 1 < W_TOAST_POOL) ? i + 1 : TOAST_NONE;
+    }
+    m->free_head = 0;
+    for (int i = 0; i < TOAST_INDEX_CAP; i++) m->index[i] = TOAST_NONE;
+    for (int p = 0; p < W_TOAST_POSITIONS; p++) {
+        m->lanes[p].queue_head = TOAST_NONE;
+        m->lanes[p].queue_tail = TOAST_NONE;
+    }
+}
+
+W_ToastManager* Widget_toasts_create(int visible_limit) {
+    W_ToastManager* m = (W_ToastManager*)malloc(sizeof(W_ToastManager));
+    if (!m) return NULL;
+    toast_init(m, visible_limit);
+    return m;
+}
+
+void Widget_toasts_destroy(W_ToastManager* m) {
+    free(m);
+}
+
+size_t Widget_toasts_bytes(const W_ToastManager* m) {
+    return m ? sizeof(*m) : 0;
+}
+
+void Widget_toasts_clear(W_ToastManager* m) {
+    if (!m) return;
+    long long dropped = m->dropped;
+    toast_init(m, m->visible_limit);
+    m->dropped = dropped;
+}
+
+bool Widget_toast_push(W_ToastManager* m, const char* message, int severity,
+                       int position, float duration) {
+    if (!m || !message) return false;
+    if (position < 0 || position >= W_TOAST_POSITIONS) position = 0;
+
+    /* Truncate first so dedup compares what is stored */
+    char msg[W_TOAST_MSG_MAX];
+    size_t len = strlen(message);
+    if (len >= sizeof(msg)) len = sizeof(msg) - 1;
+    memcpy(msg, message, len);
+    msg[len] = '\0';
+
+    uint64_t h = toast_hash(msg, severity, position);
+    int r = toast_index_find(m, h, msg, severity, position);
+    if (r != TOAST_NONE) {
+        m->records[r].count++;
+        m->records[r].elapsed = 0.0f;
+        return true;
+    }
+
+    if (m->free_head == TOAST_NONE) {
+        m->dropped++;
+        return false;
+    }
+    r = m->free_head;
+    m->free_head = m->next[r];
+
+    W_ToastRecord* rec = &m->records[r];
+    memcpy(rec->message, msg, len + 1);
+    rec->severity = severity;
+    rec->position = position;
+    rec->duration = duration > 0 ? duration : 3.0f;
+    rec->elapsed = 0.0f;
+    rec->count = 1;
+    m->hash[r] = h;
+    toast_index_insert(m, r);
+
+    /* Append to the lane queue; promote fills a free visible slot */
+    ToastLane* lane = &m->lanes[position];
+    m->next[r] = TOAST_NONE;
+    if (lane->queue_tail != TOAST_NONE) m->next[lane->queue_tail] = r;
+    else lane->queue_head = r;
+    lane->queue_tail = r;
+    lane->queued++;
+    toast_promote(m, lane);
+    return true;
+}
+
+void Widget_toasts_tick(W_ToastManager* m, float dt) {
+    if (!m) return;
+    for (int p = 0; p < W_TOAST_POSITIONS; p++) {
+        ToastLane* lane = &m->lanes[p];
+        int kept = 0;
+        for (int i = 0; i < lane->visible_count; i++) {
+            int r = lane->visible[i];
+            m->records[r].elapsed += dt;
+            if (m->records[r].elapsed >= m->records[r].duration) {
+                toast_release(m, r);
+            } else {
+                lane->visible[kept++] = r;
+            }
+        }
+        lane->visible_count = kept;
+        toast_promote(m, lane);
+    }
+}
+
+int Widget_toasts_visible(const W_ToastManager* m, int position,
+                          const W_ToastRecord** out, int max) {
+    if (!m || position < 0 || position >= W_TOAST_POSITIONS) return 0;
+    const ToastLane* lane = &m->lanes[position];
+    int n = lane->visible_count < max ? lane->visible_count : max;
+    for (int i = 0; i < n; i++) out[i] = &m->records[lane->visible[i]];
+    return n;
+}
+
+int Widget_toasts_queued(const W_ToastManager* m, int position) {
+    if (!m || position < 0 || position >= W_TOAST_POSITIONS) return 0;
+    return m->lanes[position].queued;
+}
+
+long long Widget_toasts_dropped(const W_ToastManager* m) {
+    return m ? m->dropped : 0;
+}
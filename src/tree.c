@@ -0,0 +1,269 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - TreeView model (flattened visible rows)
+ *
+ * The model never materializes the whole hierarchy. It keeps only the
+ * visible rows in depth-first order as one flat array:
+ *
+ *   - Expand row r: ask the source for r's children (lazily, first time it
+ *     is needed), collect them plus any previously expanded descendants
+ *     into a scratch buffer, then splice the block in after r with a
+ *     single memmove
+ *   - Collapse row r: its subtree is the contiguous run of following rows
+ *     with greater depth; remove the run with a single memmove
+ *
+ * Expansion state is remembered per node id in an open-addressing hash
+ * set, so collapsing and re-expanding a parent restores its open
+ * descendants. The layout reads rows by index, so rendering cost depends
+ * only on the viewport height.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Model State
+ * ============================================================================ */
+
+struct W_TreeModel {
+    W_TreeSource source;
+
+    W_TreeRow* rows;            /* Visible rows, depth-first */
+    int row_count;
+    int row_capacity;
+
+    /* Expanded node ids (open addressing, linear probing) */
+    uint64_t* expanded_keys;
+    unsigned char* expanded_used; /* 0 = empty, 1 = live, 2 = tombstone */
+    int expanded_capacity;      /* Power of two */
+    int expanded_load;          /* Live + tombstones */
+
+    /* Scratch for splicing a subtree in one memmove */
+    W_TreeRow* scratch;
+    int scratch_count;
+    int scratch_capacity;
+};
+
+/* Child lists deeper than this are not auto-restored (guards cycles) */
+#define W_TREE_MAX_DEPTH 256
+
+/* ============================================================================
+ * Expanded-Id Set
+ * ============================================================================ */
+
+static uint64_t tree_hash(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+}
+
+static bool tree_set_grow(W_TreeModel* m) {
+    int cap = m->expanded_capacity ? m->expanded_capacity * 2 : 64;
+    uint64_t* keys = (uint64_t*)calloc((size_t)cap, sizeof(uint64_t));
+    unsigned char* used = (unsigned char*)calloc((size_t)cap, 1);
+    if (!keys || !used) {
+        free(keys);
+        free(used);
+        return false;
+    }
+    int load = 0;
+    for (int i = 0; i < m->expanded_capacity; i++) {
+        if (m->expanded_used[i] != 1) continue;
+        int j = (int)(tree_hash(m->expanded_keys[i]) & (uint64_t)(cap - 1));
+        while (used[j]) j = (j + 1) & (cap - 1);
+        keys[j] = m->expanded_keys[i];
+        used[j] = 1;
+        load++;
+    }
+    free(m->expanded_keys);
+    free(m->expanded_used);
+    m->expanded_keys = keys;
+    m->expanded_used = used;
+    m->expanded_capacity = cap;
+    m->expanded_load = load;
+    return true;
+}
+
+static int tree_set_find(const W_TreeModel* m, uint64_t id) {
+    if (m->expanded_capacity == 0) return -1;
+    int mask = m->expanded_capacity - 1;
+    int i = (int)(tree_hash(id) & (uint64_t)mask);
+    while (m->expanded_used[i]) {
+        if (m->expanded_used[i] == 1 && m->expanded_keys[i] == id) return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+static void tree_set_add(W_TreeModel* m, uint64_t id) {
+    if (tree_set_find(m, id) >= 0) return;
+    if ((m->expanded_load + 1) * 2 > m->expanded_capacity && !tree_set_grow(m)) return;
+    int mask = m->expanded_capacity - 1;
+    int i = (int)(tree_hash(id) & (uint64_t)mask);
+    while (m->expanded_used[i] == 1) i = (i + 1) & mask;
+    if (m->expanded_used[i] == 0) m->expanded_load++;
+    m->expanded_keys[i] = id;
+    m->expanded_used[i] = 1;
+}
+
+static void tree_set_remove(W_TreeModel* m, uint64_t id) {
+    int i = tree_set_find(m, id);
+    if (i >= 0) m->expanded_used[i] = 2;
+}
+
+/* ============================================================================
+ * Row Storage
+ * ============================================================================ */
+
+static bool tree_reserve(W_TreeRow** buf, int* cap, int need) {
+    if (need <= *cap) return true;
+    int n = *cap ? *cap : 256;
+    while (n < need) n *= 2;
+    W_TreeRow* p = (W_TreeRow*)realloc(*buf, (size_t)n * sizeof(W_TreeRow));
+    if (!p) return false;
+    *buf = p;
+    *cap = n;
+    return true;
+}
+
+/* Append node's children (and expanded descendants) to the scratch buffer */
+static void tree_collect(W_TreeModel* m, uint64_t parent, int depth) {
+    if (depth >= W_TREE_MAX_DEPTH || !m->source.child_count || !m->source.child_at) return;
+    int n = m->source.child_count(m->source.user_data, parent);
+    for (int i = 0; i < n; i++) {
+        W_TreeNode node = {0};
+        m->source.child_at(m->source.user_data, parent, i, &node);
+        if (!tree_reserve(&m->scratch, &m->scratch_capacity, m->scratch_count + 1)) return;
+        W_TreeRow* row = &m->scratch[m->scratch_count++];
+        row->id = node.id;
+        row->label = node.label;
+        row->depth = depth;
+        row->has_children = node.has_children;
+        row->expanded = node.has_children && tree_set_find(m, node.id) >= 0;
+        if (row->expanded) tree_collect(m, node.id, depth + 1);
+    }
+}
+
+/* Splice the scratch buffer into rows at `at` */
+static int tree_splice_scratch(W_TreeModel* m, int at) {
+    int n = m->scratch_count;
+    m->scratch_count = 0;
+    if (n == 0) return 0;
+    if (!tree_reserve(&m->rows, &m->row_capacity, m->row_count + n)) return 0;
+    memmove(&m->rows[at + n], &m->rows[at],
+            (size_t)(m->row_count - at) * sizeof(W_TreeRow));
+    memcpy(&m->rows[at], m->scratch, (size_t)n * sizeof(W_TreeRow));
+    m->row_count += n;
+    return n;
+}
+
+/* End (exclusive) of row r's visible subtree */
+static int tree_subtree_end(const W_TreeModel* m, int r) {
+    int depth = m->rows[r].depth;
+    int end = r + 1;
+    while (end < m->row_count && m->rows[end].depth > depth) end++;
+    return end;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_TreeModel* Widget_tree_create(const W_TreeSource* source) {
+    W_TreeModel* m = (W_TreeModel*)calloc(1, sizeof(W_TreeModel));
+    if (!m) return NULL;
+    if (source) m->source = *source;
+    Widget_tree_reload(m);
+    return m;
+}
+
+void Widget_tree_destroy(W_TreeModel* m) {
+    if (!m) return;
+    free(m->rows);
+    free(m->scratch);
+    free(m->expanded_keys);
+    free(m->expanded_used);
+    free(m);
+}
+
+void Widget_tree_reload(W_TreeModel* m) {
+    if (!m) return;
+    m->row_count = 0;
+    m->scratch_count = 0;
+    tree_collect(m, m->source.root, 0);
+    tree_splice_scratch(m, 0);
+}
+
+int Widget_tree_row_count(const W_TreeModel* m) {
+    return m ? m->row_count : 0;
+}
+
+size_t Widget_tree_bytes(const W_TreeModel* m) {
+    if (!m) return 0;
+    return sizeof(*m)
+         + (size_t)(m->row_capacity + m->scratch_capacity) * sizeof(W_TreeRow)
+         + (size_t)m->expanded_capacity * (sizeof(uint64_t) + 1);
+}
+
+const W_TreeRow* Widget_tree_row(const W_TreeModel* m, int row) {
+    if (!m || row < 0 || row >= m->row_count) return NULL;
+    return &m->rows[row];
+}
+
+int Widget_tree_expand(W_TreeModel* m, int row) {
+    if (!m || row < 0 || row >= m->row_count) return 0;
+    W_TreeRow* r = &m->rows[row];
+    if (!r->has_children || r->expanded) return 0;
+    r->expanded = true;
+    tree_set_add(m, r->id);
+    tree_collect(m, r->id, r->depth + 1);
+    return tree_splice_scratch(m, row + 1);
+}
+
+int Widget_tree_collapse(W_TreeModel* m, int row) {
+    if (!m || row < 0 || row >= m->row_count) return 0;
+    W_TreeRow* r = &m->rows[row];
+    if (!r->expanded) return 0;
+    r->expanded = false;
+    tree_set_remove(m, r->id);
+    int end = tree_subtree_end(m, row);
+    int removed = end - (row + 1);
+    memmove(&m->rows[row + 1], &m->rows[end],
+            (size_t)(m->row_count - end) * sizeof(W_TreeRow));
+    m->row_count -= removed;
+    return removed;
+}
+
+bool Widget_tree_toggle(W_TreeModel* m, int row) {
+    const W_TreeRow* r = Widget_tree_row(m, row);
+    if (!r || !r->has_children) return false;
+    if (r->expanded) Widget_tree_collapse(m, row);
+    else Widget_tree_expand(m, row);
+    return true;
+}
+
+int Widget_tree_parent_row(const W_TreeModel* m, int row) {
+    if (!m || row <= 0 || row >= m->row_count) return -1;
+    int depth = m->rows[row].depth;
+    for (int i = row - 1; i >= 0; i--) {
+        if (m->rows[i].depth < depth) return i;
+    }
+    return -1;
+}
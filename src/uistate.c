@@ -0,0 +1,228 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * CELS Widgets - Persistent per-entity UI state
+ *
+ * W_UiState records live in fixed-size pages that are never moved, so a
+ * pointer handed out stays valid until its entity is deleted. Free slots
+ * are chained through a free list and reused before a new page is made.
+ *
+ * The owning entity carries W_UiStateRef { slot }. Lookup is one
+ * component get; an OnRemove observer on W_UiStateRef returns the slot to
+ * the free list when the entity is deleted (or the ref removed). When the
+ * observed world is finalized every slot goes back on the free list, and
+ * the next world gets its own observer.
+ */
+
+#include <cels-widgets/widgets.h>
+#include <flecs.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UI_STATE_PAGE_SHIFT 8
+#define UI_STATE_PAGE_SIZE (1u << UI_STATE_PAGE_SHIFT)
+#define UI_STATE_PAGE_MASK (UI_STATE_PAGE_SIZE - 1)
+#define UI_STATE_FREE_END UINT32_MAX
+
+/* ============================================================================
+ * Slab
+ * ============================================================================ */
+
+typedef struct UiStatePage {
+    W_UiState states[UI_STATE_PAGE_SIZE];
+    uint32_t next_free[UI_STATE_PAGE_SIZE]; /* Free-list link per slot */
+} UiStatePage;
+
+static UiStatePage** s_pages = NULL;
+static uint32_t s_page_count = 0;
+static uint32_t s_page_cap = 0;
+static uint32_t s_free_head = UI_STATE_FREE_END;
+
+static ecs_world_t* s_observed_world = NULL;
+
+static UiStatePage* ui_state_page(uint32_t slot) {
+    return s_pages[slot >> UI_STATE_PAGE_SHIFT];
+}
+
+static bool ui_state_add_page(void) {
+    if (s_page_count == s_page_cap) {
+        uint32_t cap = s_page_cap ? s_page_cap * 2 : 8;
+        UiStatePage** p = (UiStatePage**)realloc(s_pages, cap * sizeof(UiStatePage*));
+        if (!p) return false;
+        s_pages = p;
+        s_page_cap = cap;
+    }
+    UiStatePage* page = (UiStatePage*)malloc(sizeof(UiStatePage));
+    if (!page) return false;
+
+    /* Chain the new slots onto the free list in ascending order */
+    uint32_t base = s_page_count << UI_STATE_PAGE_SHIFT;
+    for (uint32_t i = 0; i < UI_STATE_PAGE_SIZE; i++) {
+        page->next_free[i] = (i + 1 < UI_STATE_PAGE_SIZE) ? base + i + 1 : s_free_head;
+    }
+    s_pages[s_page_count++] = page;
+    s_free_head = base;
+    return true;
+}
+
+static bool ui_state_alloc(uint32_t* out_slot) {
+    if (s_free_head == UI_STATE_FREE_END && !ui_state_add_page()) return false;
+    uint32_t slot = s_free_head;
+    UiStatePage* page = ui_state_page(slot);
+    s_free_head = page->next_free[slot & UI_STATE_PAGE_MASK];
+    memset(&page->states[slot & UI_STATE_PAGE_MASK], 0, sizeof(W_UiState));
+    *out_slot = slot;
+    return true;
+}
+
+static void ui_state_release(uint32_t slot) {
+    if ((slot >> UI_STATE_PAGE_SHIFT) >= s_page_count) return;
+    UiStatePage* page = ui_state_page(slot);
+    page->next_free[slot & UI_STATE_PAGE_MASK] = s_free_head;
+    s_free_head = slot;
+}
+
+/* Free every slot; pages are kept for the next world */
+static void ui_state_release_all(void) {
+    uint32_t total = s_page_count << UI_STATE_PAGE_SHIFT;
+    for (uint32_t slot = 0; slot < total; slot++) {
+        ui_state_page(slot)->next_free[slot & UI_STATE_PAGE_MASK] =
+            (slot + 1 < total) ? slot + 1 : UI_STATE_FREE_END;
+    }
+    s_free_head = total > 0 ? 0 : UI_STATE_FREE_END;
+}
+
+/* ============================================================================
+ * Release Observer
+ * ============================================================================ */
+
+static void ui_state_on_remove(ecs_iter_t* it) {
+    const W_UiStateRef* refs = (const W_UiStateRef*)ecs_field_w_size(
+        it, sizeof(W_UiStateRef), 0);
+    if (!refs) return;
+    for (int i = 0; i < it->count; i++) {
+        ui_state_release(refs[i].slot);
+    }
+}
+
+/* The world's entities are gone, and a new world may reuse its address */
+static void ui_state_world_fini(ecs_world_t* world, void* ctx) {
+    (void)world;
+    (void)ctx;
+    ui_state_release_all();
+    s_observed_world = NULL;
+}
+
+static void ui_state_observe(ecs_world_t* world) {
+    if (s_observed_world == world) return;
+    s_observed_world = world;
+    ecs_atfini(world, ui_state_world_fini, NULL);
+
+    ecs_observer(world, {
+        .query.terms = {{ .id = W_UiStateRef_id }},
+        .events = { EcsOnRemove },
+        .callback = ui_state_on_remove
+    });
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+W_UiState* Widget_ui_state_find(ecs_world_t* world, cels_entity_t entity) {
+    if (!world || entity == 0) return NULL;
+    cel_register(W_UiStateRef);
+    const W_UiStateRef* ref = (const W_UiStateRef*)ecs_get_id(
+        world, entity, W_UiStateRef_id);
+    if (!ref) return NULL;
+    return &ui_state_page(ref->slot)->states[ref->slot & UI_STATE_PAGE_MASK];
+}
+
+size_t Widget_ui_state_bytes(void) {
+    return (size_t)s_page_cap * sizeof(UiStatePage*)
+         + (size_t)s_page_count * sizeof(UiStatePage);
+}
+
+W_UiState* Widget_ui_state(ecs_world_t* world, cels_entity_t entity) {
+    W_UiState* found = Widget_ui_state_find(world, entity);
+    if (found || !world || entity == 0) return found;
+
+    ui_state_observe(world);
+
+    uint32_t slot;
+    if (!ui_state_alloc(&slot)) return NULL;
+    W_UiStateRef ref = { .slot = slot };
+    ecs_set_id(world, entity, W_UiStateRef_id, sizeof(W_UiStateRef), &ref);
+    return &ui_state_page(slot)->states[slot & UI_STATE_PAGE_MASK];
+}
+
+/* ============================================================================
+ * Scroll Offset
+ * ============================================================================ */
+
+static int scroll_clamp(ecs_world_t* world, cels_entity_t entity, int offset) {
+    cel_register(W_Scrollable);
+    const W_Scrollable* scr = (const W_Scrollable*)ecs_get_id(
+        world, entity, W_Scrollable_id);
+    if (scr) {
+        int max_offset = scr->total_count - scr->visible_count;
+        if (offset > max_offset) offset = max_offset;
+    }
+    return offset < 0 ? 0 : offset;
+}
+
+int Widget_scroll_offset(ecs_world_t* world, cels_entity_t entity) {
+    W_UiState* ui = Widget_ui_state_find(world, entity);
+    if (!ui) return 0;
+    ui->scroll_offset = scroll_clamp(world, entity, ui->scroll_offset);
+    return ui->scroll_offset;
+}
+
+int Widget_scroll_set(ecs_world_t* world, cels_entity_t entity, int offset) {
+    W_UiState* ui = Widget_ui_state(world, entity);
+    if (!ui) return 0;
+    ui->scroll_offset = scroll_clamp(world, entity, offset);
+    return ui->scroll_offset;
+}
+
+/* ============================================================================
+ * Composition Props
+ * ============================================================================ */
+
+static W_UiState* ui_state_composing(void) {
+    CELS_Context* ctx = cels_get_context();
+    return Widget_ui_state(cels_get_world(ctx), cels_get_current_entity());
+}
+
+void w_ui_scroll_prop(int scroll_offset) {
+    W_UiState* ui = ui_state_composing();
+    if (!ui) return;
+    if ((ui->props_applied & W_UI_PROP_SCROLL) && ui->scroll_prop == scroll_offset) return;
+    ui->props_applied |= W_UI_PROP_SCROLL;
+    ui->scroll_prop = scroll_offset;
+    /* Clamped on the next read: the extent may not be composed yet */
+    ui->scroll_offset = scroll_offset < 0 ? 0 : scroll_offset;
+}
+
+void w_ui_expanded_prop(bool expanded) {
+    W_UiState* ui = ui_state_composing();
+    if (!ui) return;
+    if ((ui->props_applied & W_UI_PROP_EXPANDED) && ui->expanded_prop == expanded) return;
+    ui->props_applied |= W_UI_PROP_EXPANDED;
+    ui->expanded_prop = expanded;
+    ui->expanded = expanded;
+}
@@ -64,18 +64,29 @@ cel_module(Widgets) {
     cel_register(W_Panel);
     cel_register(W_Divider);
     cel_register(W_Table);
+    cel_register(W_TableState);
     cel_register(W_Collapsible);
     cel_register(W_SplitPane);
     cel_register(W_ScrollContainer);
+    cel_register(W_ThemeScope);
+    cel_register(W_ThemeScopeState);
     cel_register(W_RadioButton);
     cel_register(W_RadioGroup);
     cel_register(W_TabBar);
+    cel_register(W_TabBarState);
     cel_register(W_TabContent);
+    cel_register(W_TabView);
+    cel_register(W_TabPage);
     cel_register(W_StatusBar);
     cel_register(W_ListView);
     cel_register(W_ListItem);
     cel_register(W_Focusable);
     cel_register(W_InteractState);
+    cel_register(W_Key);
+    cel_register(W_KeyBinding);
+    cel_register(W_Memo);
+    cel_register(W_PropHashes);
+    cel_register(W_UiStateRef);
 
     /* Behavioral components */
     cel_register(W_Selectable);
@@ -87,14 +98,33 @@ cel_module(Widgets) {
     /* Overlay components */
     cel_register(W_OverlayState);
     cel_register(W_Toast);
+    cel_register(W_ToastStack);
     cel_register(W_Popup);
     cel_register(W_Modal);
     cel_register(W_Window);
+    cel_register(W_Tiled);
     cel_register(W_Draggable);
+    cel_register(W_CommandPalette);
+    cel_register(W_CommandPaletteState);
 
     /* Powerline components */
     cel_register(W_Powerline);
 
+    /* Data grid components */
+    cel_register(W_DataGrid);
+    cel_register(W_DataGridState);
+    cel_register(W_SelectionState);
+
+    /* Tree view components */
+    cel_register(W_TreeView);
+
+    /* File browser components */
+    cel_register(W_FileBrowser);
+
+    /* Performance overlay components */
+    cel_register(W_PerfOverlay);
+    cel_register(W_PerfOverlayState);
+
     /* Layout config components (from cels-layout) */
     Layout_StackConfig_register();
     Layout_CenterConfig_register();
@@ -102,6 +132,12 @@ cel_module(Widgets) {
     /* Register focus system */
     widgets_focus_system_register();
 
-    /* Register behavioral systems (RangeClamp, ScrollClamp) */
+    /* Register behavioral systems (RangeClamp, toasts, perf overlay) */
     widgets_behavioral_systems_register();
+
+    /* Register radio group registry observers */
+    widgets_radio_register();
+
+    /* Register window tiling observers */
+    widgets_tiling_register();
 }